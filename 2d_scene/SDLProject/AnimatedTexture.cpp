@@ -0,0 +1,130 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "AnimatedTexture.h"
+#include "ImageArena.h"
+#include "stb_image.h"
+#include <cstring>
+
+namespace {
+
+const int   RGBA_COMPONENTS        = 4;
+const int   DEFAULT_FRAME_DELAY    = 100;  // ms, for frames that declare no delay
+const float MILLISECONDS_IN_SECOND = 1000.0f;
+
+}
+
+AnimatedTexture::AnimatedTexture() : width(0), height(0), queueHead(0), queueCount(0), decoding(false),
+                                     currentTexture(0), frameTimeLeft(0.0f) {
+    memset(textureIDs, 0, sizeof(textureIDs));
+}
+
+AnimatedTexture::~AnimatedTexture() {
+    Cleanup();
+}
+
+bool AnimatedTexture::Load(const char *filepath) {
+    Cleanup();
+    
+    int components;
+    if (!file.Open(filepath) || !stbi_info_from_memory(file.Data(), (int) file.Size(), &width, &height, &components)) return false;
+    
+    for (DecodedFrame &frame : queue) frame.pixels.resize((size_t) width * height * RGBA_COMPONENTS);
+    
+    glGenTextures(TEXTURE_RING_SIZE, textureIDs);
+    for (GLuint textureID : textureIDs) {
+        glBindTexture(GL_TEXTURE_2D, textureID);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
+    
+    queueHead      = 0;
+    queueCount     = 0;
+    currentTexture = 0;
+    frameTimeLeft  = 0.0f;
+    decoding       = true;
+    decoder = std::thread(&AnimatedTexture::DecodeFrames, this);
+    
+    return true;
+}
+
+void AnimatedTexture::Cleanup() {
+    if (decoder.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            decoding = false;
+        }
+        queueChanged.notify_all();
+        decoder.join();
+    }
+    
+    if (textureIDs[0] != 0) glDeleteTextures(TEXTURE_RING_SIZE, textureIDs);
+    memset(textureIDs, 0, sizeof(textureIDs));
+    file.Close();
+}
+
+void AnimatedTexture::DecodeFrames() {
+    // The stream, its canvas and the decoder's scratch memory all live in this thread's image arena,
+    // which is only reset once the animation is torn down.
+    stbi_gif_stream *stream = stbi_gif_stream_open_memory(file.Data(), (int) file.Size(), NULL, NULL);
+    
+    while (stream != NULL) {
+        int slot;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueChanged.wait(lock, [this] { return !decoding || queueCount < FRAME_QUEUE_SIZE; });
+            if (!decoding) break;
+            
+            // Update moves queueHead concurrently, so the free slot is picked while the lock is held
+            slot = (queueHead + queueCount) % FRAME_QUEUE_SIZE;
+        }
+        
+        int delay;
+        stbi_uc *canvas = stbi_gif_stream_next(stream, &delay);
+        if (canvas == NULL) {
+            // loop the animation; a stream that cannot produce a single frame stops here
+            if (!stbi_gif_stream_rewind(stream) || (canvas = stbi_gif_stream_next(stream, &delay)) == NULL) break;
+        }
+        
+        // only this thread writes slots past the end of the queue, so the copy needs no lock
+        DecodedFrame &frame = queue[slot];
+        memcpy(frame.pixels.data(), canvas, frame.pixels.size());
+        frame.delay = delay > 0 ? delay : DEFAULT_FRAME_DELAY;
+        
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            queueCount++;
+        }
+        queueChanged.notify_all();
+    }
+    
+    stbi_gif_stream_close(stream);
+    ImageArena::Reset();
+}
+
+void AnimatedTexture::Update(float delta_time) {
+    frameTimeLeft -= delta_time * MILLISECONDS_IN_SECOND;
+    if (frameTimeLeft > 0.0f) return;
+    
+    DecodedFrame *frame;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        // if the decoder has fallen behind, keep showing the current frame rather than waiting on it
+        if (queueCount == 0) return;
+        frame = &queue[queueHead];
+    }
+    
+    currentTexture = (currentTexture + 1) % TEXTURE_RING_SIZE;
+    glBindTexture(GL_TEXTURE_2D, textureIDs[currentTexture]);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, frame->pixels.data());
+    
+    frameTimeLeft += frame->delay;
+    if (frameTimeLeft < 0.0f) frameTimeLeft = 0.0f;
+    
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queueHead = (queueHead + 1) % FRAME_QUEUE_SIZE;
+        queueCount--;
+    }
+    queueChanged.notify_all();
+}
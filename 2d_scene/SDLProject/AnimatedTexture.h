@@ -0,0 +1,63 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "MappedFile.h"
+
+// Animated GIF sprite. A worker thread streams frames out of the mapped file a few frames ahead of
+// playback into a fixed queue, and the render thread uploads each due frame into the next texture
+// of a small ring so it never writes to a texture the GPU may still be sampling. Memory use is
+// independent of the number of frames in the animation.
+class AnimatedTexture {
+    public:
+    
+        static const int FRAME_QUEUE_SIZE  = 4;
+        static const int TEXTURE_RING_SIZE = 3;
+    
+        AnimatedTexture();
+        ~AnimatedTexture();
+    
+        AnimatedTexture(const AnimatedTexture &) = delete;
+        AnimatedTexture &operator=(const AnimatedTexture &) = delete;
+    
+        bool Load(const char *filepath);
+        void Cleanup();
+    
+        // Advances playback by delta_time seconds, uploading the next frame once the current one's delay has elapsed.
+        void Update(float delta_time);
+    
+        GLuint TextureID() const { return textureIDs[currentTexture]; }
+    
+        int width;
+        int height;
+    
+    private:
+    
+        struct DecodedFrame {
+            std::vector<unsigned char> pixels;
+            int delay;
+        };
+    
+        void DecodeFrames();
+    
+        MappedFile file;
+    
+        std::thread             decoder;
+        std::mutex              queueMutex;
+        std::condition_variable queueChanged;
+        DecodedFrame            queue[FRAME_QUEUE_SIZE];
+        int                     queueHead;
+        int                     queueCount;
+        bool                    decoding;
+    
+        GLuint textureIDs[TEXTURE_RING_SIZE];
+        int    currentTexture;
+        float  frameTimeLeft;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#include <SDL_opengl.h>
+#include "glm/vec2.hpp"
+#include "Transform2D.h"
+
+// The components shared by both games. Each wraps its data in a struct of its own so that two
+// components holding a glm::vec2 are still different columns of a World.
+// Transform2D is a component too: the world transform a TransformHierarchy composes from the three below.
+
+struct Position {
+    glm::vec2 value;
+};
+
+// Radians, counter-clockwise.
+struct Rotation {
+    float angle;
+};
+
+struct Scale {
+    glm::vec2 value;
+};
+
+// Units per second, added to Position by integrate_velocities.
+struct Velocity {
+    glm::vec2 value;
+};
+
+// An axis-aligned box centred on Position.
+struct Collider {
+    glm::vec2 halfExtents;
+};
+
+struct Sprite {
+    GLuint textureID;
+};
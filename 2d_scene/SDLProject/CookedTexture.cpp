@@ -0,0 +1,85 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "CookedTexture.h"
+#include "MappedFile.h"
+
+#include <cstring>
+
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+namespace {
+
+// offset and length come from the file, so they are compared without adding them, which could wrap
+bool fits_in_file(uint64_t offset, uint64_t length, size_t file_size) {
+    return offset <= file_size && length <= file_size - offset;
+}
+
+// the bytes glTexImage2D or glCompressedTexImage2D reads for one level
+uint64_t level_bytes(uint32_t format, uint32_t width, uint32_t height) {
+    if (format == COOKED_FORMAT_DXT5) return ((width + 3) / 4) * (uint64_t) ((height + 3) / 4) * 16;
+    return (uint64_t) width * height * 4;
+}
+
+// Every offset and length the loader follows must land inside the mapping, and each level must hold
+// as many bytes as its size says the upload will read. A truncated or corrupt file fails here.
+bool is_cooked_texture_valid(const CookedTextureHeader *header, size_t file_size) {
+    if (memcmp(header->magic, COOKED_TEXTURE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != COOKED_TEXTURE_VERSION ||
+        (header->format != COOKED_FORMAT_RGBA8 && header->format != COOKED_FORMAT_DXT5) ||
+        header->width == 0 || header->height == 0 ||
+        header->mipCount == 0 || header->mipCount > (uint32_t) COOKED_MAX_MIP_LEVELS) return false;
+    
+    for (uint32_t i = 0; i < header->mipCount; i++) {
+        const CookedMipLevel &level = header->mips[i];
+        uint32_t width = header->width >> i, height = header->height >> i;
+        if (level.width != (width > 0 ? width : 1) || level.height != (height > 0 ? height : 1)) return false;
+        if (level.size < level_bytes(header->format, level.width, level.height)) return false;
+        if (!fits_in_file(level.offset, level.size, file_size)) return false;
+    }
+    
+    return header->atlasRegionCount == 0 ||
+           (header->atlasOffset % alignof(AtlasRegion) == 0 &&
+            fits_in_file(header->atlasOffset, (uint64_t) header->atlasRegionCount * sizeof(AtlasRegion), file_size));
+}
+
+}
+
+GLuint load_cooked_texture(const char *cooked_path, std::vector<AtlasRegion> *atlas_regions) {
+    MappedFile file(cooked_path);
+    if (!file.IsOpen() || file.Size() < sizeof(CookedTextureHeader)) return 0;
+    
+    const CookedTextureHeader *header = reinterpret_cast<const CookedTextureHeader *>(file.Data());
+    if (!is_cooked_texture_valid(header, file.Size())) return 0;
+    
+    if (atlas_regions != NULL) {
+        const AtlasRegion *regions = reinterpret_cast<const AtlasRegion *>(file.Data() + header->atlasOffset);
+        atlas_regions->assign(regions, regions + header->atlasRegionCount);
+    }
+    
+    GLuint textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    
+    // every level is already in its final layout: the driver copies straight out of the page cache
+    for (uint32_t i = 0; i < header->mipCount; i++) {
+        const CookedMipLevel &level = header->mips[i];
+        const unsigned char *pixels = file.Data() + level.offset;
+        
+        if (header->format == COOKED_FORMAT_DXT5) {
+            glCompressedTexImage2D(GL_TEXTURE_2D, (GLint) i, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, level.width, level.height, 0,
+                                   (GLsizei) level.size, pixels);
+        }
+        else {
+            glTexImage2D(GL_TEXTURE_2D, (GLint) i, GL_RGBA, level.width, level.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        }
+    }
+    
+    // trilinear when minified so scaled-down sprites read a level close to their on-screen size
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint) header->mipCount - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, header->mipCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    
+    return textureID;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Cooked texture container (".ctex"): a fixed header, an optional atlas UV table and the full mip
+// chain, each level starting on a 64-byte boundary. Levels are stored exactly as glTexImage2D /
+// glCompressedTexImage2D consume them, so loading is a file mapping plus one upload per level.
+const char     COOKED_TEXTURE_EXTENSION[] = ".ctex";
+const char     COOKED_TEXTURE_MAGIC[4]    = { 'C', 'T', 'E', 'X' };
+const uint32_t COOKED_TEXTURE_VERSION     = 3;
+const uint32_t COOKED_PAYLOAD_ALIGNMENT   = 64;
+const int      COOKED_MAX_MIP_LEVELS      = 16;
+
+enum CookedTextureFormat : uint32_t {
+    COOKED_FORMAT_RGBA8 = 0,
+    COOKED_FORMAT_DXT5  = 1,   // block-compressed payload produced by an external encoder
+};
+
+struct CookedMipLevel {
+    uint64_t offset;
+    uint64_t size;
+    uint32_t width;
+    uint32_t height;
+};
+
+struct CookedTextureHeader {
+    char     magic[4];
+    uint32_t version;
+    uint32_t format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t mipCount;
+    uint32_t atlasRegionCount;
+    uint32_t atlasOffset;
+    
+    // identity of the source image this file was cooked from
+    uint64_t sourceHash;
+    uint64_t sourceSize;
+    int64_t  sourceModified;   // nanoseconds since the epoch
+    
+    CookedMipLevel mips[COOKED_MAX_MIP_LEVELS];
+};
+
+struct AtlasRegion {
+    float u0, v0;
+    float u1, v1;
+};
+
+// FNV-1a over the source file's bytes.
+uint64_t hash_texture_source(const unsigned char *data, size_t size);
+
+// True if the cooked file exists and was cooked from the current contents of source_path. A source
+// whose timestamp changed but whose contents hash the same only has its stamp refreshed.
+bool is_cooked_texture_current(const char *source_path, const char *cooked_path);
+
+// Decodes source_path and writes the cooked container, including the full mip chain.
+bool cook_texture(const char *source_path, const char *cooked_path,
+                  const std::vector<AtlasRegion> &atlas_regions = std::vector<AtlasRegion>());
+
+// Maps a cooked container and uploads every level straight from the mapping. Returns 0 on failure.
+GLuint load_cooked_texture(const char *cooked_path, std::vector<AtlasRegion> *atlas_regions = NULL);
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+
+// Parameters of a fractal simplex noise field sampled on a regular grid.
+struct NoiseGridDesc {
+    glm::vec3 origin;        // sample (0, 0); z is only read when animated
+    bool      animated;      // sample the slice at origin.z of 3D noise instead of 2D noise; about 2.5x the cost
+    glm::vec2 step;          // distance between neighbouring samples along x and y
+    int       octaves;
+    float     lacunarity;    // frequency multiplier per octave
+    float     gain;          // amplitude multiplier per octave
+};
+
+// Single-octave 2D noise with unit spacing.
+NoiseGridDesc default_noise_grid();
+
+// Fills out[y * width + x] with noise in [-1, 1], split by rows across thread_count worker threads
+// (0 picks the hardware count). Each worker runs the 8- or 4-wide glm::simplexGrid kernel.
+void fill_noise_grid(const NoiseGridDesc &desc, int width, int height, float *out, int thread_count = 0);
+
+// Maps noise in [-1, 1] to 8-bit luminance for upload as a GL_LUMINANCE texture.
+void noise_to_luminance(const float *noise, unsigned char *out, size_t count);
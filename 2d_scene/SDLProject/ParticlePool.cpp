@@ -0,0 +1,115 @@
+#include "ParticlePool.h"
+#include "glm/gtc/packing.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+namespace {
+    // jitter can push a lifetime to zero or below; such particles live one frame instead
+    const float MIN_LIFETIME = 1e-3f;
+}
+
+ParticlePool::ParticlePool(size_t capacity) : capacity(capacity), ages(capacity), inverseLifetimes(capacity), sizes(capacity),
+                                              colors(capacity), seed(0x9E3779B9u)
+{
+    positions.reserve(capacity);
+    velocities.reserve(capacity);
+}
+
+float ParticlePool::Random() {
+    // xorshift32; the top 23 bits become the mantissa of a float in [2, 4)
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    uint32_t bits = 0x40000000u | (seed >> 9);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value - 3.0f;
+}
+
+size_t ParticlePool::Emit(const ParticleEmitter &emitter, size_t count) {
+    size_t first = positions.size();
+    if (count > capacity - first) count = capacity - first;
+
+    positions.resize(first + count);
+    velocities.resize(first + count);
+
+    float *x  = positions.component(0),  *y  = positions.component(1);
+    float *vx = velocities.component(0), *vy = velocities.component(1);
+    const uint32_t color = glm::packUnorm4x8(emitter.color);
+
+    for (size_t i = first; i < first + count; i++)
+    {
+        x[i]  = emitter.position.x + emitter.positionJitter.x * Random();
+        y[i]  = emitter.position.y + emitter.positionJitter.y * Random();
+        vx[i] = emitter.velocity.x + emitter.velocityJitter * Random();
+        vy[i] = emitter.velocity.y + emitter.velocityJitter * Random();
+
+        ages[i]             = 0.0f;
+        inverseLifetimes[i] = 1.0f / std::max(emitter.lifetime + emitter.lifetimeJitter * Random(), MIN_LIFETIME);
+        sizes[i]            = emitter.size;
+        colors[i]           = color;
+    }
+
+    return count;
+}
+
+void ParticlePool::Update(float deltaTime, const glm::vec2 &gravity) {
+    glm::soaIntegrate(positions, velocities, gravity, deltaTime);
+
+    float *x  = positions.component(0),  *y  = positions.component(1);
+    float *vx = velocities.component(0), *vy = velocities.component(1);
+    size_t count = positions.size();
+
+    // aging and expiry in one pass; a dead particle takes the last one's place, and since that one
+    // has not been aged yet the slot is simply visited again
+    for (size_t i = 0; i < count;)
+    {
+        ages[i] += deltaTime * inverseLifetimes[i];
+        if (ages[i] < 1.0f)
+        {
+            i++;
+            continue;
+        }
+
+        size_t last = --count;
+        x[i] = x[last];   y[i] = y[last];
+        vx[i] = vx[last]; vy[i] = vy[last];
+        ages[i] = ages[last];
+        inverseLifetimes[i] = inverseLifetimes[last];
+        sizes[i] = sizes[last];
+        colors[i] = colors[last];
+    }
+
+    positions.resize(count);
+    velocities.resize(count);
+}
+
+void ParticlePool::Clear() {
+    positions.clear();
+    velocities.clear();
+}
+
+size_t ParticlePool::WriteInstances(ParticleInstance *out, size_t maxCount) const {
+    size_t count = positions.size() < maxCount ? positions.size() : maxCount;
+
+    const float *x = positions.component(0), *y = positions.component(1);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        float remaining = 1.0f - ages[i];
+        uint32_t alpha = uint32_t(float(colors[i] >> 24) * remaining);
+
+        ParticleInstance &instance = out[i];
+        instance.position[0] = x[i];
+        instance.position[1] = y[i];
+        instance.size = sizes[i] * remaining;
+
+        // out may be write-combined driver memory, so it is written once, front to back
+        uint32_t tint = (colors[i] & 0x00FFFFFFu) | (alpha << 24);
+        memcpy(instance.tint, &tint, sizeof(tint));
+    }
+
+    return count;
+}
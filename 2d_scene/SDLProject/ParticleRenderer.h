@@ -0,0 +1,39 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include <cstddef>
+#include "glm/mat4x4.hpp"
+#include "ShaderProgram.h"
+#include "ParticlePool.h"
+
+// True when the context can draw instanced arrays (GL 3.3 or ARB_instanced_arrays).
+bool particles_supported();
+
+// Draws a ParticlePool as instanced quads: one unit quad, and one ParticleInstance per particle
+// streamed into a buffer that is orphaned every frame, so writing it never waits on the GPU still
+// reading the previous frame's copy.
+class ParticleRenderer {
+    public:
+
+        // capacity is the most particles one Draw shows; the rest are dropped.
+        void Load(const char *vertexShaderFile, const char *fragmentShaderFile, size_t capacity);
+        void Cleanup();
+
+        void SetProjectionMatrix(const glm::mat4 &matrix) { program.SetProjectionMatrix(matrix); }
+        void SetViewMatrix(const glm::mat4 &matrix) { program.SetViewMatrix(matrix); }
+
+        // Leaves this renderer's program current.
+        void Draw(const ParticlePool &pool, GLuint textureID);
+
+        ShaderProgram program;
+
+    private:
+
+        GLuint instanceBuffer;
+        GLuint instanceAttribute;
+        size_t capacity;
+};
@@ -10,6 +10,7 @@
 #include <fstream>
 #include <sstream>
 #include "glm/mat4x4.hpp"
+#include "Transform2D.h"
 
 class ShaderProgram {
     public:
@@ -17,14 +18,26 @@ class ShaderProgram {
 		void Load(const char *vertexShaderFile, const char *fragmentShaderFile);
 		void Cleanup();
 
+        // Builds a new program from source and swaps it in under the same object, keeping every
+        // attribute at its current location. The old program is kept, and false returned, when the
+        // new one fails to compile or link. Uniforms start over, so the caller sets its matrices again.
+        bool Reload(const std::string &vertexSource, const std::string &fragmentSource);
+
 		void SetModelMatrix(const glm::mat4 &matrix);
+		void SetModelMatrix(const Transform2D &transform);
         void SetProjectionMatrix(const glm::mat4 &matrix);
         void SetViewMatrix(const glm::mat4 &matrix);
 	
 		void SetColor(float r, float g, float b, float a);
+
+        // Sets the tint attribute's current value back to white. A disabled attribute reads its
+        // current value, which starts as (0, 0, 0, 1), so draws without a tint array need this.
+        void ResetTint() const;
 	
         GLuint LoadShaderFromString(const std::string &shaderContents, GLenum type);
+        GLuint LoadShaderFromString(const char *shaderContents, GLint shaderLength, GLenum type);
         GLuint LoadShaderFromFile(const std::string &shaderFile, GLenum type);
+        void LookUpLocations();
     
         GLuint programID;
     
@@ -35,7 +48,12 @@ class ShaderProgram {
 	
         GLuint positionAttribute;
         GLuint texCoordAttribute;
+        GLuint tintAttribute;
     
         GLuint vertexShader;
         GLuint fragmentShader;
 };
+
+// True when the current context's GL_VERSION is at least major.minor. This is the version the driver
+// created, which can be older or newer than the one asked of SDL.
+bool gl_version_at_least(int major, int minor);
@@ -0,0 +1,151 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "SpriteAnimation.h"
+#include "SpriteMesh.h"
+#include "Transform2D.h"
+#include "glm/mat4x4.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+std::vector<AtlasRegion> grid_frames(int columns, int rows, int count) {
+    std::vector<AtlasRegion> frames;
+
+    for (int i = 0; i < count && i < columns * rows; i++)
+    {
+        int column = i % columns, row = i / columns;
+        frames.push_back(AtlasRegion { float(column) / columns, float(row) / rows,
+                                       float(column + 1) / columns, float(row + 1) / rows });
+    }
+
+    return frames;
+}
+
+AtlasRegion pixel_region(int x, int y, int width, int height, int texture_width, int texture_height) {
+    return AtlasRegion { float(x) / texture_width, float(y) / texture_height,
+                         float(x + width) / texture_width, float(y + height) / texture_height };
+}
+
+AtlasRegion mirrored(const AtlasRegion &region) {
+    return AtlasRegion { region.u1, region.v0, region.u0, region.v1 };
+}
+
+uint16_t SpriteAnimator::AddSheet(GLuint textureID, const std::vector<AtlasRegion> &frames) {
+    Sheet sheet;
+    sheet.textureID = textureID;
+    sheet.frames = frames;
+    sheets.push_back(sheet);
+
+    return uint16_t(sheets.size() - 1);
+}
+
+uint16_t SpriteAnimator::AddClip(uint16_t sheet, const std::vector<uint16_t> &frames, const std::vector<float> &durations) {
+    assert(frames.size() == durations.size() && "every frame of a clip needs a duration");
+
+    // without asserts, a mismatched clip plays only the frames that have a duration
+    size_t count = std::min(frames.size(), durations.size());
+
+    Clip clip;
+    clip.sheet = sheet;
+    clip.length = 0.0f;
+    for (size_t i = 0; i < count; i++) clip.length += durations[i];
+
+    // each step shows the frame playing at the step's midpoint
+    size_t frame = 0;
+    float frame_end = count == 0 ? 0.0f : durations[0];
+
+    for (int step = 0; step < FRAME_TABLE_SIZE; step++)
+    {
+        float time = (step + 0.5f) * clip.length / FRAME_TABLE_SIZE;
+        while (time >= frame_end && frame + 1 < count) frame_end += durations[++frame];
+
+        clip.frameAt[step] = count == 0 ? 0 : frames[frame];
+    }
+
+    clips.push_back(clip);
+    return uint16_t(clips.size() - 1);
+}
+
+void SpriteAnimator::Play(World &world, Entity entity, uint16_t clip, float speed, float phase) {
+    const Clip &played = clips[clip];
+    uint16_t frame = played.frameAt[int(phase * FRAME_TABLE_SIZE) & (FRAME_TABLE_SIZE - 1)];
+
+    world.Add(entity, AnimationPlayer { played.sheet, clip, frame });
+    world.Add(entity, AnimationPhase { phase });
+    world.Add(entity, AnimationRate { played.length > 0.0f ? speed / played.length : 0.0f });
+    world.Add(entity, SpriteFrame { sheets[played.sheet].frames[frame] });
+}
+
+void SpriteAnimator::Update(World &world, float deltaTime) {
+    // phases and rates are columns of their own, and the loop has no branches, so the compiler runs it
+    // several players per instruction; rates are never negative, so truncation is floor
+    world.EachChunk<AnimationPhase, AnimationRate>([deltaTime](size_t count, const Entity *, AnimationPhase *phases, AnimationRate *rates) {
+        for (size_t i = 0; i < count; i++)
+        {
+            float phase = phases[i].value + rates[i].loopsPerSecond * deltaTime;
+            phases[i].value = phase - float(int(phase));
+        }
+    });
+
+    // then the table lookups, which are gathers, and a write only for players whose frame moved on
+    world.EachChunk<AnimationPlayer, AnimationPhase, SpriteFrame>([this](size_t count, const Entity *, AnimationPlayer *players,
+                                                                         AnimationPhase *phases, SpriteFrame *frames) {
+        for (size_t i = 0; i < count; i++)
+        {
+            const Clip &clip = clips[players[i].clip];
+            uint16_t frame = clip.frameAt[int(phases[i].value * FRAME_TABLE_SIZE) & (FRAME_TABLE_SIZE - 1)];
+            if (frame == players[i].frame) continue;
+
+            players[i].frame = frame;
+            frames[i].region = sheets[clip.sheet].frames[frame];
+        }
+    });
+}
+
+void SpriteAnimator::Draw(World &world, ShaderProgram &program) {
+    for (size_t s = 0; s < sheets.size(); s++)
+    {
+        sheets[s].positions.clear();
+        sheets[s].texCoords.clear();
+    }
+
+    // the unit quad's corners pushed through each transform, and the frame's rect in the quad's corner order
+    world.EachChunk<AnimationPlayer, SpriteFrame, Transform2D>([this](size_t count, const Entity *, AnimationPlayer *players,
+                                                                      SpriteFrame *frames, Transform2D *transforms) {
+        for (size_t i = 0; i < count; i++)
+        {
+            Sheet &sheet = sheets[players[i].sheet];
+
+            size_t first = sheet.positions.size();
+            sheet.positions.resize(first + SPRITE_QUAD_VERTEX_COUNT * 2);
+            apply_transform(transforms[i], reinterpret_cast<const glm::vec2 *>(UNIT_SPRITE_QUAD.positions),
+                            reinterpret_cast<glm::vec2 *>(&sheet.positions[first]), SPRITE_QUAD_VERTEX_COUNT);
+
+            const AtlasRegion &r = frames[i].region;
+            const float corners[SPRITE_QUAD_VERTEX_COUNT * 2] = {
+                r.u0, r.v1,   r.u1, r.v1,   r.u1, r.v0,
+                r.u0, r.v1,   r.u1, r.v0,   r.u0, r.v0,
+            };
+            sheet.texCoords.insert(sheet.texCoords.end(), corners, corners + SPRITE_QUAD_VERTEX_COUNT * 2);
+        }
+    });
+
+    program.SetModelMatrix(glm::mat4(1.0f));
+
+    for (size_t s = 0; s < sheets.size(); s++)
+    {
+        const Sheet &sheet = sheets[s];
+        if (sheet.positions.empty()) continue;
+
+        glVertexAttribPointer(program.positionAttribute, 2, GL_FLOAT, false, 0, sheet.positions.data());
+        glEnableVertexAttribArray(program.positionAttribute);
+        glVertexAttribPointer(program.texCoordAttribute, 2, GL_FLOAT, false, 0, sheet.texCoords.data());
+        glEnableVertexAttribArray(program.texCoordAttribute);
+
+        glBindTexture(GL_TEXTURE_2D, sheet.textureID);
+        glDrawArrays(GL_TRIANGLES, 0, GLsizei(sheet.positions.size() / 2));
+    }
+
+    glDisableVertexAttribArray(program.positionAttribute);
+    glDisableVertexAttribArray(program.texCoordAttribute);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CookedTexture.h"
+#include "ShaderProgram.h"
+#include "World.h"
+
+// Frame rects of a sheet, in texture coordinates with v0 at the top row as AtlasRegion has it.
+// A grid sheet is columns x rows equal cells numbered row by row from the top-left; count may stop
+// short of a full last row. A packed sheet lists each frame's pixel rect.
+std::vector<AtlasRegion> grid_frames(int columns, int rows, int count);
+AtlasRegion pixel_region(int x, int y, int width, int height, int texture_width, int texture_height);
+
+// The same rect sampled right to left, for facing the other way without another frame.
+AtlasRegion mirrored(const AtlasRegion &region);
+
+// Which clip an entity plays, and the frame it last showed. sheet is filled in by Play.
+struct AnimationPlayer {
+    uint16_t sheet;
+    uint16_t clip;
+    uint16_t frame;
+};
+
+// Where playback is, as a fraction of the clip: clips loop, so it stays in [0, 1).
+struct AnimationPhase {
+    float value;
+};
+
+// Loops of the clip per second: the playback speed over the clip's length.
+struct AnimationRate {
+    float loopsPerSecond;
+};
+
+// The texture rect of the frame on show; the only thing Update writes when a frame changes.
+struct SpriteFrame {
+    AtlasRegion region;
+};
+
+// Sheets, the clips played from them, and the systems that advance and draw animated entities.
+// An animated entity has a Transform2D, the three components above and a SpriteFrame; it does
+// not need a Sprite, and draw_sprites does not draw it.
+class SpriteAnimator {
+    public:
+
+        uint16_t AddSheet(GLuint textureID, const std::vector<AtlasRegion> &frames);
+
+        // frames index the sheet's frames, each shown for the matching duration in seconds; the two
+        // must be the same length.
+        uint16_t AddClip(uint16_t sheet, const std::vector<uint16_t> &frames, const std::vector<float> &durations);
+
+        // Starts entity on clip at speed times its natural rate, phase of the way in.
+        void Play(World &world, Entity entity, uint16_t clip, float speed = 1.0f, float phase = 0.0f);
+
+        // Advances every player, then rewrites the SpriteFrame of those whose frame changed.
+        void Update(World &world, float deltaTime);
+
+        // One draw call per sheet for every animated entity on it, with the quad's corners moved to
+        // world space on the CPU. Leaves program's model matrix at identity.
+        void Draw(World &world, ShaderProgram &program);
+
+    private:
+
+        // Every clip is resampled onto this many equal steps of its length, so finding the frame at
+        // any phase is one lookup instead of a walk through the durations.
+        static const int FRAME_TABLE_SIZE = 256;
+
+        struct Sheet {
+            GLuint textureID;
+            std::vector<AtlasRegion> frames;
+
+            // vertices batched for this sheet's draw, kept between frames
+            std::vector<float> positions;
+            std::vector<float> texCoords;
+        };
+
+        struct Clip {
+            uint16_t sheet;
+            float length;   // seconds
+            uint16_t frameAt[FRAME_TABLE_SIZE];
+        };
+
+        std::vector<Sheet> sheets;
+        std::vector<Clip> clips;
+};
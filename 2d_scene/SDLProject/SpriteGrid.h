@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "glm/vec2.hpp"
+#include "World.h"
+#include "TransformHierarchy.h"
+#include "Tilemap.h"
+
+// What the last Query did: bounds tested, sprites found on screen, and the indexed sprites it left
+// out, whether their bounds were tested or their cell never looked at.
+struct CullStats {
+    size_t tested;
+    size_t visible;
+    size_t culled;
+};
+
+// A loose grid over the world-space bounds of every sprite (an entity with a Transform2D and a Sprite,
+// drawn as a unit quad). Each sprite lives in the one cell holding its centre, and a query widens the
+// view rectangle by half a cell to catch those reaching in from outside, so a sprite up to a cell
+// across is found in one cell and never duplicated. Larger sprites sit in a list every query tests.
+// Cells are hashed, so the grid has no bounds and costs nothing where the scene is empty; a query
+// touches only the cells under the view, however many sprites lie elsewhere.
+class SpriteGrid {
+    public:
+
+        explicit SpriteGrid(float cellSize);
+
+        // Re-files the sprites whose world transform changed in hierarchy's last Update, adding any
+        // seen for the first time. To be run after TransformHierarchy::Update.
+        void Update(World &world, const TransformHierarchy &hierarchy);
+
+        // Forgets entity; to be called before it is destroyed or loses its Sprite.
+        void Remove(Entity entity);
+
+        // Appends to visible every sprite whose bounds overlap rect, cell by cell.
+        void Query(const ViewRect &rect, std::vector<Entity> &visible);
+
+        const CullStats &LastStats() const { return stats; }
+        size_t Count() const { return count; }
+
+    private:
+
+        struct Item {
+            Entity entity;
+            glm::vec2 min;
+            glm::vec2 max;
+        };
+
+        // where an entity is filed, by entity index
+        struct Record {
+            uint64_t cell;
+            uint32_t slot;       // NOT_FILED when the entity is not in the grid
+            bool oversized;      // in the oversized list rather than a cell
+        };
+
+        static const uint32_t NOT_FILED = 0xFFFFFFFFu;
+
+        uint64_t CellOf(const glm::vec2 &point) const;
+        std::vector<Item> &Items(const Record &record);
+        void File(const Item &item);
+        void Unfile(uint32_t index);
+        void Test(const std::vector<Item> &items, const ViewRect &rect, std::vector<Entity> &visible);
+
+        float cellSize;
+        float inverseCellSize;
+
+        std::unordered_map<uint64_t, std::vector<Item>> cells;
+        std::vector<Item> oversized;
+        std::vector<Record> records;
+        size_t count;
+
+        CullStats stats;
+};
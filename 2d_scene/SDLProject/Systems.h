@@ -0,0 +1,21 @@
+#pragma once
+
+#include <vector>
+#include "World.h"
+#include "Components.h"
+#include "TransformHierarchy.h"
+#include "ShaderProgram.h"
+
+// Position += Velocity * deltaTime for every entity in the hierarchy with a non-zero velocity,
+// marking just those nodes dirty.
+void integrate_velocities(World &world, TransformHierarchy &hierarchy, float deltaTime);
+
+// True when the colliders of a and b overlap; false when either has no Position or Collider.
+bool colliders_overlap(World &world, Entity a, Entity b);
+
+// Draws every entity with a Transform2D and a Sprite as one quad each, with the quad's vertices
+// already bound. The texture is only rebound when it changes from one sprite to the next.
+void draw_sprites(World &world, ShaderProgram &program, int vertexCount);
+
+// The same for just the given sprites, such as those a SpriteGrid query found on screen.
+void draw_sprites(World &world, ShaderProgram &program, int vertexCount, const std::vector<Entity> &sprites);
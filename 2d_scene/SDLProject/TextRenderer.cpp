@@ -0,0 +1,244 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "TextRenderer.h"
+#include "glm/mat4x4.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    const int FIRST_GLYPH = ' ', GLYPH_COUNT = 64;
+
+    // glyphs are 5x7 pixels in cells of 6x8, which leave a pixel between letters and between lines
+    const int GLYPH_WIDTH = 5, GLYPH_HEIGHT = 7;
+    const int CELL_WIDTH = 6, CELL_HEIGHT = 8;
+    const float CELL_ASPECT = float(CELL_WIDTH) / CELL_HEIGHT;
+
+    // the atlas is 16 x 4 cells of 8x8 texels, so it stays a power of two on both sides
+    const int ATLAS_COLUMNS = 16, ATLAS_CELL = 8;
+    const int ATLAS_WIDTH = ATLAS_COLUMNS * ATLAS_CELL, ATLAS_HEIGHT = (GLYPH_COUNT / ATLAS_COLUMNS) * ATLAS_CELL;
+
+    const int QUAD_VERTEX_COUNT = 6;
+
+    // ' ' to '_', one byte per row from the top, the leftmost pixel in bit 4
+    const uint8_t FONT_5X7[GLYPH_COUNT][GLYPH_HEIGHT] = {
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04 },   //   !
+        { 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A },   // " #
+        { 0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04 }, { 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 },   // $ %
+        { 0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D }, { 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00 },   // & '
+        { 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 }, { 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 },   // ( )
+        { 0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00 }, { 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00 },   // * +
+        { 0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08 }, { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 },   // , -
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C }, { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 },   // . /
+        { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E }, { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E },   // 0 1
+        { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F }, { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E },   // 2 3
+        { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 }, { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E },   // 4 5
+        { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E }, { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 },   // 6 7
+        { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E }, { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C },   // 8 9
+        { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 }, { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08 },   // : ;
+        { 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02 }, { 0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00 },   // < =
+        { 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08 }, { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04 },   // > ?
+        { 0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E }, { 0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11 },   // @ A
+        { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E }, { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E },   // B C
+        { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C }, { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F },   // D E
+        { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 }, { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F },   // F G
+        { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 }, { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E },   // H I
+        { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C }, { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 },   // J K
+        { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F }, { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 },   // L M
+        { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 }, { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E },   // N O
+        { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 }, { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D },   // P Q
+        { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 }, { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E },   // R S
+        { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E },   // T U
+        { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 }, { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A },   // V W
+        { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 }, { 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 },   // X Y
+        { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F }, { 0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E },   // Z [
+        { 0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 }, { 0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E },   // \ ]
+        { 0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F },   // ^ _
+    };
+
+    // the font's glyph for c: lower case folds to upper case, and anything else missing is '?'
+    int glyph_index(char c)
+    {
+        if (c >= 'a' && c <= 'z') c = char(c - 'a' + 'A');
+        if (c < FIRST_GLYPH || c >= FIRST_GLYPH + GLYPH_COUNT) c = '?';
+        return c - FIRST_GLYPH;
+    }
+
+    uint8_t to_unorm8(float value)
+    {
+        return uint8_t(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+    }
+}
+
+void TextRenderer::Load(size_t maxGlyphs) {
+    // white texels, with the font in the alpha channel for the tint to colour
+    std::vector<uint8_t> pixels(ATLAS_WIDTH * ATLAS_HEIGHT * 4, 255);
+    for (int glyph = 0; glyph < GLYPH_COUNT; glyph++)
+    {
+        int left = (glyph % ATLAS_COLUMNS) * ATLAS_CELL, top = (glyph / ATLAS_COLUMNS) * ATLAS_CELL;
+
+        for (int y = 0; y < ATLAS_CELL; y++)
+        {
+            for (int x = 0; x < ATLAS_CELL; x++)
+            {
+                bool lit = x < GLYPH_WIDTH && y < GLYPH_HEIGHT && (FONT_5X7[glyph][y] & (0x10 >> x));
+                pixels[((top + y) * ATLAS_WIDTH + left + x) * 4 + 3] = lit ? 255 : 0;
+            }
+        }
+    }
+
+    glGenTextures(1, &atlasTexture);
+    glBindTexture(GL_TEXTURE_2D, atlasTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, ATLAS_WIDTH, ATLAS_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glGenBuffers(1, &vertexBuffer);
+
+    this->maxGlyphs = maxGlyphs;
+    usedGlyphs = 0;
+    labels.clear();
+    text.assign(maxGlyphs, '\0');
+    vertices.resize(maxGlyphs * QUAD_VERTEX_COUNT);
+}
+
+void TextRenderer::Cleanup() {
+    glDeleteTextures(1, &atlasTexture);
+    glDeleteBuffers(1, &vertexBuffer);
+}
+
+TextLabel TextRenderer::CreateLabel(size_t maxLength, const glm::vec2 &position, float glyphHeight, const glm::vec4 &color,
+                                    TextAlign align) {
+    Label label;
+    label.position = position;
+    label.glyphHeight = glyphHeight;
+    for (int c = 0; c < 4; c++) label.tint[c] = to_unorm8(color[c]);
+    label.align = align;
+
+    // past the room Load made, a label just gets whatever is left
+    label.first = usedGlyphs;
+    label.capacity = std::min(maxLength, maxGlyphs - usedGlyphs);
+    label.length = 0;
+    label.quadCount = 0;
+    usedGlyphs += label.capacity;
+
+    labels.push_back(label);
+    return TextLabel(labels.size() - 1);
+}
+
+void TextRenderer::SetText(TextLabel label, const char *newText) {
+    Label &l = labels[label];
+
+    size_t length = std::min(strlen(newText), l.capacity);
+    if (length == l.length && memcmp(&text[l.first], newText, length) == 0) return;
+
+    memcpy(&text[l.first], newText, length);
+    l.length = length;
+    Layout(l);
+}
+
+void TextRenderer::SetPosition(TextLabel label, const glm::vec2 &position) {
+    Label &l = labels[label];
+    if (l.position == position) return;
+
+    l.position = position;
+    Layout(l);
+}
+
+void TextRenderer::SetColor(TextLabel label, const glm::vec4 &color) {
+    Label &l = labels[label];
+    for (int c = 0; c < 4; c++) l.tint[c] = to_unorm8(color[c]);
+    Layout(l);
+}
+
+void TextRenderer::Layout(Label &label) {
+    const char *characters = &text[label.first];
+    TextVertex *out = &vertices[label.first * QUAD_VERTEX_COUNT];
+
+    const float height = label.glyphHeight, advance = height * CELL_ASPECT;
+    const float alignment = label.align == TEXT_ALIGN_CENTER ? 0.5f : label.align == TEXT_ALIGN_RIGHT ? 1.0f : 0.0f;
+
+    // glyph quads cover the drawn 5x7 of their cell, so neighbours never overlap
+    const float glyphWidth = advance * GLYPH_WIDTH / CELL_WIDTH, glyphHeight = height * GLYPH_HEIGHT / CELL_HEIGHT;
+    const float texelU = 1.0f / ATLAS_WIDTH, texelV = 1.0f / ATLAS_HEIGHT;
+
+    label.quadCount = 0;
+    float top = label.position.y;
+
+    for (size_t lineStart = 0; lineStart < label.length; top -= height)
+    {
+        size_t lineEnd = lineStart;
+        while (lineEnd < label.length && characters[lineEnd] != '\n') lineEnd++;
+
+        float left = label.position.x - alignment * advance * float(lineEnd - lineStart);
+
+        for (size_t i = lineStart; i < lineEnd; i++, left += advance)
+        {
+            if (characters[i] == ' ') continue;
+
+            int glyph = glyph_index(characters[i]);
+            float u0 = (glyph % ATLAS_COLUMNS) * ATLAS_CELL * texelU, v0 = (glyph / ATLAS_COLUMNS) * ATLAS_CELL * texelV;
+            float u1 = u0 + GLYPH_WIDTH * texelU, v1 = v0 + GLYPH_HEIGHT * texelV;
+            float right = left + glyphWidth, bottom = top - glyphHeight;
+
+            // the corner order of SpriteMesh's quads: v0 is the atlas's top row
+            const TextVertex quad[QUAD_VERTEX_COUNT] = {
+                { { left,  bottom }, { u0, v1 }, {} }, { { right, bottom }, { u1, v1 }, {} }, { { right, top }, { u1, v0 }, {} },
+                { { left,  bottom }, { u0, v1 }, {} }, { { right, top    }, { u1, v0 }, {} }, { { left,  top }, { u0, v0 }, {} },
+            };
+
+            for (int v = 0; v < QUAD_VERTEX_COUNT; v++)
+            {
+                out[v] = quad[v];
+                memcpy(out[v].tint, label.tint, sizeof(label.tint));
+            }
+            out += QUAD_VERTEX_COUNT;
+            label.quadCount++;
+        }
+
+        lineStart = lineEnd + 1;
+    }
+}
+
+void TextRenderer::Draw(ShaderProgram &program) {
+    size_t quads = 0;
+    for (size_t i = 0; i < labels.size(); i++) quads += labels[i].quadCount;
+    if (quads == 0) return;
+
+    // a fresh store each frame, filled with every label's cached run back to back
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, quads * QUAD_VERTEX_COUNT * sizeof(TextVertex), NULL, GL_STREAM_DRAW);
+    TextVertex *out = (TextVertex *) glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+    bool filled = false;
+    if (out)
+    {
+        for (size_t i = 0; i < labels.size(); i++)
+        {
+            size_t count = labels[i].quadCount * QUAD_VERTEX_COUNT;
+            memcpy(out, &vertices[labels[i].first * QUAD_VERTEX_COUNT], count * sizeof(TextVertex));
+            out += count;
+        }
+
+        // only a mapped buffer may be unmapped; GL_FALSE means the store was lost while mapped
+        filled = glUnmapBuffer(GL_ARRAY_BUFFER) == GL_TRUE;
+    }
+
+    const GLsizei stride = sizeof(TextVertex);
+    glVertexAttribPointer(program.positionAttribute, 2, GL_FLOAT, false, stride, (const void *) offsetof(TextVertex, position));
+    glEnableVertexAttribArray(program.positionAttribute);
+    glVertexAttribPointer(program.texCoordAttribute, 2, GL_FLOAT, false, stride, (const void *) offsetof(TextVertex, texCoord));
+    glEnableVertexAttribArray(program.texCoordAttribute);
+    glVertexAttribPointer(program.tintAttribute, 4, GL_UNSIGNED_BYTE, true, stride, (const void *) offsetof(TextVertex, tint));
+    glEnableVertexAttribArray(program.tintAttribute);
+
+    program.SetModelMatrix(glm::mat4(1.0f));
+    glBindTexture(GL_TEXTURE_2D, atlasTexture);
+    if (filled) glDrawArrays(GL_TRIANGLES, 0, GLsizei(quads * QUAD_VERTEX_COUNT));
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDisableVertexAttribArray(program.positionAttribute);
+    glDisableVertexAttribArray(program.texCoordAttribute);
+    glDisableVertexAttribArray(program.tintAttribute);
+
+    program.ResetTint();
+}
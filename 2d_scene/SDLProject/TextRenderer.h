@@ -0,0 +1,85 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "glm/vec2.hpp"
+#include "glm/vec4.hpp"
+#include "ShaderProgram.h"
+
+// Where a label's position sits on its text: the left end, the middle or the right end of each line.
+enum TextAlign {
+    TEXT_ALIGN_LEFT,
+    TEXT_ALIGN_CENTER,
+    TEXT_ALIGN_RIGHT,
+};
+
+// Handle to a label of a TextRenderer.
+typedef uint32_t TextLabel;
+
+// Text from a built-in 5x7 pixel font, rasterised once into a small atlas. The font covers printable
+// ASCII from space to underscore; lower case is drawn as upper case and anything else as '?'.
+// Each label keeps the world-space quads of its current text and rebuilds them only when its text,
+// position or colour changes, so a frame's cost is copying those runs into one streamed buffer and
+// a single draw call for every label. All storage is sized by Load and CreateLabel: nothing is
+// allocated per frame, however often the text changes.
+class TextRenderer {
+    public:
+
+        // maxGlyphs is the room shared by every label created afterwards.
+        void Load(size_t maxGlyphs);
+        void Cleanup();
+
+        // A label with room for maxLength characters, each glyphHeight tall and 3/4 as wide, with the
+        // top of its first line at position.y. Starts empty.
+        TextLabel CreateLabel(size_t maxLength, const glm::vec2 &position, float glyphHeight, const glm::vec4 &color,
+                              TextAlign align = TEXT_ALIGN_LEFT);
+
+        // Lays the text out again only when it differs from the label's current text; text past the
+        // label's length is cut. '\n' starts a new line below.
+        void SetText(TextLabel label, const char *text);
+        void SetPosition(TextLabel label, const glm::vec2 &position);
+        void SetColor(TextLabel label, const glm::vec4 &color);
+
+        // Every label in one draw call, through program's position, texCoord and tint attributes.
+        // Leaves program's model matrix at identity.
+        void Draw(ShaderProgram &program);
+
+        GLuint AtlasTexture() const { return atlasTexture; }
+
+    private:
+
+        struct TextVertex {
+            float position[2];
+            float texCoord[2];
+            uint8_t tint[4];
+        };
+
+        struct Label {
+            glm::vec2 position;
+            float glyphHeight;
+            uint8_t tint[4];
+            TextAlign align;
+
+            size_t first;       // into text, and into vertices six to a glyph
+            size_t capacity;
+            size_t length;      // characters of text
+            size_t quadCount;   // glyphs with a quad; spaces and line breaks have none
+        };
+
+        void Layout(Label &label);
+
+        GLuint atlasTexture;
+        GLuint vertexBuffer;
+
+        std::vector<Label> labels;
+        std::vector<char> text;
+        std::vector<TextVertex> vertices;
+        size_t maxGlyphs;
+        size_t usedGlyphs;
+};
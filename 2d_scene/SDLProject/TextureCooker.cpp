@@ -0,0 +1,160 @@
+#include "CookedTexture.h"
+#include "MappedFile.h"
+#include "MipChain.h"
+#include "stb_image.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sys/stat.h>
+
+namespace {
+
+const int     RGBA_COMPONENTS       = 4;
+const int64_t NANOSECONDS_IN_SECOND = 1000000000;
+
+// size and modification time in nanoseconds; st_mtime alone would hide a same-size edit made
+// within the second the stamp was taken
+bool stat_file(const char *path, uint64_t *size, int64_t *modified) {
+    struct stat status;
+    if (stat(path, &status) != 0) return false;
+    
+    *size = (uint64_t) status.st_size;
+#if defined(__APPLE__)
+    *modified = (int64_t) status.st_mtimespec.tv_sec * NANOSECONDS_IN_SECOND + status.st_mtimespec.tv_nsec;
+#elif defined(_WINDOWS)
+    *modified = (int64_t) status.st_mtime * NANOSECONDS_IN_SECOND;
+#else
+    *modified = (int64_t) status.st_mtim.tv_sec * NANOSECONDS_IN_SECOND + status.st_mtim.tv_nsec;
+#endif
+    return true;
+}
+
+bool read_header(const char *cooked_path, CookedTextureHeader *header) {
+    FILE *file = fopen(cooked_path, "rb");
+    if (file == NULL) return false;
+    
+    bool valid = fread(header, sizeof(*header), 1, file) == 1 &&
+                 memcmp(header->magic, COOKED_TEXTURE_MAGIC, sizeof(header->magic)) == 0 &&
+                 header->version == COOKED_TEXTURE_VERSION;
+    fclose(file);
+    return valid;
+}
+
+uint64_t align_payload(uint64_t offset) {
+    return (offset + COOKED_PAYLOAD_ALIGNMENT - 1) & ~(uint64_t) (COOKED_PAYLOAD_ALIGNMENT - 1);
+}
+
+}
+
+uint64_t hash_texture_source(const unsigned char *data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool is_cooked_texture_current(const char *source_path, const char *cooked_path) {
+    CookedTextureHeader header;
+    uint64_t source_size, cooked_size;
+    int64_t  source_modified, cooked_modified;
+    
+    if (!read_header(cooked_path, &header)) return false;
+    if (!stat_file(source_path, &source_size, &source_modified)) return false;
+    
+    // a file system that keeps whole seconds gives a same-size edit made in the second of the cook
+    // the stamp the cook recorded, so a stamp less than a second older than the cook is confirmed
+    // by the hash
+    bool settled = stat_file(cooked_path, &cooked_size, &cooked_modified) &&
+                   cooked_modified - source_modified >= NANOSECONDS_IN_SECOND;
+    
+    // the common case costs two small reads and never touches the source's pixels
+    if (settled && header.sourceSize == source_size && header.sourceModified == source_modified) return true;
+    
+    MappedFile source(source_path);
+    if (!source.IsOpen() || hash_texture_source(source.Data(), source.Size()) != header.sourceHash) return false;
+    
+    // same bytes, new timestamp (a fresh checkout, a touch): refresh the stamp instead of re-cooking
+    FILE *file = fopen(cooked_path, "r+b");
+    if (file != NULL) {
+        header.sourceSize     = source_size;
+        header.sourceModified = source_modified;
+        fseek(file, offsetof(CookedTextureHeader, sourceSize), SEEK_SET);
+        fwrite(&header.sourceSize, sizeof(header.sourceSize) + sizeof(header.sourceModified), 1, file);
+        fclose(file);
+    }
+    return true;
+}
+
+bool cook_texture(const char *source_path, const char *cooked_path, const std::vector<AtlasRegion> &atlas_regions) {
+    MappedFile source(source_path);
+    if (!source.IsOpen()) return false;
+    
+    int width, height, components;
+    if (!stbi_info_from_memory(source.Data(), (int) source.Size(), &width, &height, &components)) return false;
+    
+    CookedTextureHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, COOKED_TEXTURE_MAGIC, sizeof(header.magic));
+    header.version          = COOKED_TEXTURE_VERSION;
+    header.format           = COOKED_FORMAT_RGBA8;
+    header.width            = (uint32_t) width;
+    header.height           = (uint32_t) height;
+    header.atlasRegionCount = (uint32_t) atlas_regions.size();
+    header.atlasOffset      = sizeof(CookedTextureHeader);
+    header.sourceHash       = hash_texture_source(source.Data(), source.Size());
+    stat_file(source_path, &header.sourceSize, &header.sourceModified);
+    
+    // lay out the chain first so every level can be decoded / filtered in place in one buffer
+    uint64_t offset = align_payload(header.atlasOffset + atlas_regions.size() * sizeof(AtlasRegion));
+    uint64_t payload_start = offset;
+    int level_width = width, level_height = height;
+    
+    while (header.mipCount < (uint32_t) COOKED_MAX_MIP_LEVELS) {
+        CookedMipLevel &level = header.mips[header.mipCount++];
+        level.offset = offset;
+        level.size   = (uint64_t) level_width * level_height * RGBA_COMPONENTS;
+        level.width  = (uint32_t) level_width;
+        level.height = (uint32_t) level_height;
+        offset = align_payload(offset + level.size);
+        
+        if (level_width == 1 && level_height == 1) break;
+        level_width  = level_width  > 1 ? level_width  / 2 : 1;
+        level_height = level_height > 1 ? level_height / 2 : 1;
+    }
+    
+    std::vector<unsigned char> payload(offset - payload_start);
+    int decoded_width, decoded_height;
+    if (!stbi_load_from_memory_into(source.Data(), (int) source.Size(), payload.data(), width, height, width * RGBA_COMPONENTS,
+                                    &decoded_width, &decoded_height, &components, RGBA_COMPONENTS, 0)) return false;
+    
+    // cooking happens once per source change, so spend the time on the sharper filter
+    MipLevelView levels[COOKED_MAX_MIP_LEVELS];
+    for (uint32_t i = 0; i < header.mipCount; i++) {
+        levels[i].pixels = &payload[header.mips[i].offset - payload_start];
+        levels[i].width  = (int) header.mips[i].width;
+        levels[i].height = (int) header.mips[i].height;
+    }
+    generate_mip_chain(levels, (int) header.mipCount, MIP_FILTER_KAISER);
+    
+    // write to a temporary name and rename, so a crash mid-cook never leaves a valid-looking file
+    std::string temporary_path = std::string(cooked_path) + ".tmp";
+    FILE *file = fopen(temporary_path.c_str(), "wb");
+    if (file == NULL) return false;
+    
+    std::vector<unsigned char> padding(payload_start - header.atlasOffset - atlas_regions.size() * sizeof(AtlasRegion), 0);
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   (atlas_regions.empty() || fwrite(atlas_regions.data(), sizeof(AtlasRegion), atlas_regions.size(), file) == atlas_regions.size()) &&
+                   (padding.empty() || fwrite(padding.data(), 1, padding.size(), file) == padding.size()) &&
+                   fwrite(payload.data(), 1, payload.size(), file) == payload.size();
+    written = fclose(file) == 0 && written;
+    
+    if (!written || rename(temporary_path.c_str(), cooked_path) != 0) {
+        remove(temporary_path.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,192 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "Tilemap.h"
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/common.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const int CHUNK_TILES = TILEMAP_CHUNK_SIZE * TILEMAP_CHUNK_SIZE;
+    const int QUAD_CORNERS = 4, QUAD_INDICES = 6;
+}
+
+ViewRect visible_rect(const glm::mat4 &projection, const glm::mat4 &view) {
+    glm::mat4 clip_to_world = glm::inverse(projection * view);
+
+    ViewRect rect;
+    for (int corner = 0; corner < 4; corner++)
+    {
+        glm::vec4 point = clip_to_world * glm::vec4(corner & 1 ? 1.0f : -1.0f, corner & 2 ? 1.0f : -1.0f, 0.0f, 1.0f);
+        glm::vec2 world = glm::vec2(point) / point.w;
+
+        rect.min = corner == 0 ? world : glm::min(rect.min, world);
+        rect.max = corner == 0 ? world : glm::max(rect.max, world);
+    }
+
+    return rect;
+}
+
+Tilemap::Tilemap(int width, int height, float tileSize, glm::vec2 origin)
+    : width(width), height(height),
+      chunksWide((width + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE),
+      chunksHigh((height + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE),
+      tileSize(tileSize), origin(origin),
+      tiles(size_t(width) * height, EMPTY_TILE),
+      chunks(size_t(chunksWide) * chunksHigh, Chunk { 0, 0, true }),
+      textureID(0), indexBuffer(0) {
+}
+
+void Tilemap::SetTileset(GLuint textureID, const std::vector<AtlasRegion> &frames) {
+    this->textureID = textureID;
+    this->frames = frames;
+
+    // texture coordinates are baked into the chunks
+    for (size_t c = 0; c < chunks.size(); c++) chunks[c].dirty = true;
+}
+
+uint16_t Tilemap::Tile(int x, int y) const {
+    if (x < 0 || y < 0 || x >= width || y >= height) return EMPTY_TILE;
+    return tiles[size_t(y) * width + x];
+}
+
+void Tilemap::SetTile(int x, int y, uint16_t tile) {
+    if (x < 0 || y < 0 || x >= width || y >= height) return;
+
+    uint16_t &current = tiles[size_t(y) * width + x];
+    if (current == tile) return;
+
+    current = tile;
+    chunks[size_t(y / TILEMAP_CHUNK_SIZE) * chunksWide + x / TILEMAP_CHUNK_SIZE].dirty = true;
+}
+
+void Tilemap::SetTiles(const uint16_t *tiles) {
+    std::copy(tiles, tiles + this->tiles.size(), this->tiles.begin());
+    for (size_t c = 0; c < chunks.size(); c++) chunks[c].dirty = true;
+}
+
+void Tilemap::Build(int chunkX, int chunkY) {
+    Chunk &chunk = chunks[size_t(chunkY) * chunksWide + chunkX];
+    scratch.clear();
+
+    // corners in tiles from the chunk's own corner: small whole numbers, so no precision is lost
+    // however far the chunk is from the map's origin
+    int firstX = chunkX * TILEMAP_CHUNK_SIZE, firstY = chunkY * TILEMAP_CHUNK_SIZE;
+    int lastX = std::min(firstX + TILEMAP_CHUNK_SIZE, width), lastY = std::min(firstY + TILEMAP_CHUNK_SIZE, height);
+
+    for (int y = firstY; y < lastY; y++)
+    {
+        const uint16_t *row = &tiles[size_t(y) * width];
+        for (int x = firstX; x < lastX; x++)
+        {
+            if (row[x] >= frames.size()) continue;
+
+            const AtlasRegion &r = frames[row[x]];
+            float left = float(x - firstX), bottom = float(y - firstY);
+
+            // bottom-left, bottom-right, top-right, top-left; v0 is the image's top row
+            scratch.push_back(TileVertex { { left,        bottom        }, { r.u0, r.v1 } });
+            scratch.push_back(TileVertex { { left + 1.0f, bottom        }, { r.u1, r.v1 } });
+            scratch.push_back(TileVertex { { left + 1.0f, bottom + 1.0f }, { r.u1, r.v0 } });
+            scratch.push_back(TileVertex { { left,        bottom + 1.0f }, { r.u0, r.v0 } });
+        }
+    }
+
+    chunk.quadCount = GLsizei(scratch.size() / QUAD_CORNERS);
+    chunk.dirty = false;
+
+    if (chunk.quadCount == 0)
+    {
+        if (chunk.buffer != 0) glDeleteBuffers(1, &chunk.buffer);
+        chunk.buffer = 0;
+        return;
+    }
+
+    // a rebuilt chunk gets a new store, so the driver need not wait for draws still reading the old one
+    if (chunk.buffer == 0) glGenBuffers(1, &chunk.buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, chunk.buffer);
+    glBufferData(GL_ARRAY_BUFFER, scratch.size() * sizeof(TileVertex), scratch.data(), GL_STATIC_DRAW);
+}
+
+TilemapDrawStats Tilemap::Draw(ShaderProgram &program, const glm::mat4 &projection, const glm::mat4 &view) {
+    TilemapDrawStats stats = { 0, 0 };
+
+    if (indexBuffer == 0)
+    {
+        std::vector<GLushort> indices(CHUNK_TILES * QUAD_INDICES);
+        for (int q = 0; q < CHUNK_TILES; q++)
+        {
+            const GLushort corner = GLushort(q * QUAD_CORNERS);
+            const GLushort quad[QUAD_INDICES] = { corner, GLushort(corner + 1), GLushort(corner + 2),
+                                                  corner, GLushort(corner + 2), GLushort(corner + 3) };
+            std::copy(quad, quad + QUAD_INDICES, &indices[q * QUAD_INDICES]);
+        }
+
+        glGenBuffers(1, &indexBuffer);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), indices.data(), GL_STATIC_DRAW);
+
+        // unbound again at once, so the early return below leaves no buffer bound either
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+
+    // the chunks the view rectangle touches, clamped to the map
+    ViewRect rect = visible_rect(projection, view);
+    const float chunkSize = tileSize * TILEMAP_CHUNK_SIZE;
+    int minX = std::max(int(std::floor((rect.min.x - origin.x) / chunkSize)), 0);
+    int minY = std::max(int(std::floor((rect.min.y - origin.y) / chunkSize)), 0);
+    int maxX = std::min(int(std::floor((rect.max.x - origin.x) / chunkSize)), chunksWide - 1);
+    int maxY = std::min(int(std::floor((rect.max.y - origin.y) / chunkSize)), chunksHigh - 1);
+    if (minX > maxX || minY > maxY) return stats;
+
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+
+    const GLsizei stride = sizeof(TileVertex);
+    glEnableVertexAttribArray(program.positionAttribute);
+    glEnableVertexAttribArray(program.texCoordAttribute);
+
+    for (int chunkY = minY; chunkY <= maxY; chunkY++)
+    {
+        for (int chunkX = minX; chunkX <= maxX; chunkX++)
+        {
+            Chunk &chunk = chunks[size_t(chunkY) * chunksWide + chunkX];
+            if (chunk.dirty)
+            {
+                Build(chunkX, chunkY);
+                stats.chunksBuilt++;
+            }
+            if (chunk.quadCount == 0) continue;
+
+            glm::vec3 corner = glm::vec3(origin + glm::vec2(chunkX, chunkY) * chunkSize, 0.0f);
+            program.SetModelMatrix(glm::scale(glm::translate(glm::mat4(1.0f), corner), glm::vec3(tileSize, tileSize, 1.0f)));
+
+            glBindBuffer(GL_ARRAY_BUFFER, chunk.buffer);
+            glVertexAttribPointer(program.positionAttribute, 2, GL_FLOAT, false, stride, (const void *) offsetof(TileVertex, position));
+            glVertexAttribPointer(program.texCoordAttribute, 2, GL_FLOAT, false, stride, (const void *) offsetof(TileVertex, texCoord));
+
+            glDrawElements(GL_TRIANGLES, chunk.quadCount * QUAD_INDICES, GL_UNSIGNED_SHORT, NULL);
+            stats.chunksDrawn++;
+        }
+    }
+
+    // everything else in the games reads its vertices from client memory
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glDisableVertexAttribArray(program.positionAttribute);
+    glDisableVertexAttribArray(program.texCoordAttribute);
+
+    return stats;
+}
+
+void Tilemap::Cleanup() {
+    for (size_t c = 0; c < chunks.size(); c++)
+    {
+        if (chunks[c].buffer != 0) glDeleteBuffers(1, &chunks[c].buffer);
+        chunks[c] = Chunk { 0, 0, true };
+    }
+
+    if (indexBuffer != 0) glDeleteBuffers(1, &indexBuffer);
+    indexBuffer = 0;
+}
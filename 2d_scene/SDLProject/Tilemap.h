@@ -0,0 +1,95 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "glm/mat4x4.hpp"
+#include "glm/vec2.hpp"
+#include "CookedTexture.h"
+#include "ShaderProgram.h"
+
+// Tiles per side of a chunk: a full chunk is 1024 quads, whose 4096 corners still fit 16-bit indices.
+const int TILEMAP_CHUNK_SIZE = 32;
+
+// A tile with nothing drawn in it.
+const uint16_t EMPTY_TILE = 0xFFFF;
+
+// The world-space rectangle an orthographic camera shows: the NDC square mapped back through the
+// inverse of projection * view, widened to axis-aligned bounds if the view is rotated.
+struct ViewRect {
+    glm::vec2 min;
+    glm::vec2 max;
+};
+
+ViewRect visible_rect(const glm::mat4 &projection, const glm::mat4 &view);
+
+// What the last Draw did: a draw call per chunk drawn, and the chunks it had to (re)build first.
+struct TilemapDrawStats {
+    size_t chunksDrawn;
+    size_t chunksBuilt;
+};
+
+// A width x height grid of tiles drawn from one tileset texture, split into square chunks. A chunk's
+// quads live in a static vertex buffer built the first time the chunk is on screen, and rebuilt only
+// after SetTile changes one of its tiles; Draw skips every chunk outside the camera's rectangle, so
+// its cost follows what is visible, not the size of the map.
+class Tilemap {
+    public:
+
+        // Tile (0, 0) has its bottom-left corner at origin, and tile y grows upwards.
+        Tilemap(int width, int height, float tileSize, glm::vec2 origin);
+
+        // frames are the tileset's tiles by index, as grid_frames or pixel_region build them.
+        void SetTileset(GLuint textureID, const std::vector<AtlasRegion> &frames);
+
+        uint16_t Tile(int x, int y) const;
+        void SetTile(int x, int y, uint16_t tile);
+
+        // Replaces every tile at once, row by row from the bottom; every chunk is rebuilt when next seen.
+        void SetTiles(const uint16_t *tiles);
+
+        // Uses program as it is, with the tileset bound and the model matrix moved to each chunk in turn.
+        TilemapDrawStats Draw(ShaderProgram &program, const glm::mat4 &projection, const glm::mat4 &view);
+
+        // Frees every chunk's buffer; needs the GL context the buffers were made in.
+        void Cleanup();
+
+        int Width() const { return width; }
+        int Height() const { return height; }
+
+    private:
+
+        // position and texture coordinate of one quad corner, in tiles from the chunk's corner
+        struct TileVertex {
+            float position[2];
+            float texCoord[2];
+        };
+
+        struct Chunk {
+            GLuint buffer;      // 0 until first built
+            GLsizei quadCount;
+            bool dirty;
+        };
+
+        void Build(int chunkX, int chunkY);
+
+        int width, height;
+        int chunksWide, chunksHigh;
+        float tileSize;
+        glm::vec2 origin;
+
+        std::vector<uint16_t> tiles;
+        std::vector<Chunk> chunks;
+
+        GLuint textureID;
+        std::vector<AtlasRegion> frames;
+
+        // one index buffer shared by every chunk: quad q is corners 4q to 4q + 3
+        GLuint indexBuffer;
+        std::vector<TileVertex> scratch;
+};
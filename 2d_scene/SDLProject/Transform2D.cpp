@@ -0,0 +1,118 @@
+#include "Transform2D.h"
+#include "glm/gtx/fast_trigonometry.hpp"
+
+#include <cmath>
+
+Transform2D Transform2D::FromTRS(const glm::vec2 &translation, float angle, const glm::vec2 &scale) {
+    return FromTRS(translation, std::cos(angle), std::sin(angle), scale);
+}
+
+Transform2D Transform2D::operator*(const Transform2D &other) const {
+    Transform2D result;
+    result.xAxis       = xAxis * other.xAxis.x + yAxis * other.xAxis.y;
+    result.yAxis       = xAxis * other.yAxis.x + yAxis * other.yAxis.y;
+    result.translation = xAxis * other.translation.x + yAxis * other.translation.y + translation;
+    return result;
+}
+
+Transform2D Transform2D::Inverse() const {
+    float inverse_determinant = 1.0f / (xAxis.x * yAxis.y - yAxis.x * xAxis.y);
+
+    Transform2D result;
+    result.xAxis       = glm::vec2( yAxis.y, -xAxis.y) * inverse_determinant;
+    result.yAxis       = glm::vec2(-yAxis.x,  xAxis.x) * inverse_determinant;
+    result.translation = -(result.xAxis * translation.x + result.yAxis * translation.y);
+    return result;
+}
+
+glm::vec2 Transform2D::Apply(const glm::vec2 &point) const {
+    return xAxis * point.x + yAxis * point.y + translation;
+}
+
+glm::mat4 Transform2D::ToMat4() const {
+    glm::mat4 matrix;
+    ToMat4(&matrix[0][0]);
+    return matrix;
+}
+
+void Transform2D::ToMat4(float matrix[16]) const {
+    matrix[0]  = xAxis.x;        matrix[1]  = xAxis.y;        matrix[2]  = 0.0f; matrix[3]  = 0.0f;
+    matrix[4]  = yAxis.x;        matrix[5]  = yAxis.y;        matrix[6]  = 0.0f; matrix[7]  = 0.0f;
+    matrix[8]  = 0.0f;           matrix[9]  = 0.0f;           matrix[10] = 1.0f; matrix[11] = 0.0f;
+    matrix[12] = translation.x;  matrix[13] = translation.y;  matrix[14] = 0.0f; matrix[15] = 1.0f;
+}
+
+void compose_transforms(const glm::vec2 *translations, const float *angles, const glm::vec2 *scales,
+                        Transform2D *out, size_t count)
+{
+    // sines and cosines a block at a time through the array kernel instead of libm per element
+    float sines[64], cosines[64];
+
+    for (size_t first = 0; first < count; first += 64)
+    {
+        size_t block = count - first < 64 ? count - first : 64;
+        glm::fastSinCos(angles + first, sines, cosines, block);
+
+        for (size_t i = 0; i < block; i++)
+        {
+            out[first + i] = Transform2D::FromTRS(translations[first + i], cosines[i], sines[i], scales[first + i]);
+        }
+    }
+}
+
+void compose_transforms(const glm::vec2 *translations, const glm::soa<glm::vec2> &rotors, const glm::vec2 *scales,
+                        Transform2D *out)
+{
+    const float *c = rotors.component(0),
+                *s = rotors.component(1);
+
+    // double-angle identities turn the half-angle rotor into the cosine and sine of the rotation
+    for (size_t i = 0; i < rotors.size(); i++)
+    {
+        out[i] = Transform2D::FromTRS(translations[i], c[i] * c[i] - s[i] * s[i], 2.0f * c[i] * s[i], scales[i]);
+    }
+}
+
+void compose_transforms(const glm::vec2 *translations, const glm::soa<glm::quat> &rotations, const glm::vec2 *scales,
+                        Transform2D *out)
+{
+    const float *x = rotations.component(0),
+                *y = rotations.component(1),
+                *z = rotations.component(2),
+                *w = rotations.component(3);
+
+    // the top-left 2x2 of mat3_cast: where the rotation takes the x and y axes, seen along z
+    for (size_t i = 0; i < rotations.size(); i++)
+    {
+        Transform2D &result = out[i];
+        result.xAxis       = glm::vec2(1.0f - 2.0f * (y[i] * y[i] + z[i] * z[i]), 2.0f * (x[i] * y[i] + w[i] * z[i])) * scales[i].x;
+        result.yAxis       = glm::vec2(2.0f * (x[i] * y[i] - w[i] * z[i]), 1.0f - 2.0f * (x[i] * x[i] + z[i] * z[i])) * scales[i].y;
+        result.translation = translations[i];
+    }
+}
+
+void concatenate_transforms(const Transform2D *parents, const Transform2D *locals, Transform2D *out, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        out[i] = parents[i] * locals[i];
+    }
+}
+
+void apply_transform(const Transform2D &transform, const glm::vec2 *in, glm::vec2 *out, size_t count)
+{
+    // copied to locals so stores through out cannot force the coefficients to be reloaded
+    const glm::vec2 x_axis = transform.xAxis,
+                    y_axis = transform.yAxis,
+                    offset = transform.translation;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        out[i] = x_axis * in[i].x + y_axis * in[i].y + offset;
+    }
+}
+
+void apply_transform(const Transform2D &transform, const glm::soa<glm::vec2> &in, glm::soa<glm::vec2> &out)
+{
+    glm::soaTransform(transform.ToMat4(), in, out);
+}
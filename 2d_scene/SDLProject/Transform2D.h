@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include "glm/vec2.hpp"
+#include "glm/mat4x4.hpp"
+#include "glm/gtx/soa.hpp"
+
+// A 2D affine transform in 6 floats: the images of the x and y axes plus a translation.
+// Built from translation, rotation and scale it holds scale.x * (cos, sin) and scale.y * (-sin, cos),
+// so composing and inverting stay closed even with non-uniform scale.
+struct Transform2D {
+    glm::vec2 xAxis;
+    glm::vec2 yAxis;
+    glm::vec2 translation;
+
+    // The builders that need no trigonometry are constexpr, so fixed transforms are baked in.
+    // glm's vectors are constexpr only without SIMD intrinsics, so GLM_CONSTEXPR drops it otherwise.
+    static GLM_CONSTEXPR Transform2D Identity() {
+        return Translation(glm::vec2(0.0f));
+    }
+
+    static GLM_CONSTEXPR Transform2D Translation(const glm::vec2 &translation) {
+        return Transform2D { glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, 1.0f), translation };
+    }
+
+    // T * R * S in one step: scale first, then rotate by angle (radians), then translate.
+    static Transform2D FromTRS(const glm::vec2 &translation, float angle, const glm::vec2 &scale);
+
+    static GLM_CONSTEXPR Transform2D FromTRS(const glm::vec2 &translation, float cosine, float sine, const glm::vec2 &scale) {
+        return Transform2D { glm::vec2(cosine, sine) * scale.x, glm::vec2(-sine, cosine) * scale.y, translation };
+    }
+
+    // (*this * other) applies other first, as with matrices.
+    Transform2D operator*(const Transform2D &other) const;
+    Transform2D Inverse() const;
+
+    glm::vec2 Apply(const glm::vec2 &point) const;
+
+    // Only at upload time: the full column-major matrix, with z passed through.
+    glm::mat4 ToMat4() const;
+    void ToMat4(float matrix[16]) const;
+};
+
+// Builds out[i] = FromTRS(translations[i], angles[i], scales[i]) for count transforms.
+void compose_transforms(const glm::vec2 *translations, const float *angles, const glm::vec2 *scales,
+                        Transform2D *out, size_t count);
+
+// The same with rotations held as 2D rotors, (cos(angle / 2), sin(angle / 2)) as glm::soaRotorMix
+// interpolates them. rotors.size() is the count.
+void compose_transforms(const glm::vec2 *translations, const glm::soa<glm::vec2> &rotors, const glm::vec2 *scales,
+                        Transform2D *out);
+
+// The same from 3D rotations: the x and y axes of each quaternion's rotation projected onto the
+// screen, so a sprite spinning about y narrows as the 2d_scene flower does.
+void compose_transforms(const glm::vec2 *translations, const glm::soa<glm::quat> &rotations, const glm::vec2 *scales,
+                        Transform2D *out);
+
+// out[i] = parents[i] * locals[i]; out may alias either input.
+void concatenate_transforms(const Transform2D *parents, const Transform2D *locals, Transform2D *out, size_t count);
+
+// Transforms count points by one transform; out may alias in.
+void apply_transform(const Transform2D &transform, const glm::vec2 *in, glm::vec2 *out, size_t count);
+
+// The same on structure-of-arrays points, through the 8-wide glm::soaTransform kernel.
+void apply_transform(const Transform2D &transform, const glm::soa<glm::vec2> &in, glm::soa<glm::vec2> &out);
@@ -0,0 +1,96 @@
+#include "TransformHierarchy.h"
+
+#include <algorithm>
+
+TransformHierarchy::TransformHierarchy() {}
+
+uint32_t TransformHierarchy::Attach(World &world, Entity entity, Entity parent) {
+    uint32_t node = uint32_t(parents.size());
+
+    const TransformNode *parentNode = world.Get<TransformNode>(parent);
+    parents.push_back(parentNode ? parentNode->node : NO_PARENT_NODE);
+    owners.push_back(entity);
+    locals.push_back(Transform2D::Identity());
+    worlds.push_back(Transform2D::Identity());
+    dirty.push_back(0);
+    subtreeEnds.push_back(node);
+
+    // the new node is the last one under each of its ancestors
+    for (uint32_t ancestor = parents[node]; ancestor != NO_PARENT_NODE; ancestor = parents[ancestor]) subtreeEnds[ancestor] = node;
+
+    world.Add(entity, TransformNode { node });
+    MarkDirty(node);
+
+    return node;
+}
+
+void TransformHierarchy::MarkDirty(uint32_t node) {
+    if (dirty[node]) return;
+
+    dirty[node] = 1;
+    dirtyNodes.push_back(node);
+}
+
+void TransformHierarchy::Update(World &world) {
+    changed.clear();
+    if (dirtyNodes.empty()) return;
+
+    // local transforms of the dirty nodes only, a block at a time through the array compose
+    glm::vec2 translations[64], scales[64];
+    float angles[64];
+    Transform2D composed[64];
+
+    for (size_t first = 0; first < dirtyNodes.size(); first += 64)
+    {
+        size_t block = dirtyNodes.size() - first < 64 ? dirtyNodes.size() - first : 64;
+
+        for (size_t i = 0; i < block; i++)
+        {
+            Entity owner = owners[dirtyNodes[first + i]];
+            const Position *position = world.Get<Position>(owner);
+            const Rotation *rotation = world.Get<Rotation>(owner);
+            const Scale *scale = world.Get<Scale>(owner);
+
+            translations[i] = position ? position->value : glm::vec2(0.0f);
+            angles[i]       = rotation ? rotation->angle : 0.0f;
+            scales[i]       = scale ? scale->value : glm::vec2(1.0f);
+        }
+
+        compose_transforms(translations, angles, scales, composed, block);
+
+        for (size_t i = 0; i < block; i++) locals[dirtyNodes[first + i]] = composed[i];
+    }
+
+    // parents precede children, so a node's parent is final by the time the node is reached,
+    // and a dirty flag left set on it marks its whole subtree. Only the span from a dirty node to the
+    // end of its subtree can change; a dirty node inside the span stretches it to cover its own subtree.
+    std::sort(dirtyNodes.begin(), dirtyNodes.end());
+
+    for (size_t next = 0; next < dirtyNodes.size();)
+    {
+        uint32_t end = subtreeEnds[dirtyNodes[next]];
+        for (uint32_t node = dirtyNodes[next]; node <= end; node++)
+        {
+            uint32_t parent = parents[node];
+            if (!dirty[node] && (parent == NO_PARENT_NODE || !dirty[parent])) continue;
+
+            worlds[node] = parent == NO_PARENT_NODE ? locals[node] : worlds[parent] * locals[node];
+            dirty[node] = 1;
+            changed.push_back(node);
+            end = std::max(end, subtreeEnds[node]);
+        }
+
+        while (next < dirtyNodes.size() && dirtyNodes[next] <= end) next++;
+    }
+
+    for (size_t i = 0; i < changed.size(); i++)
+    {
+        uint32_t node = changed[i];
+        dirty[node] = 0;
+
+        Transform2D *transform = world.Get<Transform2D>(owners[node]);
+        if (transform) *transform = worlds[node];
+    }
+
+    dirtyNodes.clear();
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "World.h"
+#include "Components.h"
+#include "Transform2D.h"
+
+// Links an entity to its node in a TransformHierarchy.
+struct TransformNode {
+    uint32_t node;
+};
+
+const uint32_t NO_PARENT_NODE = 0xFFFFFFFFu;
+
+// Parent/child transforms over a World. An attached entity's Position, Rotation and Scale are its
+// local transform and its Transform2D is the world transform, which Update rewrites only for nodes
+// marked dirty and their descendants. A frame in which nothing moved costs nothing.
+// Nodes sit in flat arrays in the order they were attached, and a parent must be attached before its
+// children, so every parent precedes its subtree and a forward pass propagates all changes. The pass
+// visits only the spans from each dirty node to the last node of its subtree, skipping the clean
+// nodes between them.
+class TransformHierarchy {
+    public:
+
+        TransformHierarchy();
+
+        // Gives entity (which needs Position, Rotation, Scale and Transform2D) a node under parent,
+        // or a root node when parent is NULL_ENTITY. The new node starts dirty.
+        uint32_t Attach(World &world, Entity entity, Entity parent = NULL_ENTITY);
+
+        // To be called by whatever changes an attached entity's Position, Rotation or Scale.
+        void MarkDirty(uint32_t node);
+
+        // Recomposes the local transform of every dirty node, then the world transforms of those nodes
+        // and everything below them, and writes each one back to its entity's Transform2D.
+        void Update(World &world);
+
+        // The nodes whose world transform changed in the last Update, in parent-before-child order:
+        // the only transforms that need uploading again.
+        const std::vector<uint32_t> &Changed() const { return changed; }
+
+        const Transform2D &WorldTransform(uint32_t node) const { return worlds[node]; }
+        Entity Owner(uint32_t node) const { return owners[node]; }
+        uint32_t Parent(uint32_t node) const { return parents[node]; }
+        size_t Size() const { return parents.size(); }
+
+    private:
+
+        std::vector<uint32_t> parents;
+        std::vector<Entity> owners;
+        std::vector<Transform2D> locals;
+        std::vector<Transform2D> worlds;
+        std::vector<unsigned char> dirty;
+        std::vector<uint32_t> subtreeEnds;  // the last node attached under each node, or the node itself
+
+        std::vector<uint32_t> dirtyNodes;   // each dirty node once, in marking order
+        std::vector<uint32_t> changed;
+};
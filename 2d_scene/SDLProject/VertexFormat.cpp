@@ -0,0 +1,68 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "VertexFormat.h"
+#include "glm/gtc/packing.hpp"
+
+#include <SDL.h>
+
+#ifndef GL_HALF_FLOAT
+#define GL_HALF_FLOAT 0x140B
+#endif
+
+namespace {
+    const size_t PACK_BLOCK = 64;
+}
+
+bool packed_vertices_supported() {
+    return gl_version_at_least(3, 0) || SDL_GL_ExtensionSupported("GL_ARB_half_float_vertex");
+}
+
+void pack_sprite_vertices(const float *positions, const float *tex_coords, const glm::vec4 *tints,
+                          PackedSpriteVertex *out, size_t count)
+{
+    // component arrays of one block, converted in bulk and then interleaved
+    uint16_t halves[PACK_BLOCK * 2], unorms[PACK_BLOCK * 2];
+    uint8_t  colours[PACK_BLOCK * 4];
+
+    for (size_t first = 0; first < count; first += PACK_BLOCK)
+    {
+        size_t block = count - first < PACK_BLOCK ? count - first : PACK_BLOCK;
+
+        glm::packHalf1x16(positions + first * 2, halves, block * 2);
+        glm::packUnorm1x16(tex_coords + first * 2, unorms, block * 2);
+        if (tints) glm::packUnorm1x8(&tints[first].x, colours, block * 4);
+
+        for (size_t i = 0; i < block; i++)
+        {
+            PackedSpriteVertex &vertex = out[first + i];
+            vertex.position[0] = halves[i * 2];
+            vertex.position[1] = halves[i * 2 + 1];
+            vertex.texCoord[0] = unorms[i * 2];
+            vertex.texCoord[1] = unorms[i * 2 + 1];
+            for (int c = 0; c < 4; c++) vertex.tint[c] = tints ? colours[i * 4 + c] : 255;
+        }
+    }
+}
+
+void bind_sprite_vertices(const ShaderProgram &program, const PackedSpriteVertex *vertices)
+{
+    const GLsizei stride = sizeof(PackedSpriteVertex);
+
+    glVertexAttribPointer(program.positionAttribute, 2, GL_HALF_FLOAT, false, stride, vertices->position);
+    glEnableVertexAttribArray(program.positionAttribute);
+
+    glVertexAttribPointer(program.texCoordAttribute, 2, GL_UNSIGNED_SHORT, true, stride, vertices->texCoord);
+    glEnableVertexAttribArray(program.texCoordAttribute);
+
+    glVertexAttribPointer(program.tintAttribute, 4, GL_UNSIGNED_BYTE, true, stride, vertices->tint);
+    glEnableVertexAttribArray(program.tintAttribute);
+}
+
+void unbind_sprite_vertices(const ShaderProgram &program)
+{
+    glDisableVertexAttribArray(program.positionAttribute);
+    glDisableVertexAttribArray(program.texCoordAttribute);
+    glDisableVertexAttribArray(program.tintAttribute);
+
+    program.ResetTint();
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include <cstddef>
+#include <cstdint>
+#include "glm/vec4.hpp"
+#include "ShaderProgram.h"
+
+// 12 bytes per vertex instead of the 16 (plus a uniform colour) of separate float arrays:
+// half-float position, unorm16 texture coordinates and an RGBA8 tint, interleaved.
+struct PackedSpriteVertex {
+    uint16_t position[2];   // half floats
+    uint16_t texCoord[2];   // [0, 1] as unorm16
+    uint8_t  tint[4];       // [0, 1] as unorm8
+};
+
+// True when the context can read GL_HALF_FLOAT attributes (GL 3.0 or ARB_half_float_vertex).
+bool packed_vertices_supported();
+
+// Packs count vertices from xy positions and uv pairs; tints may be NULL for opaque white.
+// Conversions run a block at a time through the glm array packers.
+void pack_sprite_vertices(const float *positions, const float *tex_coords, const glm::vec4 *tints,
+                          PackedSpriteVertex *out, size_t count);
+
+// Points the program's position, texCoord and tint attributes at vertices and enables them.
+void bind_sprite_vertices(const ShaderProgram &program, const PackedSpriteVertex *vertices);
+
+// Disables the attributes again and puts tint back to white for the float path.
+void unbind_sprite_vertices(const ShaderProgram &program);
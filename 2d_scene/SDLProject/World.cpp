@@ -0,0 +1,180 @@
+#include "World.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+// size in bytes of every registered component type, by id
+static size_t g_component_sizes[MAX_COMPONENT_TYPES];
+static int g_component_type_count = 0;
+
+int register_component_type(size_t size) {
+    assert(g_component_type_count < MAX_COMPONENT_TYPES);
+
+    g_component_sizes[g_component_type_count] = size;
+    return g_component_type_count++;
+}
+
+World::World() : liveCount(0) {
+    // the entity without components lives in the first archetype
+    FindArchetype(0);
+}
+
+World::~World() {
+    for (size_t a = 0; a < archetypes.size(); a++)
+    {
+        for (int id = 0; id < MAX_COMPONENT_TYPES; id++) free(archetypes[a]->columns[id]);
+        free(archetypes[a]->entities);
+        delete archetypes[a];
+    }
+}
+
+Entity World::Create() {
+    return Allocate(archetypes[0]);
+}
+
+void World::Destroy(Entity entity) {
+    if (!IsAlive(entity)) return;
+
+    EntityRecord &record = records[entity.index];
+    RemoveRow(record.archetype, record.row);
+
+    // the bumped generation is what turns every outstanding handle to this slot stale
+    record.archetype = nullptr;
+    record.generation++;
+    freeIndices.push_back(entity.index);
+    liveCount--;
+}
+
+bool World::IsAlive(Entity entity) const {
+    return entity.index < records.size() &&
+           records[entity.index].archetype != nullptr &&
+           records[entity.index].generation == entity.generation;
+}
+
+Entity World::Allocate(Archetype *archetype) {
+    Entity entity;
+
+    if (freeIndices.empty())
+    {
+        entity.index = uint32_t(records.size());
+        entity.generation = 0;
+        records.push_back(EntityRecord { nullptr, 0, 0 });
+    }
+    else
+    {
+        entity.index = freeIndices.back();
+        entity.generation = records[entity.index].generation;
+        freeIndices.pop_back();
+    }
+
+    if (archetype->count == archetype->capacity) Grow(archetype, archetype->capacity ? archetype->capacity * 2 : 64);
+
+    // the new row is left uninitialized; Create and Add write every component of it
+    size_t row = archetype->count++;
+    archetype->entities[row] = entity;
+
+    records[entity.index].archetype = archetype;
+    records[entity.index].row = row;
+    liveCount++;
+
+    return entity;
+}
+
+Archetype *World::FindArchetype(ComponentMask mask) {
+    for (size_t a = 0; a < archetypes.size(); a++)
+    {
+        if (archetypes[a]->mask == mask) return archetypes[a];
+    }
+
+    Archetype *archetype = new Archetype();
+    archetype->mask = mask;
+    archetypes.push_back(archetype);
+    return archetype;
+}
+
+void World::Grow(Archetype *archetype, size_t capacity) {
+    archetype->entities = static_cast<Entity *>(realloc(archetype->entities, capacity * sizeof(Entity)));
+
+    for (int id = 0; id < g_component_type_count; id++)
+    {
+        if (archetype->mask & (ComponentMask(1) << id))
+        {
+            archetype->columns[id] = static_cast<unsigned char *>(realloc(archetype->columns[id], capacity * g_component_sizes[id]));
+        }
+    }
+
+    archetype->capacity = capacity;
+}
+
+void World::RemoveRow(Archetype *archetype, size_t row) {
+    size_t last = --archetype->count;
+    if (row == last) return;
+
+    // fill the hole with the last row so the columns stay dense
+    for (int id = 0; id < g_component_type_count; id++)
+    {
+        if (archetype->mask & (ComponentMask(1) << id))
+        {
+            size_t size = g_component_sizes[id];
+            memcpy(archetype->columns[id] + row * size, archetype->columns[id] + last * size, size);
+        }
+    }
+
+    Entity moved = archetype->entities[last];
+    archetype->entities[row] = moved;
+    records[moved.index].row = row;
+}
+
+void World::Move(Entity entity, ComponentMask mask) {
+    Archetype *from = records[entity.index].archetype;
+    Archetype *to = FindArchetype(mask);
+    size_t fromRow = records[entity.index].row;
+
+    if (to->count == to->capacity) Grow(to, to->capacity ? to->capacity * 2 : 64);
+
+    size_t toRow = to->count++;
+    to->entities[toRow] = entity;
+
+    // components in both sets carry over; a newly added one is written by the caller
+    for (int id = 0; id < g_component_type_count; id++)
+    {
+        if (from->mask & mask & (ComponentMask(1) << id))
+        {
+            size_t size = g_component_sizes[id];
+            memcpy(to->columns[id] + toRow * size, from->columns[id] + fromRow * size, size);
+        }
+    }
+
+    RemoveRow(from, fromRow);
+
+    records[entity.index].archetype = to;
+    records[entity.index].row = toRow;
+}
+
+unsigned char *World::Component(Entity entity, int id) const {
+    if (!IsAlive(entity)) return nullptr;
+
+    const EntityRecord &record = records[entity.index];
+    if ((record.archetype->mask & (ComponentMask(1) << id)) == 0) return nullptr;
+
+    return record.archetype->columns[id] + record.row * g_component_sizes[id];
+}
+
+void Scheduler::Add(const char *name, System system) {
+    systems.push_back(Entry { name, system, true });
+}
+
+void Scheduler::SetEnabled(const char *name, bool enabled) {
+    for (size_t i = 0; i < systems.size(); i++)
+    {
+        if (strcmp(systems[i].name, name) == 0) systems[i].enabled = enabled;
+    }
+}
+
+void Scheduler::Run(World &world, float deltaTime) {
+    for (size_t i = 0; i < systems.size(); i++)
+    {
+        if (systems[i].enabled) systems[i].system(world, deltaTime);
+    }
+}
@@ -52,10 +52,32 @@ namespace detail
 		GLM_FUNC_QUALIFIER static mat<4, 4, float, Q> call(mat<4, 4, float, Q> const& m)
 		{
 			mat<4, 4, float, Q> Result;
-			glm_mat4_inverse(&m[0].data, &Result[0].data);
+#			if GLM_ARCH & GLM_ARCH_AVX_BIT
+				glm_mat4_inverse_block(&m[0].data, &Result[0].data);
+#			else
+				glm_mat4_inverse(&m[0].data, &Result[0].data);
+#			endif
 			return Result;
 		}
 	};
+
+#	if GLM_ARCH & GLM_ARCH_AVX_BIT
+	template<qualifier Q>
+	struct compute_inverse<4, 4, float, Q, false>
+	{
+		GLM_FUNC_QUALIFIER static mat<4, 4, float, Q> call(mat<4, 4, float, Q> const& m)
+		{
+			glm_vec4 const In[4] = {_mm_loadu_ps(&m[0][0]), _mm_loadu_ps(&m[1][0]), _mm_loadu_ps(&m[2][0]), _mm_loadu_ps(&m[3][0])};
+			glm_vec4 Out[4];
+			glm_mat4_inverse_block(In, Out);
+
+			mat<4, 4, float, Q> Result;
+			for(length_t i = 0; i < 4; ++i)
+				_mm_storeu_ps(&Result[i][0], Out[i]);
+			return Result;
+		}
+	};
+#	endif
 }//namespace detail
 
 #	if GLM_CONFIG_ALIGNED_GENTYPES == GLM_ENABLE
@@ -40,7 +40,7 @@ namespace glm
 	/// @see - glm::ortho(T const& left, T const& right, T const& bottom, T const& top, T const& zNear, T const& zFar)
 	/// @see <a href="https://www.khronos.org/registry/OpenGL-Refpages/gl2.1/xhtml/gluOrtho2D.xml">gluOrtho2D man page</a>
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> ortho(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> ortho(
 		T left, T right, T bottom, T top);
 
 	/// Creates a matrix for an orthographic parallel viewing volume, using left-handed coordinates.
@@ -50,7 +50,7 @@ namespace glm
 	///
 	/// @see - glm::ortho(T const& left, T const& right, T const& bottom, T const& top)
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> orthoLH_ZO(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> orthoLH_ZO(
 		T left, T right, T bottom, T top, T zNear, T zFar);
 
 	/// Creates a matrix for an orthographic parallel viewing volume using right-handed coordinates.
@@ -60,7 +60,7 @@ namespace glm
 	///
 	/// @see - glm::ortho(T const& left, T const& right, T const& bottom, T const& top)
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> orthoLH_NO(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> orthoLH_NO(
 		T left, T right, T bottom, T top, T zNear, T zFar);
 
 	/// Creates a matrix for an orthographic parallel viewing volume, using left-handed coordinates.
@@ -70,7 +70,7 @@ namespace glm
 	///
 	/// @see - glm::ortho(T const& left, T const& right, T const& bottom, T const& top)
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> orthoRH_ZO(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> orthoRH_ZO(
 		T left, T right, T bottom, T top, T zNear, T zFar);
 
 	/// Creates a matrix for an orthographic parallel viewing volume, using right-handed coordinates.
@@ -80,7 +80,7 @@ namespace glm
 	///
 	/// @see - glm::ortho(T const& left, T const& right, T const& bottom, T const& top)
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> orthoRH_NO(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> orthoRH_NO(
 		T left, T right, T bottom, T top, T zNear, T zFar);
 
 	/// Creates a matrix for an orthographic parallel viewing volume, using left-handed coordinates.
@@ -90,7 +90,7 @@ namespace glm
 	///
 	/// @see - glm::ortho(T const& left, T const& right, T const& bottom, T const& top)
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> orthoZO(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> orthoZO(
 		T left, T right, T bottom, T top, T zNear, T zFar);
 
 	/// Creates a matrix for an orthographic parallel viewing volume, using left-handed coordinates if GLM_FORCE_LEFT_HANDED if defined or right-handed coordinates otherwise.
@@ -100,7 +100,7 @@ namespace glm
 	///
 	/// @see - glm::ortho(T const& left, T const& right, T const& bottom, T const& top)
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> orthoNO(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> orthoNO(
 		T left, T right, T bottom, T top, T zNear, T zFar);
 
 	/// Creates a matrix for an orthographic parallel viewing volume, using left-handed coordinates.
@@ -111,7 +111,7 @@ namespace glm
 	///
 	/// @see - glm::ortho(T const& left, T const& right, T const& bottom, T const& top)
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> orthoLH(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> orthoLH(
 		T left, T right, T bottom, T top, T zNear, T zFar);
 
 	/// Creates a matrix for an orthographic parallel viewing volume, using right-handed coordinates.
@@ -122,7 +122,7 @@ namespace glm
 	///
 	/// @see - glm::ortho(T const& left, T const& right, T const& bottom, T const& top)
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> orthoRH(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> orthoRH(
 		T left, T right, T bottom, T top, T zNear, T zFar);
 
 	/// Creates a matrix for an orthographic parallel viewing volume, using the default handedness and default near and far clip planes definition.
@@ -133,7 +133,7 @@ namespace glm
 	/// @see - glm::ortho(T const& left, T const& right, T const& bottom, T const& top)
 	/// @see <a href="https://www.khronos.org/registry/OpenGL-Refpages/gl2.1/xhtml/glOrtho.xml">glOrtho man page</a>
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> ortho(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> ortho(
 		T left, T right, T bottom, T top, T zNear, T zFar);
 
 	/// Creates a left handed frustum matrix.
@@ -141,7 +141,7 @@ namespace glm
 	///
 	/// @tparam T A floating-point scalar type
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> frustumLH_ZO(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> frustumLH_ZO(
 		T left, T right, T bottom, T top, T near, T far);
 
 	/// Creates a left handed frustum matrix.
@@ -149,7 +149,7 @@ namespace glm
 	///
 	/// @tparam T A floating-point scalar type
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> frustumLH_NO(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> frustumLH_NO(
 		T left, T right, T bottom, T top, T near, T far);
 
 	/// Creates a right handed frustum matrix.
@@ -157,7 +157,7 @@ namespace glm
 	///
 	/// @tparam T A floating-point scalar type
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> frustumRH_ZO(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> frustumRH_ZO(
 		T left, T right, T bottom, T top, T near, T far);
 
 	/// Creates a right handed frustum matrix.
@@ -165,7 +165,7 @@ namespace glm
 	///
 	/// @tparam T A floating-point scalar type
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> frustumRH_NO(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> frustumRH_NO(
 		T left, T right, T bottom, T top, T near, T far);
 
 	/// Creates a frustum matrix using left-handed coordinates if GLM_FORCE_LEFT_HANDED if defined or right-handed coordinates otherwise.
@@ -173,7 +173,7 @@ namespace glm
 	///
 	/// @tparam T A floating-point scalar type
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> frustumZO(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> frustumZO(
 		T left, T right, T bottom, T top, T near, T far);
 
 	/// Creates a frustum matrix using left-handed coordinates if GLM_FORCE_LEFT_HANDED if defined or right-handed coordinates otherwise.
@@ -181,7 +181,7 @@ namespace glm
 	///
 	/// @tparam T A floating-point scalar type
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> frustumNO(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> frustumNO(
 		T left, T right, T bottom, T top, T near, T far);
 
 	/// Creates a left handed frustum matrix.
@@ -190,7 +190,7 @@ namespace glm
 	///
 	/// @tparam T A floating-point scalar type
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> frustumLH(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> frustumLH(
 		T left, T right, T bottom, T top, T near, T far);
 
 	/// Creates a right handed frustum matrix.
@@ -199,7 +199,7 @@ namespace glm
 	///
 	/// @tparam T A floating-point scalar type
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> frustumRH(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> frustumRH(
 		T left, T right, T bottom, T top, T near, T far);
 
 	/// Creates a frustum matrix with default handedness, using the default handedness and default near and far clip planes definition.
@@ -208,7 +208,7 @@ namespace glm
 	/// @tparam T A floating-point scalar type
 	/// @see <a href="https://www.khronos.org/registry/OpenGL-Refpages/gl2.1/xhtml/glFrustum.xml">glFrustum man page</a>
 	template<typename T>
-	GLM_FUNC_DECL mat<4, 4, T, defaultp> frustum(
+	GLM_FUNC_DECL GLM_CONSTEXPR mat<4, 4, T, defaultp> frustum(
 		T left, T right, T bottom, T top, T near, T far);
 
 
@@ -17,6 +17,8 @@
 #include "../detail/setup.hpp"
 #include "../detail/qualifier.hpp"
 #include "../exponential.hpp"
+#include "../common.hpp"
+#include "../vector_relational.hpp"
 #include "../vec3.hpp"
 #include "../vec4.hpp"
 #include <limits>
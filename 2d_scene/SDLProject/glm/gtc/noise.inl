@@ -804,4 +804,542 @@ namespace gtc
 			(dot(m0 * m0, vec<3, T, Q>(dot(p0, x0), dot(p1, x1), dot(p2, x2))) +
 			dot(m1 * m1, vec<2, T, Q>(dot(p3, x3), dot(p4, x4))));
 	}
+
+	// Batches
+	//
+	// The *_lanes kernels repeat the scalar functions above one operation at a
+	// time, in the same order, on lanes<V> registers: the webgl-noise hashes are
+	// float arithmetic only, so each lane gives the scalar result up to
+	// contraction into fused multiply-add.
+	namespace detail
+	{
+		template<typename V>
+		GLM_FUNC_QUALIFIER V fract_lanes(V x)
+		{
+			return lanes<V>::sub(x, lanes<V>::floor(x));
+		}
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER V mod_lanes(V x, float y)
+		{
+			typedef lanes<V> W;
+			return W::sub(x, W::mul(W::set1(y), W::floor(W::div(x, W::set1(y)))));
+		}
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER V mod289_lanes(V x)
+		{
+			typedef lanes<V> W;
+			return W::sub(x, W::mul(W::floor(W::mul(x, W::set1(1.0f / 289.0f))), W::set1(289.0f)));
+		}
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER V permute_lanes(V x)
+		{
+			typedef lanes<V> W;
+			return mod289_lanes(W::mul(W::add(W::mul(x, W::set1(34.0f)), W::set1(1.0f)), x));
+		}
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER V taylorInvSqrt_lanes(V r)
+		{
+			typedef lanes<V> W;
+			return W::sub(W::set1(1.79284291400159f), W::mul(W::set1(0.85373472095314f), r));
+		}
+
+		// step(edge, x)
+		template<typename V>
+		GLM_FUNC_QUALIFIER V step_lanes(V edge, V x)
+		{
+			typedef lanes<V> W;
+			return W::select(W::lt(x, edge), W::set1(0.0f), W::set1(1.0f));
+		}
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER V clamp01_lanes(V x)
+		{
+			typedef lanes<V> W;
+			return W::min(W::max(x, W::set1(0.0f)), W::set1(1.0f));
+		}
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER V dot_lanes(V ax, V ay, V bx, V by)
+		{
+			typedef lanes<V> W;
+			return W::add(W::mul(ax, bx), W::mul(ay, by));
+		}
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER V dot_lanes(V ax, V ay, V az, V bx, V by, V bz)
+		{
+			typedef lanes<V> W;
+			return W::add(W::add(W::mul(ax, bx), W::mul(ay, by)), W::mul(az, bz));
+		}
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER V dot_lanes(V ax, V ay, V az, V aw, V bx, V by, V bz, V bw)
+		{
+			typedef lanes<V> W;
+			return W::add(W::add(W::mul(ax, bx), W::mul(ay, by)), W::add(W::mul(az, bz), W::mul(aw, bw)));
+		}
+
+		// Gradient of one lattice corner dotted with the offset (fx, fy) to it
+		template<typename V>
+		GLM_FUNC_QUALIFIER V perlin_corner_lanes(V ix, V iy, V fx, V fy)
+		{
+			typedef lanes<V> W;
+
+			V const i = permute_lanes(W::add(permute_lanes(ix), iy));
+			V gx = W::sub(W::mul(W::set1(2.0f), fract_lanes(W::div(i, W::set1(41.0f)))), W::set1(1.0f));
+			V const gy = W::sub(W::abs(gx), W::set1(0.5f));
+			gx = W::sub(gx, W::floor(W::add(gx, W::set1(0.5f))));
+
+			V const norm = taylorInvSqrt_lanes(dot_lanes(gx, gy, gx, gy));
+			return dot_lanes(W::mul(gx, norm), W::mul(gy, norm), fx, fy);
+		}
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER V fade_lanes(V t)
+		{
+			typedef lanes<V> W;
+			return W::mul(W::mul(W::mul(t, t), t), W::add(W::mul(t, W::sub(W::mul(t, W::set1(6.0f)), W::set1(15.0f))), W::set1(10.0f)));
+		}
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER V mix_lanes(V x, V y, V a)
+		{
+			typedef lanes<V> W;
+			return W::add(W::mul(x, W::sub(W::set1(1.0f), a)), W::mul(y, a));
+		}
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER V perlin_lanes(V x, V y)
+		{
+			typedef lanes<V> W;
+
+			V const one = W::set1(1.0f);
+			V const fx0 = fract_lanes(x);
+			V const fy0 = fract_lanes(y);
+			V const fx1 = W::sub(fx0, one);
+			V const fy1 = W::sub(fy0, one);
+			V const ix0 = mod_lanes(W::floor(x), 289.0f);
+			V const iy0 = mod_lanes(W::floor(y), 289.0f);
+			V const ix1 = mod_lanes(W::add(W::floor(x), one), 289.0f);
+			V const iy1 = mod_lanes(W::add(W::floor(y), one), 289.0f);
+
+			V const n00 = perlin_corner_lanes(ix0, iy0, fx0, fy0);
+			V const n10 = perlin_corner_lanes(ix1, iy0, fx1, fy0);
+			V const n01 = perlin_corner_lanes(ix0, iy1, fx0, fy1);
+			V const n11 = perlin_corner_lanes(ix1, iy1, fx1, fy1);
+
+			V const fadeX = fade_lanes(fx0);
+			V const fadeY = fade_lanes(fy0);
+			return W::mul(W::set1(2.3f), mix_lanes(mix_lanes(n00, n10, fadeX), mix_lanes(n01, n11, fadeX), fadeY));
+		}
+
+		// Contribution of the corner at lattice offset (ox, oy), with (x, y) the position relative to it
+		template<typename V>
+		GLM_FUNC_QUALIFIER V simplex_corner_lanes(V ix, V iy, V ox, V oy, V x, V y)
+		{
+			typedef lanes<V> W;
+
+			V const p = permute_lanes(W::add(W::add(permute_lanes(W::add(iy, oy)), ix), ox));
+
+			V m = W::max(W::sub(W::set1(0.5f), dot_lanes(x, y, x, y)), W::set1(0.0f));
+			m = W::mul(m, m);
+			m = W::mul(m, m);
+
+			// Gradients: 41 points uniformly over a line, mapped onto a diamond.
+			V const gx = W::sub(W::mul(W::set1(2.0f), fract_lanes(W::mul(p, W::set1(0.024390243902439f)))), W::set1(1.0f));
+			V const h = W::sub(W::abs(gx), W::set1(0.5f));
+			V const a0 = W::sub(gx, W::floor(W::add(gx, W::set1(0.5f))));
+
+			m = W::mul(m, W::sub(W::set1(1.79284291400159f), W::mul(W::set1(0.85373472095314f), W::add(W::mul(a0, a0), W::mul(h, h)))));
+			return W::mul(m, W::add(W::mul(a0, x), W::mul(h, y)));
+		}
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER V simplex_lanes(V vx, V vy)
+		{
+			typedef lanes<V> W;
+
+			float const C0 = 0.211324865405187f;
+			float const C1 = 0.366025403784439f;
+			float const C2 = -0.577350269189626f;
+			V const zero = W::set1(0.0f);
+			V const one = W::set1(1.0f);
+
+			// First corner
+			V const s = dot_lanes(vx, vy, W::set1(C1), W::set1(C1));
+			V const ix = W::floor(W::add(vx, s));
+			V const iy = W::floor(W::add(vy, s));
+			V const t = dot_lanes(ix, iy, W::set1(C0), W::set1(C0));
+			V const x0 = W::add(W::sub(vx, ix), t);
+			V const y0 = W::add(W::sub(vy, iy), t);
+
+			// Other corners
+			V const i1x = W::select(W::gt(x0, y0), one, zero);
+			V const i1y = W::sub(one, i1x);
+			V const x1 = W::sub(W::add(x0, W::set1(C0)), i1x);
+			V const y1 = W::sub(W::add(y0, W::set1(C0)), i1y);
+			V const x2 = W::add(x0, W::set1(C2));
+			V const y2 = W::add(y0, W::set1(C2));
+
+			// Permutations
+			V const px = mod_lanes(ix, 289.0f);
+			V const py = mod_lanes(iy, 289.0f);
+			V const n0 = simplex_corner_lanes(px, py, zero, zero, x0, y0);
+			V const n1 = simplex_corner_lanes(px, py, i1x, i1y, x1, y1);
+			V const n2 = simplex_corner_lanes(px, py, one, one, x2, y2);
+			return W::mul(W::set1(130.0f), W::add(W::add(n0, n1), n2));
+		}
+
+		// Contribution of the corner at lattice offset (ox, oy, oz), with (x, y, z) the position relative to it
+		template<typename V>
+		GLM_FUNC_QUALIFIER V simplex_corner_lanes(V ix, V iy, V iz, V ox, V oy, V oz, V x, V y, V z)
+		{
+			typedef lanes<V> W;
+
+			V const zero = W::set1(0.0f);
+			V const one = W::set1(1.0f);
+			V const p = permute_lanes(W::add(W::add(permute_lanes(W::add(W::add(permute_lanes(W::add(iz, oz)), iy), oy)), ix), ox));
+
+			// Gradients: 7x7 points over a square, mapped onto an octahedron.
+			float const n_ = 0.142857142857f;
+			V const nsx = W::set1(n_ * 2.0f);
+			V const nsy = W::set1(n_ * 0.5f - 1.0f);
+			V const nsz = W::set1(n_);
+
+			V const j = W::sub(p, W::mul(W::set1(49.0f), W::floor(W::mul(W::mul(p, nsz), nsz))));
+			V const x_ = W::floor(W::mul(j, nsz));
+			V const y_ = W::floor(W::sub(j, W::mul(W::set1(7.0f), x_)));
+			V const gx = W::add(W::mul(x_, nsx), nsy);
+			V const gy = W::add(W::mul(y_, nsx), nsy);
+			V const h = W::sub(W::sub(one, W::abs(gx)), W::abs(gy));
+
+			V const sh = W::sub(zero, step_lanes(h, zero));
+			V const px = W::add(gx, W::mul(W::add(W::mul(W::floor(gx), W::set1(2.0f)), one), sh));
+			V const py = W::add(gy, W::mul(W::add(W::mul(W::floor(gy), W::set1(2.0f)), one), sh));
+			V const norm = taylorInvSqrt_lanes(dot_lanes(px, py, h, px, py, h));
+
+			V m = W::max(W::sub(W::set1(0.6f), dot_lanes(x, y, z, x, y, z)), zero);
+			m = W::mul(m, m);
+			return W::mul(W::mul(m, m), dot_lanes(W::mul(px, norm), W::mul(py, norm), W::mul(h, norm), x, y, z));
+		}
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER V simplex_lanes(V vx, V vy, V vz)
+		{
+			typedef lanes<V> W;
+
+			float const Cx = static_cast<float>(1.0 / 6.0);
+			float const Cy = static_cast<float>(1.0 / 3.0);
+			V const zero = W::set1(0.0f);
+			V const one = W::set1(1.0f);
+
+			// First corner
+			V const s = dot_lanes(vx, vy, vz, W::set1(Cy), W::set1(Cy), W::set1(Cy));
+			V const ix = W::floor(W::add(vx, s));
+			V const iy = W::floor(W::add(vy, s));
+			V const iz = W::floor(W::add(vz, s));
+			V const t = dot_lanes(ix, iy, iz, W::set1(Cx), W::set1(Cx), W::set1(Cx));
+			V const x0 = W::add(W::sub(vx, ix), t);
+			V const y0 = W::add(W::sub(vy, iy), t);
+			V const z0 = W::add(W::sub(vz, iz), t);
+
+			// Other corners
+			V const gx = step_lanes(y0, x0);
+			V const gy = step_lanes(z0, y0);
+			V const gz = step_lanes(x0, z0);
+			V const lx = W::sub(one, gx);
+			V const ly = W::sub(one, gy);
+			V const lz = W::sub(one, gz);
+			V const i1x = W::min(gx, lz);
+			V const i1y = W::min(gy, lx);
+			V const i1z = W::min(gz, ly);
+			V const i2x = W::max(gx, lz);
+			V const i2y = W::max(gy, lx);
+			V const i2z = W::max(gz, ly);
+
+			// Permutations
+			V const px = mod289_lanes(ix);
+			V const py = mod289_lanes(iy);
+			V const pz = mod289_lanes(iz);
+			V const n0 = simplex_corner_lanes(px, py, pz, zero, zero, zero, x0, y0, z0);
+			V const n1 = simplex_corner_lanes(px, py, pz, i1x, i1y, i1z,
+				W::add(W::sub(x0, i1x), W::set1(Cx)), W::add(W::sub(y0, i1y), W::set1(Cx)), W::add(W::sub(z0, i1z), W::set1(Cx)));
+			V const n2 = simplex_corner_lanes(px, py, pz, i2x, i2y, i2z,
+				W::add(W::sub(x0, i2x), W::set1(Cy)), W::add(W::sub(y0, i2y), W::set1(Cy)), W::add(W::sub(z0, i2z), W::set1(Cy)));
+			V const n3 = simplex_corner_lanes(px, py, pz, one, one, one,
+				W::sub(x0, W::set1(0.5f)), W::sub(y0, W::set1(0.5f)), W::sub(z0, W::set1(0.5f)));
+			return W::mul(W::set1(42.0f), W::add(W::add(n0, n1), W::add(n2, n3)));
+		}
+
+		// Gradient of one corner from its hash j, as gtc::grad4, scaled to unit length
+		// and dotted with the position (x, y, z, w) relative to the corner.
+		template<typename V>
+		GLM_FUNC_QUALIFIER V simplex_corner_lanes(V j, V x, V y, V z, V w)
+		{
+			typedef lanes<V> W;
+
+			V const zero = W::set1(0.0f);
+			V const one = W::set1(1.0f);
+			V const seven = W::set1(7.0f);
+			V const ipz = W::set1(1.0f / 7.0f);
+
+			V gx = W::sub(W::mul(W::floor(W::mul(fract_lanes(W::mul(j, W::set1(1.0f / 294.0f))), seven)), ipz), one);
+			V gy = W::sub(W::mul(W::floor(W::mul(fract_lanes(W::mul(j, W::set1(1.0f / 49.0f))), seven)), ipz), one);
+			V gz = W::sub(W::mul(W::floor(W::mul(fract_lanes(W::mul(j, ipz)), seven)), ipz), one);
+			V const gw = W::sub(W::set1(1.5f), W::add(W::add(W::abs(gx), W::abs(gy)), W::abs(gz)));
+
+			V const sw = W::select(W::lt(gw, zero), one, zero);
+			gx = W::add(gx, W::mul(W::sub(W::mul(W::select(W::lt(gx, zero), one, zero), W::set1(2.0f)), one), sw));
+			gy = W::add(gy, W::mul(W::sub(W::mul(W::select(W::lt(gy, zero), one, zero), W::set1(2.0f)), one), sw));
+			gz = W::add(gz, W::mul(W::sub(W::mul(W::select(W::lt(gz, zero), one, zero), W::set1(2.0f)), one), sw));
+
+			V const norm = taylorInvSqrt_lanes(dot_lanes(gx, gy, gz, gw, gx, gy, gz, gw));
+
+			V m = W::max(W::sub(W::set1(0.6f), dot_lanes(x, y, z, w, x, y, z, w)), zero);
+			m = W::mul(m, m);
+			return W::mul(W::mul(m, m), dot_lanes(W::mul(gx, norm), W::mul(gy, norm), W::mul(gz, norm), W::mul(gw, norm), x, y, z, w));
+		}
+
+		// Hash of the corner at lattice offset (ox, oy, oz, ow)
+		template<typename V>
+		GLM_FUNC_QUALIFIER V simplex_hash_lanes(V ix, V iy, V iz, V iw, V ox, V oy, V oz, V ow)
+		{
+			typedef lanes<V> W;
+
+			V j = permute_lanes(W::add(iw, ow));
+			j = permute_lanes(W::add(W::add(j, iz), oz));
+			j = permute_lanes(W::add(W::add(j, iy), oy));
+			return permute_lanes(W::add(W::add(j, ix), ox));
+		}
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER V simplex_lanes(V vx, V vy, V vz, V vw)
+		{
+			typedef lanes<V> W;
+
+			V const G4 = W::set1(0.138196601125011f);
+			V const G4x2 = W::set1(0.276393202250021f);
+			V const G4x3 = W::set1(0.414589803375032f);
+			V const G4x4m1 = W::set1(-0.447213595499958f);
+			V const F4 = W::set1(0.309016994374947451f);
+			V const zero = W::set1(0.0f);
+			V const one = W::set1(1.0f);
+			V const two = W::set1(2.0f);
+
+			// First corner
+			V const s = dot_lanes(vx, vy, vz, vw, F4, F4, F4, F4);
+			V const ix = W::floor(W::add(vx, s));
+			V const iy = W::floor(W::add(vy, s));
+			V const iz = W::floor(W::add(vz, s));
+			V const iw = W::floor(W::add(vw, s));
+			V const t = dot_lanes(ix, iy, iz, iw, G4, G4, G4, G4);
+			V const x0 = W::add(W::sub(vx, ix), t);
+			V const y0 = W::add(W::sub(vy, iy), t);
+			V const z0 = W::add(W::sub(vz, iz), t);
+			V const w0 = W::add(W::sub(vw, iw), t);
+
+			// Rank sorting; rank holds 0, 1, 2, 3 once across the four components
+			V const isX0 = step_lanes(y0, x0);
+			V const isX1 = step_lanes(z0, x0);
+			V const isX2 = step_lanes(w0, x0);
+			V const isYZ0 = step_lanes(z0, y0);
+			V const isYZ1 = step_lanes(w0, y0);
+			V const isYZ2 = step_lanes(w0, z0);
+			V const rankX = W::add(W::add(isX0, isX1), isX2);
+			V const rankY = W::add(W::sub(one, isX0), W::add(isYZ0, isYZ1));
+			V const rankZ = W::add(W::add(W::sub(one, isX1), W::sub(one, isYZ0)), isYZ2);
+			V const rankW = W::add(W::add(W::sub(one, isX2), W::sub(one, isYZ1)), W::sub(one, isYZ2));
+
+			V const i1x = clamp01_lanes(W::sub(rankX, two)), i1y = clamp01_lanes(W::sub(rankY, two));
+			V const i1z = clamp01_lanes(W::sub(rankZ, two)), i1w = clamp01_lanes(W::sub(rankW, two));
+			V const i2x = clamp01_lanes(W::sub(rankX, one)), i2y = clamp01_lanes(W::sub(rankY, one));
+			V const i2z = clamp01_lanes(W::sub(rankZ, one)), i2w = clamp01_lanes(W::sub(rankW, one));
+			V const i3x = clamp01_lanes(rankX), i3y = clamp01_lanes(rankY);
+			V const i3z = clamp01_lanes(rankZ), i3w = clamp01_lanes(rankW);
+
+			// Permutations
+			V const px = mod_lanes(ix, 289.0f);
+			V const py = mod_lanes(iy, 289.0f);
+			V const pz = mod_lanes(iz, 289.0f);
+			V const pw = mod_lanes(iw, 289.0f);
+
+			V const n0 = simplex_corner_lanes(simplex_hash_lanes(px, py, pz, pw, zero, zero, zero, zero), x0, y0, z0, w0);
+			V const n1 = simplex_corner_lanes(simplex_hash_lanes(px, py, pz, pw, i1x, i1y, i1z, i1w),
+				W::add(W::sub(x0, i1x), G4), W::add(W::sub(y0, i1y), G4), W::add(W::sub(z0, i1z), G4), W::add(W::sub(w0, i1w), G4));
+			V const n2 = simplex_corner_lanes(simplex_hash_lanes(px, py, pz, pw, i2x, i2y, i2z, i2w),
+				W::add(W::sub(x0, i2x), G4x2), W::add(W::sub(y0, i2y), G4x2), W::add(W::sub(z0, i2z), G4x2), W::add(W::sub(w0, i2w), G4x2));
+			V const n3 = simplex_corner_lanes(simplex_hash_lanes(px, py, pz, pw, i3x, i3y, i3z, i3w),
+				W::add(W::sub(x0, i3x), G4x3), W::add(W::sub(y0, i3y), G4x3), W::add(W::sub(z0, i3z), G4x3), W::add(W::sub(w0, i3w), G4x3));
+			V const n4 = simplex_corner_lanes(simplex_hash_lanes(px, py, pz, pw, one, one, one, one),
+				W::add(x0, G4x4m1), W::add(y0, G4x4m1), W::add(z0, G4x4m1), W::add(w0, G4x4m1));
+			return W::mul(W::set1(49.0f), W::add(W::add(W::add(n0, n1), n2), W::add(n3, n4)));
+		}
+
+		// One lane at a time the scalar functions are used as they are: the compiler
+		// already runs their vec4 corner arithmetic four-wide.
+		template<length_t L>
+		struct noise_simplex;
+
+		template<>
+		struct noise_simplex<2>
+		{
+			template<typename V>
+			GLM_FUNC_QUALIFIER static V call(V const* v) { return simplex_lanes(v[0], v[1]); }
+			GLM_FUNC_QUALIFIER static float call(float const* v) { return simplex(vec<2, float, defaultp>(v[0], v[1])); }
+		};
+
+		template<>
+		struct noise_simplex<3>
+		{
+			template<typename V>
+			GLM_FUNC_QUALIFIER static V call(V const* v) { return simplex_lanes(v[0], v[1], v[2]); }
+			GLM_FUNC_QUALIFIER static float call(float const* v) { return simplex(vec<3, float, defaultp>(v[0], v[1], v[2])); }
+		};
+
+		template<>
+		struct noise_simplex<4>
+		{
+			template<typename V>
+			GLM_FUNC_QUALIFIER static V call(V const* v) { return simplex_lanes(v[0], v[1], v[2], v[3]); }
+			GLM_FUNC_QUALIFIER static float call(float const* v) { return simplex(vec<4, float, defaultp>(v[0], v[1], v[2], v[3])); }
+		};
+
+		template<length_t L>
+		struct noise_perlin;
+
+		template<>
+		struct noise_perlin<2>
+		{
+			template<typename V>
+			GLM_FUNC_QUALIFIER static V call(V const* v) { return perlin_lanes(v[0], v[1]); }
+			GLM_FUNC_QUALIFIER static float call(float const* v) { return perlin(vec<2, float, defaultp>(v[0], v[1])); }
+		};
+
+		// Octave k samples at lacunarity^k times the frequency with weight gain^k;
+		// the sum is divided by the total weight to stay in [-1, 1].
+		template<typename Noise, length_t L, typename V>
+		GLM_FUNC_QUALIFIER V fbm_lanes(V const* v, int octaves, float lacunarity, float gain)
+		{
+			typedef lanes<V> W;
+
+			V sum = Noise::call(v);
+			if(octaves <= 1)
+				return sum;
+
+			float frequency = 1.0f;
+			float amplitude = 1.0f;
+			float total = 1.0f;
+			for(int k = 1; k < octaves; ++k)
+			{
+				frequency *= lacunarity;
+				amplitude *= gain;
+				total += amplitude;
+
+				V scaled[L];
+				for(length_t c = 0; c < L; ++c)
+					scaled[c] = W::mul(v[c], W::set1(frequency));
+				sum = W::add(sum, W::mul(W::set1(amplitude), Noise::call(scaled)));
+			}
+			return W::mul(sum, W::set1(1.0f / total));
+		}
+
+		template<typename Noise, length_t L, qualifier Q>
+		GLM_FUNC_QUALIFIER void noise_points(vec<L, float, Q> const* p, float* out, std::size_t count, int octaves, float lacunarity, float gain)
+		{
+			typedef widest_lanes W;
+			std::size_t const width = W::width;
+
+			// Deinterleaved a block at a time; a short last block is padded with zeros
+			float in[L][W::width];
+			float result[W::width];
+			for(std::size_t first = 0; first < count; first += width)
+			{
+				std::size_t const n = count - first < width ? count - first : width;
+				for(std::size_t k = 0; k < width; ++k)
+				for(length_t c = 0; c < L; ++c)
+					in[c][k] = k < n ? p[first + k][c] : 0.0f;
+
+				typename W::type v[L];
+				for(length_t c = 0; c < L; ++c)
+					v[c] = W::load(in[c]);
+
+				W::store(result, fbm_lanes<Noise, L>(v, octaves, lacunarity, gain));
+				for(std::size_t k = 0; k < n; ++k)
+					out[first + k] = result[k];
+			}
+		}
+
+		// Rows [firstRow, lastRow) of a grid over the plane through origin spanned by x and y
+		template<typename Noise, length_t L>
+		GLM_FUNC_QUALIFIER void noise_grid(float const* origin, float stepX, float stepY, std::size_t width, std::size_t firstRow, std::size_t lastRow, float* out, int octaves, float lacunarity, float gain)
+		{
+			typedef widest_lanes W;
+			std::size_t const lanesWidth = W::width;
+
+			float xs[W::width];
+			float result[W::width];
+			typename W::type v[L];
+			for(length_t c = 2; c < L; ++c)
+				v[c] = W::set1(origin[c]);
+
+			for(std::size_t y = firstRow; y < lastRow; ++y)
+			{
+				float* row = out + y * width;
+				v[1] = W::set1(origin[1] + static_cast<float>(y) * stepY);
+
+				for(std::size_t first = 0; first < width; first += lanesWidth)
+				{
+					for(std::size_t k = 0; k < lanesWidth; ++k)
+						xs[k] = origin[0] + static_cast<float>(first + k) * stepX;
+					v[0] = W::load(xs);
+
+					std::size_t const n = width - first < lanesWidth ? width - first : lanesWidth;
+					if(n == lanesWidth)
+						W::store(row + first, fbm_lanes<Noise, L>(v, octaves, lacunarity, gain));
+					else
+					{
+						W::store(result, fbm_lanes<Noise, L>(v, octaves, lacunarity, gain));
+						for(std::size_t k = 0; k < n; ++k)
+							row[first + k] = result[k];
+					}
+				}
+			}
+		}
+	}//namespace detail
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void perlin(vec<2, float, Q> const* p, float* out, std::size_t count)
+	{
+		detail::noise_points<detail::noise_perlin<2> >(p, out, count, 1, 2.0f, 0.5f);
+	}
+
+	template<length_t L, qualifier Q>
+	GLM_FUNC_QUALIFIER void simplex(vec<L, float, Q> const* p, float* out, std::size_t count)
+	{
+		detail::noise_points<detail::noise_simplex<L> >(p, out, count, 1, 2.0f, 0.5f);
+	}
+
+	template<length_t L, qualifier Q>
+	GLM_FUNC_QUALIFIER void simplexFbm(vec<L, float, Q> const* p, float* out, std::size_t count, int octaves, float lacunarity, float gain)
+	{
+		detail::noise_points<detail::noise_simplex<L> >(p, out, count, octaves, lacunarity, gain);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void simplexGrid(vec<2, float, Q> const& origin, vec<2, float, Q> const& step, std::size_t width, std::size_t firstRow, std::size_t lastRow, float* out, int octaves, float lacunarity, float gain)
+	{
+		float const o[2] = {origin.x, origin.y};
+		detail::noise_grid<detail::noise_simplex<2>, 2>(o, step.x, step.y, width, firstRow, lastRow, out, octaves, lacunarity, gain);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void simplexGrid(vec<3, float, Q> const& origin, vec<2, float, Q> const& step, std::size_t width, std::size_t firstRow, std::size_t lastRow, float* out, int octaves, float lacunarity, float gain)
+	{
+		float const o[3] = {origin.x, origin.y, origin.z};
+		detail::noise_grid<detail::noise_simplex<3>, 3>(o, step.x, step.y, width, firstRow, lastRow, out, octaves, lacunarity, gain);
+	}
 }//namespace glm
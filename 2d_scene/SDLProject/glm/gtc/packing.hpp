@@ -15,6 +15,7 @@
 
 // Dependency:
 #include "type_precision.hpp"
+#include <cstddef>
 
 #if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
 #	pragma message("GLM: GLM_GTC_packing extension included")
@@ -721,6 +722,39 @@ namespace glm
 	/// @see int packUint2x16(u32vec2 const& v)
 	GLM_FUNC_DECL u32vec2 unpackUint2x32(uint64 p);
 
+	/// Convert count floats into half-precision floats, as packHalf1x16 does for one.
+	/// With SSE2 the results are identical to packHalf1x16; when F16C is enabled
+	/// blocks of 8 use the hardware conversion, which rounds ties to even and quiets NaNs.
+	///
+	/// @see gtc_packing
+	/// @see uint16 packHalf1x16(float const& v)
+	GLM_FUNC_DECL void packHalf1x16(float const* v, uint16* p, std::size_t count);
+
+	/// Convert count half-precision floats into floats, as unpackHalf1x16 does for one.
+	/// Exact for every value; only NaN payloads may differ, as F16C quiets signaling NaNs.
+	///
+	/// @see gtc_packing
+	/// @see float unpackHalf1x16(uint16 const& v)
+	GLM_FUNC_DECL void unpackHalf1x16(uint16 const* p, float* v, std::size_t count);
+
+	/// Convert count normalized floats into 16-bit unsigned integers, as packUnorm1x16 does for one.
+	///
+	/// @see gtc_packing
+	/// @see uint16 packUnorm1x16(float const& v)
+	GLM_FUNC_DECL void packUnorm1x16(float const* v, uint16* p, std::size_t count);
+
+	/// Convert count normalized floats into 16-bit signed integers, as packSnorm1x16 does for one.
+	///
+	/// @see gtc_packing
+	/// @see uint16 packSnorm1x16(float const& v)
+	GLM_FUNC_DECL void packSnorm1x16(float const* v, uint16* p, std::size_t count);
+
+	/// Convert count normalized floats into 8-bit unsigned integers, as packUnorm1x8 does for one.
+	///
+	/// @see gtc_packing
+	/// @see uint8 packUnorm1x8(float const& v)
+	GLM_FUNC_DECL void packUnorm1x8(float const* v, uint8* p, std::size_t count);
+
 
 	/// @}
 }// namespace glm
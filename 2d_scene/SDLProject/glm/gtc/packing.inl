@@ -936,3 +936,65 @@ namespace detail
 	}
 }//namespace glm
 
+#if GLM_CONFIG_SIMD == GLM_ENABLE
+#	include "packing_simd.inl"
+#endif
+
+namespace glm
+{
+	// Arrays: blocks of 8 from packing_simd.inl when SSE2 is enabled, the scalar functions for the rest
+	GLM_FUNC_QUALIFIER void packHalf1x16(float const* v, uint16* p, std::size_t count)
+	{
+		std::size_t i = 0;
+#		if GLM_CONFIG_SIMD == GLM_ENABLE && (GLM_ARCH & GLM_ARCH_SSE2_BIT)
+			for(std::size_t body = count - count % 8; i < body; i += 8)
+				detail::packHalf8(v + i, p + i);
+#		endif
+		for(; i < count; ++i)
+			p[i] = packHalf1x16(v[i]);
+	}
+
+	GLM_FUNC_QUALIFIER void unpackHalf1x16(uint16 const* p, float* v, std::size_t count)
+	{
+		std::size_t i = 0;
+#		if GLM_CONFIG_SIMD == GLM_ENABLE && (GLM_ARCH & GLM_ARCH_SSE2_BIT)
+			for(std::size_t body = count - count % 8; i < body; i += 8)
+				detail::unpackHalf8(p + i, v + i);
+#		endif
+		for(; i < count; ++i)
+			v[i] = unpackHalf1x16(p[i]);
+	}
+
+	GLM_FUNC_QUALIFIER void packUnorm1x16(float const* v, uint16* p, std::size_t count)
+	{
+		std::size_t i = 0;
+#		if GLM_CONFIG_SIMD == GLM_ENABLE && (GLM_ARCH & GLM_ARCH_SSE2_BIT)
+			for(std::size_t body = count - count % 8; i < body; i += 8)
+				detail::packUnorm1x16_8(v + i, p + i);
+#		endif
+		for(; i < count; ++i)
+			p[i] = packUnorm1x16(v[i]);
+	}
+
+	GLM_FUNC_QUALIFIER void packSnorm1x16(float const* v, uint16* p, std::size_t count)
+	{
+		std::size_t i = 0;
+#		if GLM_CONFIG_SIMD == GLM_ENABLE && (GLM_ARCH & GLM_ARCH_SSE2_BIT)
+			for(std::size_t body = count - count % 8; i < body; i += 8)
+				detail::packSnorm1x16_8(v + i, p + i);
+#		endif
+		for(; i < count; ++i)
+			p[i] = packSnorm1x16(v[i]);
+	}
+
+	GLM_FUNC_QUALIFIER void packUnorm1x8(float const* v, uint8* p, std::size_t count)
+	{
+		std::size_t i = 0;
+#		if GLM_CONFIG_SIMD == GLM_ENABLE && (GLM_ARCH & GLM_ARCH_SSE2_BIT)
+			for(std::size_t body = count - count % 8; i < body; i += 8)
+				detail::packUnorm1x8_8(v + i, p + i);
+#		endif
+		for(; i < count; ++i)
+			p[i] = packUnorm1x8(v[i]);
+	}
+}//namespace glm
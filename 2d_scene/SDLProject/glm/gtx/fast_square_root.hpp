@@ -18,6 +18,9 @@
 #include "../common.hpp"
 #include "../exponential.hpp"
 #include "../geometric.hpp"
+#include "../detail/_lanes.hpp"
+#include <cstddef>
+#include <limits>
 
 #if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
 #	ifndef GLM_ENABLE_EXPERIMENTAL
@@ -86,6 +89,21 @@ namespace glm
 	template<typename genType>
 	GLM_FUNC_DECL genType fastNormalize(genType const& x);
 
+	/// 1 / sqrt(in[i]) for count values, 8 or 4 at a time with AVX or SSE2:
+	/// the hardware estimate refined by one Newton-Raphson step, at most 4 ULP
+	/// for normal positive input (2 ULP without SIMD, where the step refines an
+	/// exact 1 / sqrt). 0 gives +inf and +inf gives 0. out may alias in.
+	///
+	/// @see gtx_fast_square_root extension.
+	GLM_FUNC_DECL void fastInverseSqrt(float const* in, float* out, std::size_t count);
+
+	/// Normalizes count vectors with the array fastInverseSqrt; out may alias in.
+	/// A zero vector gives NaN components, as with normalize.
+	///
+	/// @see gtx_fast_square_root extension.
+	template<length_t L, qualifier Q>
+	GLM_FUNC_DECL void fastNormalize(vec<L, float, Q> const* in, vec<L, float, Q>* out, std::size_t count);
+
 	/// @}
 }// namespace glm
 
@@ -77,4 +77,59 @@ namespace glm
 	{
 		return x * fastInverseSqrt(dot(x, x));
 	}
+
+	// Arrays
+	namespace detail
+	{
+		template<typename V>
+		GLM_FUNC_QUALIFIER V inversesqrt_lanes(V x)
+		{
+			typedef lanes<V> W;
+
+			// y1 = y0 * (1.5 - 0.5 * x * y0 * y0). The step only holds for a finite, nonzero estimate:
+			// 0, subnormals (read as 0 by rsqrt), inf, negatives and NaN keep y0 instead of turning
+			// into -inf or NaN.
+			V const y0 = W::rsqrt(x);
+			V const h = W::mul(W::mul(W::set1(0.5f), x), y0);
+			V const y1 = W::mul(y0, W::fma(W::set1(-1.0f), W::mul(h, y0), W::set1(1.5f)));
+			return W::select(W::both(W::gt(y0, W::set1(0.0f)), W::lt(y0, W::set1(std::numeric_limits<float>::infinity()))), y1, y0);
+		}
+
+		// lanes<float>::rsqrt is already exact, so the scalar build and the vector tails skip the step
+		GLM_FUNC_QUALIFIER float inversesqrt_lanes(float x)
+		{
+			return 1.0f / std::sqrt(x);
+		}
+	}//namespace detail
+
+	GLM_FUNC_QUALIFIER void fastInverseSqrt(float const* in, float* out, std::size_t count)
+	{
+		typedef detail::widest_lanes W;
+
+		std::size_t const body = count - count % W::width;
+
+		std::size_t i = 0;
+		for(; i < body; i += W::width)
+			W::store(out + i, detail::inversesqrt_lanes(W::load(in + i)));
+		for(; i < count; ++i)
+			out[i] = detail::inversesqrt_lanes(in[i]);
+	}
+
+	template<length_t L, qualifier Q>
+	GLM_FUNC_QUALIFIER void fastNormalize(vec<L, float, Q> const* in, vec<L, float, Q>* out, std::size_t count)
+	{
+		// Squared lengths in blocks small enough to stay on the stack and in L1
+		float scale[64];
+
+		for(std::size_t first = 0; first < count; first += 64)
+		{
+			std::size_t const n = count - first < 64 ? count - first : 64;
+
+			for(std::size_t i = 0; i < n; ++i)
+				scale[i] = dot(in[first + i], in[first + i]);
+			fastInverseSqrt(scale, scale, n);
+			for(std::size_t i = 0; i < n; ++i)
+				out[first + i] = in[first + i] * scale[i];
+		}
+	}
 }//namespace glm
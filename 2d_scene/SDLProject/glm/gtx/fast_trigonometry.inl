@@ -25,6 +25,67 @@ namespace detail
 	{
 		return detail::functor1<vec, L, T, T, Q>::call(cos_52s, x);
 	}
+
+	// x = r + j * pi/2 with |r| <= pi/4; pi/2 is split in three so the first
+	// products are exact. sin and cos of r use the Cephes single-precision
+	// minimax polynomials, and j mod 4 picks and signs the results.
+	template<typename V>
+	GLM_FUNC_QUALIFIER void sincos_lanes(V x, V& s, V& c)
+	{
+		typedef lanes<V> W;
+		typedef typename W::mask M;
+
+		V const j = W::round(W::mul(x, W::set1(0.636619772367581343f)));
+		V r = W::fma(j, W::set1(-1.5703125f), x);
+		r = W::fma(j, W::set1(-4.837512969970703125e-4f), r);
+		r = W::fma(j, W::set1(-7.54978995489188216e-8f), r);
+		V const z = W::mul(r, r);
+
+		V ps = W::fma(W::set1(-1.9515295891e-4f), z, W::set1(8.3321608736e-3f));
+		ps = W::fma(ps, z, W::set1(-1.6666654611e-1f));
+		ps = W::fma(W::mul(ps, z), r, r);
+
+		V pc = W::fma(W::set1(2.443315711809948e-5f), z, W::set1(-1.388731625493765e-3f));
+		pc = W::fma(pc, z, W::set1(4.166664568298827e-2f));
+		pc = W::fma(W::mul(pc, z), z, W::fma(z, W::set1(-0.5f), W::set1(1.0f)));
+
+		// Quadrant in {0, 1, 2, 3}; the offsets keep both roundings away from ties.
+		V const q = W::sub(j, W::mul(W::set1(4.0f), W::round(W::fma(j, W::set1(0.25f), W::set1(-0.375f)))));
+		V const odd = W::sub(q, W::mul(W::set1(2.0f), W::round(W::fma(q, W::set1(0.5f), W::set1(-0.25f)))));
+		M const swap = W::gt(odd, W::set1(0.5f));
+
+		s = W::negate_if(W::gt(q, W::set1(1.5f)), W::select(swap, pc, ps));
+		c = W::negate_if(W::both(W::gt(q, W::set1(0.5f)), W::lt(q, W::set1(2.5f))), W::select(swap, ps, pc));
+	}
+
+	// Folds to atan(t) with |t| <= tan(pi/8), then unfolds by octant.
+	template<typename V>
+	GLM_FUNC_QUALIFIER V atan2_lanes(V y, V x)
+	{
+		typedef lanes<V> W;
+		typedef typename W::mask M;
+
+		V const ax = W::abs(x);
+		V const ay = W::abs(y);
+		V const hi = W::max(ax, ay);
+		V const zero = W::set1(0.0f);
+		V const a = W::select(W::eq(hi, zero), zero, W::div(W::min(ax, ay), hi));
+
+		M const big = W::gt(a, W::set1(0.414213562373095f));
+		V const t = W::select(big, W::div(W::sub(a, W::set1(1.0f)), W::add(a, W::set1(1.0f))), a);
+		V const z = W::mul(t, t);
+
+		V p = W::fma(W::set1(8.05374449538e-2f), z, W::set1(-1.38776856032e-1f));
+		p = W::fma(p, z, W::set1(1.99777106478e-1f));
+		p = W::fma(p, z, W::set1(-3.33329491539e-1f));
+		V r = W::fma(W::mul(p, z), t, t);
+
+		r = W::select(big, W::add(r, W::set1(0.785398163397448310f)), r);
+		r = W::select(W::gt(ay, ax), W::sub(W::set1(1.57079632679489662f), r), r);
+		// the sign bit, not x < 0, so that x = -0 gives pi like std::atan2
+		r = W::select(W::lt(W::copysign(W::set1(1.0f), x), zero), W::sub(W::set1(3.14159265358979324f), r), r);
+		return W::copysign(r, y);
+	}
 }//namespace detail
 
 	// wrapAngle
@@ -139,4 +200,82 @@ namespace detail
 	{
 		return detail::functor1<vec, L, T, T, Q>::call(fastAtan, x);
 	}
+	// Arrays
+	GLM_FUNC_QUALIFIER void fastSinCos(float const* angles, float* sines, float* cosines, std::size_t count)
+	{
+		typedef detail::widest_lanes W;
+
+		std::size_t const body = count - count % W::width;
+
+		std::size_t i = 0;
+		for(; i < body; i += W::width)
+		{
+			W::type s, c;
+			detail::sincos_lanes(W::load(angles + i), s, c);
+			W::store(sines + i, s);
+			W::store(cosines + i, c);
+		}
+		for(; i < count; ++i)
+		{
+			float s, c;
+			detail::sincos_lanes(angles[i], s, c);
+			sines[i] = s;
+			cosines[i] = c;
+		}
+	}
+
+	GLM_FUNC_QUALIFIER void fastSin(float const* angles, float* out, std::size_t count)
+	{
+		typedef detail::widest_lanes W;
+
+		std::size_t const body = count - count % W::width;
+
+		std::size_t i = 0;
+		for(; i < body; i += W::width)
+		{
+			W::type s, c;
+			detail::sincos_lanes(W::load(angles + i), s, c);
+			W::store(out + i, s);
+		}
+		for(; i < count; ++i)
+		{
+			float s, c;
+			detail::sincos_lanes(angles[i], s, c);
+			out[i] = s;
+		}
+	}
+
+	GLM_FUNC_QUALIFIER void fastCos(float const* angles, float* out, std::size_t count)
+	{
+		typedef detail::widest_lanes W;
+
+		std::size_t const body = count - count % W::width;
+
+		std::size_t i = 0;
+		for(; i < body; i += W::width)
+		{
+			W::type s, c;
+			detail::sincos_lanes(W::load(angles + i), s, c);
+			W::store(out + i, c);
+		}
+		for(; i < count; ++i)
+		{
+			float s, c;
+			detail::sincos_lanes(angles[i], s, c);
+			out[i] = c;
+		}
+	}
+
+	GLM_FUNC_QUALIFIER void fastAtan(float const* y, float const* x, float* out, std::size_t count)
+	{
+		typedef detail::widest_lanes W;
+
+		std::size_t const body = count - count % W::width;
+
+		std::size_t i = 0;
+		for(; i < body; i += W::width)
+			W::store(out + i, detail::atan2_lanes(W::load(y + i), W::load(x + i)));
+		for(; i < count; ++i)
+			out[i] = detail::atan2_lanes(y[i], x[i]);
+	}
 }//namespace glm
@@ -10,6 +10,15 @@
 /// Include <glm/gtx/intersect.hpp> to use the features of this extension.
 ///
 /// Add intersection functions
+///
+/// The 2D batch tests sweep rays or segments against many boxes, circles or
+/// oriented boxes held in soa containers, or many rays against one shape,
+/// 8 or 4 pairs at a time with AVX or SSE2. A ray is origin + direction * t
+/// for t >= 0; a segment is the same with maxTime = 1 and direction = end - start,
+/// and a zero direction tests whether the origin is inside. Results are a hit
+/// bit per pair, bit i % 32 of hitMask[i / 32], and the time of impact: the
+/// first t in [0, maxTime] inside the shape, 0 when the origin starts inside,
+/// infinity on a miss.
 
 #pragma once
 
@@ -20,6 +29,9 @@
 #include "../geometric.hpp"
 #include "../gtx/closest_point.hpp"
 #include "../gtx/vector_query.hpp"
+#include "../detail/_lanes.hpp"
+#include "soa.hpp"
+#include <cstddef>
 
 #if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
 #	ifndef GLM_ENABLE_EXPERIMENTAL
@@ -86,6 +98,59 @@ namespace glm
 		genType & intersectionPosition1, genType & intersectionNormal1,
 		genType & intersectionPosition2 = genType(), genType & intersectionNormal2 = genType());
 
+	//! Sweeps one ray against the axis-aligned boxes [boxMin[i], boxMax[i]].
+	//! hitMask must hold (boxMin.size() + 31) / 32 words and times boxMin.size() values.
+	//! Returns the number of hits. A ray running exactly along a box edge may hit or miss.
+	//! From GLM_GTX_intersect extension.
+	template<qualifier Q>
+	GLM_FUNC_DECL std::size_t intersectRayAABB(
+		vec<2, float, Q> const& origin, vec<2, float, Q> const& direction, float maxTime,
+		soa<vec<2, float, Q> > const& boxMin, soa<vec<2, float, Q> > const& boxMax,
+		uint32* hitMask, float* times);
+
+	//! Sweeps the rays origins[i] + directions[i] * t against one axis-aligned box.
+	//! From GLM_GTX_intersect extension.
+	template<qualifier Q>
+	GLM_FUNC_DECL std::size_t intersectRayAABB(
+		soa<vec<2, float, Q> > const& origins, soa<vec<2, float, Q> > const& directions, float maxTime,
+		vec<2, float, Q> const& boxMin, vec<2, float, Q> const& boxMax,
+		uint32* hitMask, float* times);
+
+	//! Sweeps one ray against the circles of centers[i] and radii[i].
+	//! radii must point to centers.size() values.
+	//! From GLM_GTX_intersect extension.
+	template<qualifier Q>
+	GLM_FUNC_DECL std::size_t intersectRayCircle(
+		vec<2, float, Q> const& origin, vec<2, float, Q> const& direction, float maxTime,
+		soa<vec<2, float, Q> > const& centers, float const* radii,
+		uint32* hitMask, float* times);
+
+	//! Sweeps the rays origins[i] + directions[i] * t against one circle.
+	//! From GLM_GTX_intersect extension.
+	template<qualifier Q>
+	GLM_FUNC_DECL std::size_t intersectRayCircle(
+		soa<vec<2, float, Q> > const& origins, soa<vec<2, float, Q> > const& directions, float maxTime,
+		vec<2, float, Q> const& center, float radius,
+		uint32* hitMask, float* times);
+
+	//! Sweeps one ray against oriented boxes: box i is centered on centers[i], its local x axis
+	//! is the unit vector axes[i] = (cos, sin) of its rotation, and it extends halfExtents[i]
+	//! along its local axes.
+	//! From GLM_GTX_intersect extension.
+	template<qualifier Q>
+	GLM_FUNC_DECL std::size_t intersectRayOBB(
+		vec<2, float, Q> const& origin, vec<2, float, Q> const& direction, float maxTime,
+		soa<vec<2, float, Q> > const& centers, soa<vec<2, float, Q> > const& axes, soa<vec<2, float, Q> > const& halfExtents,
+		uint32* hitMask, float* times);
+
+	//! Sweeps the rays origins[i] + directions[i] * t against one oriented box.
+	//! From GLM_GTX_intersect extension.
+	template<qualifier Q>
+	GLM_FUNC_DECL std::size_t intersectRayOBB(
+		soa<vec<2, float, Q> > const& origins, soa<vec<2, float, Q> > const& directions, float maxTime,
+		vec<2, float, Q> const& center, vec<2, float, Q> const& axis, vec<2, float, Q> const& halfExtents,
+		uint32* hitMask, float* times);
+
 	/// @}
 }//namespace glm
 
@@ -194,4 +194,368 @@ namespace glm
 		intersectionNormal2 = (intersectionPoint2 - sphereCenter) / sphereRadius;
 		return true;
 	}
+
+namespace detail
+{
+	// Slab test, one ray and box per lane; inverseX and inverseY are 1 / direction.
+	template<typename V>
+	GLM_FUNC_QUALIFIER typename lanes<V>::mask intersect_ray_box_lanes(
+		V originX, V originY, V inverseX, V inverseY,
+		V minX, V minY, V maxX, V maxY, V maxTime, V& time)
+	{
+		typedef lanes<V> W;
+
+		V const x0 = W::mul(W::sub(minX, originX), inverseX);
+		V const x1 = W::mul(W::sub(maxX, originX), inverseX);
+		V const y0 = W::mul(W::sub(minY, originY), inverseY);
+		V const y1 = W::mul(W::sub(maxY, originY), inverseY);
+
+		V const enter = W::max(W::min(x0, x1), W::min(y0, y1));
+		V const leave = W::min(W::max(x0, x1), W::max(y0, y1));
+
+		// a zero direction component gives infinite times, and a box entered at infinity is a miss even for an unbounded ray
+		V const Zero = W::set1(0.0f);
+		V const lastTime = W::min(maxTime, W::set1(std::numeric_limits<float>::max()));
+		typename W::mask const hit = W::both(W::le(enter, leave), W::both(W::ge(leave, Zero), W::le(enter, lastTime)));
+		time = W::select(hit, W::max(enter, Zero), W::set1(std::numeric_limits<float>::infinity()));
+		return hit;
+	}
+
+	// One ray and circle per lane: offset is origin - center and lengthSquared is dot(direction, direction).
+	template<typename V>
+	GLM_FUNC_QUALIFIER typename lanes<V>::mask intersect_ray_circle_lanes(
+		V offsetX, V offsetY, V directionX, V directionY, V lengthSquared,
+		V radius, V maxTime, V& time)
+	{
+		typedef lanes<V> W;
+
+		// the roots of lengthSquared * t^2 + 2 * b * t + c, the smaller one being the entry
+		V const b = W::fma(offsetX, directionX, W::mul(offsetY, directionY));
+		V const c = W::sub(W::fma(offsetX, offsetX, W::mul(offsetY, offsetY)), W::mul(radius, radius));
+		V const discriminant = W::sub(W::mul(b, b), W::mul(lengthSquared, c));
+
+		// clamped, as a scalar square root of a negative number is a library call that sets errno
+		V const Zero = W::set1(0.0f);
+		V const enter = W::div(W::sub(W::sub(Zero, b), W::sqrt(W::max(discriminant, Zero))), lengthSquared);
+
+		typename W::mask const inside = W::le(c, Zero);
+		typename W::mask const crosses = W::both(W::ge(discriminant, Zero), W::both(W::ge(enter, Zero), W::le(enter, maxTime)));
+		typename W::mask const hit = W::either(inside, crosses);
+		time = W::select(inside, Zero, W::select(hit, enter, W::set1(std::numeric_limits<float>::infinity())));
+		return hit;
+	}
+
+	// One pair at a time the masks only cost: most pairs miss, and a branch skips the rest of the
+	// test for them. Same results as the register-wide versions.
+	template<>
+	GLM_FUNC_QUALIFIER lanes<float>::mask intersect_ray_box_lanes<float>(
+		float originX, float originY, float inverseX, float inverseY,
+		float minX, float minY, float maxX, float maxY, float maxTime, float& time)
+	{
+		typedef lanes<float> W;
+
+		float const x0 = (minX - originX) * inverseX;
+		float const x1 = (maxX - originX) * inverseX;
+		float const y0 = (minY - originY) * inverseY;
+		float const y1 = (maxY - originY) * inverseY;
+
+		float const enter = W::max(W::min(x0, x1), W::min(y0, y1));
+		float const leave = W::min(W::max(x0, x1), W::max(y0, y1));
+
+		time = std::numeric_limits<float>::infinity();
+		if(!(enter <= leave && leave >= 0.0f && enter <= W::min(maxTime, std::numeric_limits<float>::max())))
+			return 0u;
+
+		time = W::max(enter, 0.0f);
+		return ~0u;
+	}
+
+	template<>
+	GLM_FUNC_QUALIFIER lanes<float>::mask intersect_ray_circle_lanes<float>(
+		float offsetX, float offsetY, float directionX, float directionY, float lengthSquared,
+		float radius, float maxTime, float& time)
+	{
+		float const b = offsetX * directionX + offsetY * directionY;
+		float const c = offsetX * offsetX + offsetY * offsetY - radius * radius;
+
+		time = 0.0f;
+		if(c <= 0.0f)
+			return ~0u;
+
+		// starting outside, a ray moving away or missing the circle has no entry at t >= 0
+		time = std::numeric_limits<float>::infinity();
+		float const discriminant = b * b - lengthSquared * c;
+		if(b >= 0.0f || discriminant < 0.0f)
+			return 0u;
+
+		float const enter = (-b - std::sqrt(discriminant)) / lengthSquared;
+		if(!(enter <= maxTime))
+			return 0u;
+
+		time = enter;
+		return ~0u;
+	}
+
+	// Rotates the offset from the box center and the direction into the box frame, whose x axis is
+	// (axisX, axisY), then runs the slab test against [-halfX, halfX] x [-halfY, halfY].
+	template<typename V>
+	GLM_FUNC_QUALIFIER typename lanes<V>::mask intersect_ray_obb_lanes(
+		V offsetX, V offsetY, V directionX, V directionY,
+		V axisX, V axisY, V halfX, V halfY, V maxTime, V& time)
+	{
+		typedef lanes<V> W;
+
+		V const localOriginX = W::fma(offsetX, axisX, W::mul(offsetY, axisY));
+		V const localOriginY = W::sub(W::mul(offsetY, axisX), W::mul(offsetX, axisY));
+		V const localDirectionX = W::fma(directionX, axisX, W::mul(directionY, axisY));
+		V const localDirectionY = W::sub(W::mul(directionY, axisX), W::mul(directionX, axisY));
+
+		V const One = W::set1(1.0f);
+		V const Zero = W::set1(0.0f);
+		return intersect_ray_box_lanes<V>(
+			localOriginX, localOriginY, W::div(One, localDirectionX), W::div(One, localDirectionY),
+			W::sub(Zero, halfX), W::sub(Zero, halfY), halfX, halfY, maxTime, time);
+	}
+
+	struct intersect_ray_boxes
+	{
+		float originX, originY, inverseX, inverseY, maxTime;
+		float const* minX;
+		float const* minY;
+		float const* maxX;
+		float const* maxY;
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER typename lanes<V>::mask test(std::size_t i, V& time) const
+		{
+			typedef lanes<V> W;
+			return intersect_ray_box_lanes<V>(
+				W::set1(originX), W::set1(originY), W::set1(inverseX), W::set1(inverseY),
+				W::load(minX + i), W::load(minY + i), W::load(maxX + i), W::load(maxY + i), W::set1(maxTime), time);
+		}
+	};
+
+	struct intersect_rays_box
+	{
+		float const* originX;
+		float const* originY;
+		float const* directionX;
+		float const* directionY;
+		float minX, minY, maxX, maxY, maxTime;
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER typename lanes<V>::mask test(std::size_t i, V& time) const
+		{
+			typedef lanes<V> W;
+			V const One = W::set1(1.0f);
+			return intersect_ray_box_lanes<V>(
+				W::load(originX + i), W::load(originY + i), W::div(One, W::load(directionX + i)), W::div(One, W::load(directionY + i)),
+				W::set1(minX), W::set1(minY), W::set1(maxX), W::set1(maxY), W::set1(maxTime), time);
+		}
+	};
+
+	struct intersect_ray_circles
+	{
+		float originX, originY, directionX, directionY, lengthSquared, maxTime;
+		float const* centerX;
+		float const* centerY;
+		float const* radius;
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER typename lanes<V>::mask test(std::size_t i, V& time) const
+		{
+			typedef lanes<V> W;
+			return intersect_ray_circle_lanes<V>(
+				W::sub(W::set1(originX), W::load(centerX + i)), W::sub(W::set1(originY), W::load(centerY + i)),
+				W::set1(directionX), W::set1(directionY), W::set1(lengthSquared), W::load(radius + i), W::set1(maxTime), time);
+		}
+	};
+
+	struct intersect_rays_circle
+	{
+		float const* originX;
+		float const* originY;
+		float const* directionX;
+		float const* directionY;
+		float centerX, centerY, radius, maxTime;
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER typename lanes<V>::mask test(std::size_t i, V& time) const
+		{
+			typedef lanes<V> W;
+			V const dx = W::load(directionX + i);
+			V const dy = W::load(directionY + i);
+			return intersect_ray_circle_lanes<V>(
+				W::sub(W::load(originX + i), W::set1(centerX)), W::sub(W::load(originY + i), W::set1(centerY)),
+				dx, dy, W::fma(dx, dx, W::mul(dy, dy)), W::set1(radius), W::set1(maxTime), time);
+		}
+	};
+
+	struct intersect_ray_obbs
+	{
+		float originX, originY, directionX, directionY, maxTime;
+		float const* centerX;
+		float const* centerY;
+		float const* axisX;
+		float const* axisY;
+		float const* halfX;
+		float const* halfY;
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER typename lanes<V>::mask test(std::size_t i, V& time) const
+		{
+			typedef lanes<V> W;
+			return intersect_ray_obb_lanes<V>(
+				W::sub(W::set1(originX), W::load(centerX + i)), W::sub(W::set1(originY), W::load(centerY + i)),
+				W::set1(directionX), W::set1(directionY), W::load(axisX + i), W::load(axisY + i),
+				W::load(halfX + i), W::load(halfY + i), W::set1(maxTime), time);
+		}
+	};
+
+	struct intersect_rays_obb
+	{
+		float const* originX;
+		float const* originY;
+		float const* directionX;
+		float const* directionY;
+		float centerX, centerY, axisX, axisY, halfX, halfY, maxTime;
+
+		template<typename V>
+		GLM_FUNC_QUALIFIER typename lanes<V>::mask test(std::size_t i, V& time) const
+		{
+			typedef lanes<V> W;
+			return intersect_ray_obb_lanes<V>(
+				W::sub(W::load(originX + i), W::set1(centerX)), W::sub(W::load(originY + i), W::set1(centerY)),
+				W::load(directionX + i), W::load(directionY + i), W::set1(axisX), W::set1(axisY),
+				W::set1(halfX), W::set1(halfY), W::set1(maxTime), time);
+		}
+	};
+
+	// Runs pairs.test over count pairs, a register at a time and then one at a time. Each word of
+	// hitMask is gathered in a register and stored once, so the loop carries no dependency through
+	// memory. Returns the number of hits.
+	template<typename Pairs>
+	GLM_FUNC_QUALIFIER std::size_t intersect_batch(Pairs const& pairs, std::size_t count, uint32* hitMask, float* times)
+	{
+		typedef widest_lanes W;
+
+		std::size_t hits = 0;
+
+		for(std::size_t first = 0; first < count; first += 32)
+		{
+			std::size_t const last = count - first < 32 ? count : first + 32;
+			std::size_t const body = last - (last - first) % W::width;
+
+			uint32 word = 0;
+			std::size_t i = first;
+			for(; i < body; i += W::width)
+			{
+				W::type time;
+				word |= W::bits(pairs.template test<W::type>(i, time)) << (i - first);
+				W::store(times + i, time);
+			}
+			for(; i < last; ++i)
+				word |= lanes<float>::bits(pairs.template test<float>(i, times[i])) << (i - first);
+
+			hitMask[first / 32] = word;
+			hits += static_cast<std::size_t>(bitCount(word));
+		}
+		return hits;
+	}
+}//namespace detail
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER std::size_t intersectRayAABB
+	(
+		vec<2, float, Q> const& origin, vec<2, float, Q> const& direction, float maxTime,
+		soa<vec<2, float, Q> > const& boxMin, soa<vec<2, float, Q> > const& boxMax,
+		uint32* hitMask, float* times
+	)
+	{
+		assert(boxMin.size() == boxMax.size());
+
+		detail::intersect_ray_boxes const Pairs = {
+			origin.x, origin.y, 1.0f / direction.x, 1.0f / direction.y, maxTime,
+			boxMin.component(0), boxMin.component(1), boxMax.component(0), boxMax.component(1)};
+		return detail::intersect_batch(Pairs, boxMin.size(), hitMask, times);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER std::size_t intersectRayAABB
+	(
+		soa<vec<2, float, Q> > const& origins, soa<vec<2, float, Q> > const& directions, float maxTime,
+		vec<2, float, Q> const& boxMin, vec<2, float, Q> const& boxMax,
+		uint32* hitMask, float* times
+	)
+	{
+		assert(origins.size() == directions.size());
+
+		detail::intersect_rays_box const Pairs = {
+			origins.component(0), origins.component(1), directions.component(0), directions.component(1),
+			boxMin.x, boxMin.y, boxMax.x, boxMax.y, maxTime};
+		return detail::intersect_batch(Pairs, origins.size(), hitMask, times);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER std::size_t intersectRayCircle
+	(
+		vec<2, float, Q> const& origin, vec<2, float, Q> const& direction, float maxTime,
+		soa<vec<2, float, Q> > const& centers, float const* radii,
+		uint32* hitMask, float* times
+	)
+	{
+		detail::intersect_ray_circles const Pairs = {
+			origin.x, origin.y, direction.x, direction.y, dot(direction, direction), maxTime,
+			centers.component(0), centers.component(1), radii};
+		return detail::intersect_batch(Pairs, centers.size(), hitMask, times);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER std::size_t intersectRayCircle
+	(
+		soa<vec<2, float, Q> > const& origins, soa<vec<2, float, Q> > const& directions, float maxTime,
+		vec<2, float, Q> const& center, float radius,
+		uint32* hitMask, float* times
+	)
+	{
+		assert(origins.size() == directions.size());
+
+		detail::intersect_rays_circle const Pairs = {
+			origins.component(0), origins.component(1), directions.component(0), directions.component(1),
+			center.x, center.y, radius, maxTime};
+		return detail::intersect_batch(Pairs, origins.size(), hitMask, times);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER std::size_t intersectRayOBB
+	(
+		vec<2, float, Q> const& origin, vec<2, float, Q> const& direction, float maxTime,
+		soa<vec<2, float, Q> > const& centers, soa<vec<2, float, Q> > const& axes, soa<vec<2, float, Q> > const& halfExtents,
+		uint32* hitMask, float* times
+	)
+	{
+		assert(centers.size() == axes.size() && centers.size() == halfExtents.size());
+
+		detail::intersect_ray_obbs const Pairs = {
+			origin.x, origin.y, direction.x, direction.y, maxTime,
+			centers.component(0), centers.component(1), axes.component(0), axes.component(1),
+			halfExtents.component(0), halfExtents.component(1)};
+		return detail::intersect_batch(Pairs, centers.size(), hitMask, times);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER std::size_t intersectRayOBB
+	(
+		soa<vec<2, float, Q> > const& origins, soa<vec<2, float, Q> > const& directions, float maxTime,
+		vec<2, float, Q> const& center, vec<2, float, Q> const& axis, vec<2, float, Q> const& halfExtents,
+		uint32* hitMask, float* times
+	)
+	{
+		assert(origins.size() == directions.size());
+
+		detail::intersect_rays_obb const Pairs = {
+			origins.component(0), origins.component(1), directions.component(0), directions.component(1),
+			center.x, center.y, axis.x, axis.y, halfExtents.x, halfExtents.y, maxTime};
+		return detail::intersect_batch(Pairs, origins.size(), hitMask, times);
+	}
 }//namespace glm
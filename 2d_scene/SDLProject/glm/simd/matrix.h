@@ -1025,4 +1025,149 @@ GLM_FUNC_QUALIFIER void glm_mat4_outerProduct(__m128 const& c, __m128 const& r,
 	out[3] = _mm_mul_ps(c, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)));
 }
 
+// 2x2 blocks of a 4x4 matrix, stored as (m00, m01, m10, m11) in one register.
+// A * B
+GLM_FUNC_QUALIFIER glm_vec4 glm_mat4_block_mul(glm_vec4 a, glm_vec4 b)
+{
+	glm_vec4 const m0 = _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0)));
+	glm_vec4 const m1 = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2)));
+	return _mm_add_ps(m0, m1);
+}
+
+// adjugate(A) * B
+GLM_FUNC_QUALIFIER glm_vec4 glm_mat4_block_adjmul(glm_vec4 a, glm_vec4 b)
+{
+	glm_vec4 const m0 = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b);
+	glm_vec4 const m1 = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)));
+	return _mm_sub_ps(m0, m1);
+}
+
+// A * adjugate(B)
+GLM_FUNC_QUALIFIER glm_vec4 glm_mat4_block_muladj(glm_vec4 a, glm_vec4 b)
+{
+	glm_vec4 const m0 = _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3)));
+	glm_vec4 const m1 = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2)));
+	return _mm_sub_ps(m0, m1);
+}
+
+// General inverse by 2x2 blocks. The columns are treated as the rows of the
+// transpose, whose inverse rows are the columns of the result. About half
+// the shuffles and multiplies of glm_mat4_inverse.
+GLM_FUNC_QUALIFIER void glm_mat4_inverse_block(glm_vec4 const in[4], glm_vec4 out[4])
+{
+	glm_vec4 const A = _mm_movelh_ps(in[0], in[1]);
+	glm_vec4 const B = _mm_movehl_ps(in[1], in[0]);
+	glm_vec4 const C = _mm_movelh_ps(in[2], in[3]);
+	glm_vec4 const D = _mm_movehl_ps(in[3], in[2]);
+
+	// (|A|, |B|, |C|, |D|)
+	glm_vec4 const DetSub = _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(in[0], in[2], _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(in[1], in[3], _MM_SHUFFLE(3, 1, 3, 1))),
+		_mm_mul_ps(_mm_shuffle_ps(in[0], in[2], _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(in[1], in[3], _MM_SHUFFLE(2, 0, 2, 0))));
+	glm_vec4 const DetA = _mm_shuffle_ps(DetSub, DetSub, _MM_SHUFFLE(0, 0, 0, 0));
+	glm_vec4 const DetB = _mm_shuffle_ps(DetSub, DetSub, _MM_SHUFFLE(1, 1, 1, 1));
+	glm_vec4 const DetC = _mm_shuffle_ps(DetSub, DetSub, _MM_SHUFFLE(2, 2, 2, 2));
+	glm_vec4 const DetD = _mm_shuffle_ps(DetSub, DetSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+	glm_vec4 const D_C = glm_mat4_block_adjmul(D, C);
+	glm_vec4 const A_B = glm_mat4_block_adjmul(A, B);
+
+	// Adjugates of the result blocks, scaled by |M|.
+	glm_vec4 X_ = _mm_sub_ps(_mm_mul_ps(DetD, A), glm_mat4_block_mul(B, D_C));
+	glm_vec4 W_ = _mm_sub_ps(_mm_mul_ps(DetA, D), glm_mat4_block_mul(C, A_B));
+	glm_vec4 Y_ = _mm_sub_ps(_mm_mul_ps(DetB, C), glm_mat4_block_muladj(D, A_B));
+	glm_vec4 Z_ = _mm_sub_ps(_mm_mul_ps(DetC, B), glm_mat4_block_muladj(A, D_C));
+
+	// |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+	glm_vec4 Tr = _mm_mul_ps(A_B, _mm_shuffle_ps(D_C, D_C, _MM_SHUFFLE(3, 1, 2, 0)));
+	Tr = _mm_add_ps(Tr, _mm_shuffle_ps(Tr, Tr, _MM_SHUFFLE(2, 3, 0, 1)));
+	Tr = _mm_add_ps(Tr, _mm_shuffle_ps(Tr, Tr, _MM_SHUFFLE(1, 0, 3, 2)));
+	glm_vec4 const DetM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(DetA, DetD), _mm_mul_ps(DetB, DetC)), Tr);
+
+	glm_vec4 const RcpDetM = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), DetM);
+	X_ = _mm_mul_ps(X_, RcpDetM);
+	Y_ = _mm_mul_ps(Y_, RcpDetM);
+	Z_ = _mm_mul_ps(Z_, RcpDetM);
+	W_ = _mm_mul_ps(W_, RcpDetM);
+
+	// The adjugate swap and the block-to-row shuffle in one step.
+	out[0] = _mm_shuffle_ps(X_, Y_, _MM_SHUFFLE(1, 3, 1, 3));
+	out[1] = _mm_shuffle_ps(X_, Y_, _MM_SHUFFLE(0, 2, 0, 2));
+	out[2] = _mm_shuffle_ps(Z_, W_, _MM_SHUFFLE(1, 3, 1, 3));
+	out[3] = _mm_shuffle_ps(Z_, W_, _MM_SHUFFLE(0, 2, 0, 2));
+}
+
+// Inverse of a matrix whose last row is (0, 0, 0, 1): the rows of the 3x3
+// inverse are cross products of its columns, and the translation is
+// rotated back by them.
+GLM_FUNC_QUALIFIER void glm_mat4_affine_inverse(glm_vec4 const in[4], glm_vec4 out[4])
+{
+	glm_vec4 const Mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+	glm_vec4 const C0 = _mm_and_ps(in[0], Mask);
+	glm_vec4 const C1 = _mm_and_ps(in[1], Mask);
+	glm_vec4 const C2 = _mm_and_ps(in[2], Mask);
+
+	glm_vec4 R0 = glm_vec4_cross(C1, C2);
+	glm_vec4 R1 = glm_vec4_cross(C2, C0);
+	glm_vec4 R2 = glm_vec4_cross(C0, C1);
+
+	glm_vec4 Det = _mm_mul_ps(C0, R0);
+	Det = _mm_add_ps(Det, _mm_shuffle_ps(Det, Det, _MM_SHUFFLE(2, 3, 0, 1)));
+	Det = _mm_add_ps(Det, _mm_shuffle_ps(Det, Det, _MM_SHUFFLE(1, 0, 3, 2)));
+	glm_vec4 const RcpDet = _mm_div_ps(_mm_set1_ps(1.f), Det);
+	R0 = _mm_mul_ps(R0, RcpDet);
+	R1 = _mm_mul_ps(R1, RcpDet);
+	R2 = _mm_mul_ps(R2, RcpDet);
+
+	// Rows to columns; the fourth row is zero, so every w comes out zero.
+	glm_vec4 const T0 = _mm_unpacklo_ps(R0, R1);
+	glm_vec4 const T1 = _mm_unpackhi_ps(R0, R1);
+	glm_vec4 const T2 = _mm_unpacklo_ps(R2, _mm_setzero_ps());
+	glm_vec4 const T3 = _mm_unpackhi_ps(R2, _mm_setzero_ps());
+	out[0] = _mm_movelh_ps(T0, T2);
+	out[1] = _mm_movehl_ps(T2, T0);
+	out[2] = _mm_movelh_ps(T1, T3);
+
+	glm_vec4 const X = _mm_shuffle_ps(in[3], in[3], _MM_SHUFFLE(0, 0, 0, 0));
+	glm_vec4 const Y = _mm_shuffle_ps(in[3], in[3], _MM_SHUFFLE(1, 1, 1, 1));
+	glm_vec4 const Z = _mm_shuffle_ps(in[3], in[3], _MM_SHUFFLE(2, 2, 2, 2));
+	glm_vec4 Translation = _mm_mul_ps(out[0], X);
+	Translation = glm_vec4_fma(out[1], Y, Translation);
+	Translation = glm_vec4_fma(out[2], Z, Translation);
+	out[3] = _mm_sub_ps(_mm_setr_ps(0.f, 0.f, 0.f, 1.f), Translation);
+}
+
+#if GLM_ARCH & GLM_ARCH_AVX_BIT
+
+// in1 * in2 with two result columns per 256-bit register. Products are summed
+// in the same order as the scalar operator*, so without FMA the result is
+// bit-identical to it. Unaligned loads and stores: packed matrices work too.
+GLM_FUNC_QUALIFIER void glm_mat4_mul_avx(float const in1[16], float const in2[16], float out[16])
+{
+	__m256 const A0 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(in1 + 0));
+	__m256 const A1 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(in1 + 4));
+	__m256 const A2 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(in1 + 8));
+	__m256 const A3 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(in1 + 12));
+
+	for(int i = 0; i < 16; i += 8)
+	{
+		__m256 const B = _mm256_loadu_ps(in2 + i);
+
+		__m256 r = _mm256_mul_ps(A0, _mm256_shuffle_ps(B, B, _MM_SHUFFLE(0, 0, 0, 0)));
+#		if defined(__FMA__) || ((GLM_COMPILER & GLM_COMPILER_VC) && (GLM_ARCH & GLM_ARCH_AVX2_BIT))
+			r = _mm256_fmadd_ps(A1, _mm256_shuffle_ps(B, B, _MM_SHUFFLE(1, 1, 1, 1)), r);
+			r = _mm256_fmadd_ps(A2, _mm256_shuffle_ps(B, B, _MM_SHUFFLE(2, 2, 2, 2)), r);
+			r = _mm256_fmadd_ps(A3, _mm256_shuffle_ps(B, B, _MM_SHUFFLE(3, 3, 3, 3)), r);
+#		else
+			r = _mm256_add_ps(r, _mm256_mul_ps(A1, _mm256_shuffle_ps(B, B, _MM_SHUFFLE(1, 1, 1, 1))));
+			r = _mm256_add_ps(r, _mm256_mul_ps(A2, _mm256_shuffle_ps(B, B, _MM_SHUFFLE(2, 2, 2, 2))));
+			r = _mm256_add_ps(r, _mm256_mul_ps(A3, _mm256_shuffle_ps(B, B, _MM_SHUFFLE(3, 3, 3, 3))));
+#		endif
+
+		_mm256_storeu_ps(out + i, r);
+	}
+}
+
+#endif//GLM_ARCH & GLM_ARCH_AVX_BIT
+
 #endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
@@ -8,6 +8,9 @@
 #define GL_GLEXT_PROTOTYPES 1
 #define LOG(argument) std::cout << argument << '\n'
 #define STB_IMAGE_IMPLEMENTATION
+#define STBI_MALLOC(size)                          ImageArena::Allocate(size)
+#define STBI_REALLOC_SIZED(block, old_size, size)  ImageArena::Reallocate(block, old_size, size)
+#define STBI_FREE(block)                           ImageArena::Free(block)
 
 #ifdef _WINDOWS
 #include <GL/glew.h>
@@ -18,8 +21,27 @@
 #include "glm/mat4x4.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "ShaderProgram.h"
+#include "ImageArena.h"
+#include "MappedFile.h"
+#include "CookedTexture.h"
+#include "MipChain.h"
+#include "Transform2D.h"
+#include "SpriteMesh.h"
+#include "VertexFormat.h"
+#include "World.h"
+#include "Components.h"
+#include "TransformHierarchy.h"
+#include "Systems.h"
+#include "ParticlePool.h"
+#include "ParticleRenderer.h"
+#include "SpriteAnimation.h"
+#include "Tilemap.h"
+#include "SpriteGrid.h"
+#include "NoiseGrid.h"
+#include "AssetWatcher.h"
 #include "stb_image.h"
 #include <cmath>
+#include <cstring>
 
 const int WINDOW_WIDTH  = 640,
           WINDOW_HEIGHT = 480;
@@ -35,14 +57,29 @@ const int VIEWPORT_X      = 0,
           VIEWPORT_HEIGHT = WINDOW_HEIGHT;
 
 const char V_SHADER_PATH[] = "shaders/vertex_textured.glsl",
-           F_SHADER_PATH[] = "shaders/fragment_textured.glsl";
+           F_SHADER_PATH[] = "shaders/fragment_textured.glsl",
+           V_PARTICLE_SHADER_PATH[] = "shaders/vertex_particle.glsl";
 
-const char FLOWER_SPRITE[] = "textures/flower.png";
+const char FLOWER_SPRITE[] = "textures/flower.png",
+           MAGE_SPRITE[]   = "textures/black_mage.png",
+           CACTAR_SPRITE[] = "textures/cactar.png";
 
 const float ROT_SPEED = 100.0f;
 
-const glm::vec3 FLOWER_INIT_POS = glm::vec3(0.0f, 0.0f, 0.0f),
-                FLOWER_INIT_SCA = glm::vec3(1.5f, 1.5f, 0.0f);
+GLM_CONSTEXPR const glm::vec3 FLOWER_INIT_POS = glm::vec3(0.0f, 0.0f, 0.0f),
+                              FLOWER_INIT_SCA = glm::vec3(1.5f, 1.5f, 0.0f);
+
+// Fixed for the whole scene, so both matrices are computed by the compiler. glm is constexpr only
+// in C++14 builds without GLM_FORCE_INTRINSICS; elsewhere GLM_CONSTEXPR is empty and they are
+// plain constants built at startup.
+GLM_CONSTEXPR const glm::mat4 VIEW_MATRIX       = glm::mat4(1.0f);
+GLM_CONSTEXPR const glm::mat4 PROJECTION_MATRIX = glm::ortho(-5.0f, 5.0f, -3.75f, 3.75f, -1.0f, 1.0f);
+
+#if GLM_HAS_CONSTEXPR
+static_assert(PROJECTION_MATRIX[0][0] == 0.2f && PROJECTION_MATRIX[1][1] == 2.0f / 7.5f &&
+              PROJECTION_MATRIX[3][0] == 0.0f && PROJECTION_MATRIX[3][1] == 0.0f,
+              "the 10 x 7.5 world fills the viewport, centred on the origin");
+#endif
 
 const int NUMBER_OF_TEXTURES = 1;
 const GLint LEVEL_OF_DETAIL  = 0,
@@ -57,46 +94,177 @@ bool g_game_is_running = true;
 ShaderProgram g_flower_program;
 GLuint        g_flower_texture_id;
 
-glm::mat4 g_view_matrix,
-          g_flower_model_matrix,
-          g_projection_matrix;
-
 float g_previous_ticks  = 0.0f;
-float g_rot_angle = 0.0f;
 
 float x = 0.0;
 
-// the movement vector 
-glm::vec3 g_flower_movement = glm::vec3(0.0f, 0.0f, 0.0f);
-glm::vec3 g_flower_position = glm::vec3(0.0f, 0.0f, 0.0f);
-float g_flower_speed = 1.0f;
+// Spins a sprite about the y axis: seen edge-on, that only squashes its width by cos(angle).
+struct Spin {
+    float degrees;
+    float degreesPerSecond;
+    float width;
+};
+
+const size_t PARTICLE_CAPACITY = 4096;
+const float PETALS_PER_SECOND = 40.0f;
+const glm::vec2 PETAL_GRAVITY = glm::vec2(0.0f, -0.6f);
+
+// small copies of the flower thrown up and out, then drifting down
+const ParticleEmitter PETAL_EMITTER = { glm::vec2(0.0f), glm::vec2(0.4f), glm::vec2(0.0f, 0.5f), 0.6f, 2.5f, 0.75f, 0.35f, glm::vec4(1.0f) };
+
+ParticlePool g_particles(PARTICLE_CAPACITY);
+ParticleRenderer g_particle_renderer;
+bool g_particles_enabled = false;
+float g_petals_owed = 0.0f;
+
+World g_world;
+TransformHierarchy g_hierarchy;
+Scheduler g_update_systems;
+Entity g_flower = NULL_ENTITY;
+
+// sprites are filed by where they are, and render draws only those the camera can see
+const float SPRITE_CELL_SIZE = 2.0f;
+
+SpriteGrid g_sprite_grid(SPRITE_CELL_SIZE);
+std::vector<Entity> g_visible_sprites;
+
+// shaders and sprites saved while the scene runs show up from the next frame on
+AssetWatcher g_assets;
+
+// UNIT_SPRITE_QUAD in the compact layout, used whenever the context reads half floats; the animator
+// and the meadow keep floats, as their corners are in world space and halves are 0.25 apart at its edge
+PackedSpriteVertex g_packed_quad[SPRITE_QUAD_VERTEX_COUNT];
+bool g_use_packed_vertices = false;
+
+/**------------------------CHARACTERS---------------------------------**/
+// Each sheet is a single drawing, so the clips animate by facing it one way and then the other.
+GLM_CONSTEXPR const glm::vec2 MAGE_POSITION   = glm::vec2(-3.5f, -2.3f),
+                              MAGE_SCALE      = glm::vec2(0.83f, 1.2f),
+                              CACTAR_POSITION = glm::vec2(3.5f, -2.3f),
+                              CACTAR_SCALE    = glm::vec2(0.82f, 1.2f);
+
+SpriteAnimator g_animator;
+
+/**------------------------MEADOW---------------------------------**/
+// A field of flowers under the scene, far larger than the view: only the chunks on screen are built
+// and drawn. Where the noise runs high a flower grows, facing whichever way the tile's parity says.
+const int   MEADOW_TILES     = 1024;
+const float MEADOW_TILE_SIZE = 0.5f;
+const float MEADOW_DENSITY   = 0.45f;   // noise above this grows a flower
+const glm::vec2 MEADOW_ORIGIN = glm::vec2(-0.5f * MEADOW_TILES * MEADOW_TILE_SIZE);
+
+Tilemap g_meadow(MEADOW_TILES, MEADOW_TILES, MEADOW_TILE_SIZE, MEADOW_ORIGIN);
+
+void plant_meadow()
+{
+    NoiseGridDesc desc = default_noise_grid();
+    desc.step = glm::vec2(0.15f);
+    desc.octaves = 2;
+    
+    std::vector<float> noise((size_t) MEADOW_TILES * MEADOW_TILES);
+    fill_noise_grid(desc, MEADOW_TILES, MEADOW_TILES, noise.data());
+    
+    std::vector<uint16_t> tiles(noise.size());
+    for (size_t i = 0; i < tiles.size(); i++)
+    {
+        tiles[i] = noise[i] > MEADOW_DENSITY ? uint16_t(i & 1) : EMPTY_TILE;
+    }
+    
+    g_meadow.SetTileset(g_flower_texture_id, { FULL_TEXTURE_REGION, mirrored(FULL_TEXTURE_REGION) });
+    g_meadow.SetTiles(tiles.data());
+}
+
+void shed_petals(World &world, float delta_time)
+{
+    // whole petals only, carrying the fraction over so the rate holds at any frame rate
+    g_petals_owed += PETALS_PER_SECOND * delta_time;
+    size_t count = (size_t) g_petals_owed;
+    g_petals_owed -= count;
+    
+    ParticleEmitter petals = PETAL_EMITTER;
+    petals.position = world.Get<Transform2D>(g_flower)->translation;
+    g_particles.Emit(petals, count);
+}
+
+void spin_sprites(World &world, float delta_time)
+{
+    world.EachChunk<Spin, Scale, TransformNode>([delta_time](size_t count, const Entity *, Spin *spins, Scale *scales, TransformNode *nodes)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            spins[i].degrees += spins[i].degreesPerSecond * delta_time;
+            scales[i].value.x = spins[i].width * std::cos(glm::radians(spins[i].degrees));
+            g_hierarchy.MarkDirty(nodes[i].node);
+        }
+    });
+}
 
 
 GLuint load_texture(const char* filepath)
 {
+    // prefer the cooked container next to the source image, re-cooking it whenever the source changes;
+    // a cooked texture needs no decode at all, just a mapping and one upload per mip level
+    std::string cooked_path = std::string(filepath) + COOKED_TEXTURE_EXTENSION;
+    if (is_cooked_texture_current(filepath, cooked_path.c_str()) || cook_texture(filepath, cooked_path.c_str()))
+    {
+        GLuint textureID = load_cooked_texture(cooked_path.c_str());
+        ImageArena::Reset();
+        if (textureID != 0) return textureID;
+    }
+    
+    // decode straight out of the mapped file instead of through stdio
+    MappedFile file(filepath);
+    
     int width, height, number_of_components;
-    unsigned char* image = stbi_load(filepath, &width, &height, &number_of_components, STBI_rgb_alpha);
+    if (!file.IsOpen() || !stbi_info_from_memory(file.Data(), (int) file.Size(), &width, &height, &number_of_components))
+    {
+        LOG("Unable to load image. Make sure the path is correct.");
+        assert(false);
+    }
+    
+    // the chain is decoded and filtered in arena memory, and each level is uploaded straight from there
+    MipLevelView levels[MAX_MIP_LEVELS];
+    int level_count = count_mip_levels(width, height);
+    size_t chain_size = layout_mip_chain(NULL, width, height, levels);
     
-    if (image == NULL)
+    stbi_uc* pixels = (stbi_uc*) ImageArena::Allocate(chain_size);
+    int decoded = pixels != NULL && stbi_load_from_memory_into(file.Data(), (int) file.Size(), pixels, width, height, width * STBI_rgb_alpha,
+                                                               &width, &height, &number_of_components, STBI_rgb_alpha, false);
+    if (!decoded)
     {
         LOG("Unable to load image. Make sure the path is correct.");
         assert(false);
     }
     
+    layout_mip_chain(pixels, width, height, levels);
+    generate_mip_chain(levels, level_count, MIP_FILTER_BOX);
+    
     GLuint textureID;
     glGenTextures(NUMBER_OF_TEXTURES, &textureID);
     glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexImage2D(GL_TEXTURE_2D, LEVEL_OF_DETAIL, GL_RGBA, width, height, TEXTURE_BORDER, GL_RGBA, GL_UNSIGNED_BYTE, image);
+    for (int level = 0; level < level_count; level++)
+    {
+        glTexImage2D(GL_TEXTURE_2D, LEVEL_OF_DETAIL + level, GL_RGBA, levels[level].width, levels[level].height, TEXTURE_BORDER,
+                     GL_RGBA, GL_UNSIGNED_BYTE, levels[level].pixels);
+    }
     
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level_count - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, level_count > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     
-    stbi_image_free(image);
+    // every intermediate buffer of this decode goes back to the arena in one step
+    ImageArena::Reset();
     
     return textureID;
 }
 
 
+void set_camera(ShaderProgram &program)
+{
+    program.SetProjectionMatrix(PROJECTION_MATRIX);
+    program.SetViewMatrix(VIEW_MATRIX);
+}
+
 void initialise()
 {
     SDL_Init(SDL_INIT_VIDEO);
@@ -113,19 +281,66 @@ void initialise()
 #endif
     glViewport(VIEWPORT_X, VIEWPORT_Y, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
     
-    g_view_matrix = glm::mat4(1.0f);
-    g_projection_matrix = glm::ortho(-5.0f, 5.0f, -3.75f, 3.75f, -1.0f, 1.0f);
     g_flower_program.Load(V_SHADER_PATH, F_SHADER_PATH);
     
-    g_flower_model_matrix = glm::mat4(1.0f);
-    g_flower_model_matrix = glm::translate(g_flower_model_matrix, FLOWER_INIT_POS);
-    g_flower_model_matrix = glm::scale(g_flower_model_matrix, FLOWER_INIT_SCA);
+    g_use_packed_vertices = packed_vertices_supported();
+    pack_sprite_vertices(UNIT_SPRITE_QUAD.positions, UNIT_SPRITE_QUAD.texCoords, NULL, g_packed_quad, SPRITE_QUAD_VERTEX_COUNT);
+    
+    g_flower_program.SetProjectionMatrix(PROJECTION_MATRIX);
+    g_flower_program.SetViewMatrix(VIEW_MATRIX);
     
-    g_flower_program.SetProjectionMatrix(g_projection_matrix);
-    g_flower_program.SetViewMatrix(g_view_matrix);
+    // without instancing the scene just runs without petals
+    g_particles_enabled = particles_supported();
+    if (g_particles_enabled)
+    {
+        g_particle_renderer.Load(V_PARTICLE_SHADER_PATH, F_SHADER_PATH, PARTICLE_CAPACITY);
+        g_particle_renderer.SetProjectionMatrix(PROJECTION_MATRIX);
+        g_particle_renderer.SetViewMatrix(VIEW_MATRIX);
+    }
     
     glUseProgram(g_flower_program.programID);
     g_flower_texture_id = load_texture(FLOWER_SPRITE);
+    LOG("Image arena high-water mark: " << ImageArena::HighWaterMark() << " bytes");
+    
+    // the scale applies to the translation as well, so the flower's position is kept pre-scaled
+    g_flower = g_world.Create(Position { glm::vec2(FLOWER_INIT_SCA * FLOWER_INIT_POS) }, Rotation { 0.0f },
+                              Scale { glm::vec2(FLOWER_INIT_SCA) }, Velocity { glm::vec2(0.0f) }, Transform2D::Identity(),
+                              Sprite { g_flower_texture_id }, Spin { 0.0f, ROT_SPEED, FLOWER_INIT_SCA.x });
+    g_hierarchy.Attach(g_world, g_flower);
+    
+    plant_meadow();
+    
+    std::vector<AtlasRegion> facing = { FULL_TEXTURE_REGION, mirrored(FULL_TEXTURE_REGION) };
+    GLuint mage_texture_id   = load_texture(MAGE_SPRITE),
+           cactar_texture_id = load_texture(CACTAR_SPRITE);
+    uint16_t mage_sheet   = g_animator.AddSheet(mage_texture_id, facing);
+    uint16_t cactar_sheet = g_animator.AddSheet(cactar_texture_id, facing);
+    uint16_t waddle = g_animator.AddClip(mage_sheet, { 0, 1 }, { 0.4f, 0.4f });
+    uint16_t dance  = g_animator.AddClip(cactar_sheet, { 0, 1, 0, 1 }, { 0.15f, 0.15f, 0.15f, 0.45f });
+    
+    Entity mage   = g_world.Create(Position { MAGE_POSITION }, Rotation { 0.0f }, Scale { MAGE_SCALE }, Transform2D::Identity());
+    Entity cactar = g_world.Create(Position { CACTAR_POSITION }, Rotation { 0.0f }, Scale { CACTAR_SCALE }, Transform2D::Identity());
+    g_hierarchy.Attach(g_world, mage);
+    g_hierarchy.Attach(g_world, cactar);
+    g_animator.Play(g_world, mage, waddle);
+    g_animator.Play(g_world, cactar, dance);
+    
+    g_assets.WatchShader(g_flower_program, V_SHADER_PATH, F_SHADER_PATH, set_camera);
+    if (g_particles_enabled) g_assets.WatchShader(g_particle_renderer.program, V_PARTICLE_SHADER_PATH, F_SHADER_PATH, set_camera);
+    g_assets.WatchTexture(g_flower_texture_id, FLOWER_SPRITE);
+    g_assets.WatchTexture(mage_texture_id, MAGE_SPRITE);
+    g_assets.WatchTexture(cactar_texture_id, CACTAR_SPRITE);
+    if (g_assets.Start()) LOG("Watching shaders and textures for changes");
+    
+    g_update_systems.Add("spin sprites", spin_sprites);
+    g_update_systems.Add("integrate velocities", [](World &world, float delta_time) { integrate_velocities(world, g_hierarchy, delta_time); });
+    g_update_systems.Add("update transforms", [](World &world, float) { g_hierarchy.Update(world); });
+    g_update_systems.Add("file sprites", [](World &world, float) { g_sprite_grid.Update(world, g_hierarchy); });
+    g_update_systems.Add("animate sprites", [](World &world, float delta_time) { g_animator.Update(world, delta_time); });
+    g_update_systems.Add("shed petals", shed_petals);
+    g_update_systems.Add("update particles", [](World &, float delta_time) { g_particles.Update(delta_time, PETAL_GRAVITY); });
+    g_update_systems.SetEnabled("shed petals", g_particles_enabled);
+    g_update_systems.SetEnabled("update particles", g_particles_enabled);
     
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -148,27 +363,30 @@ void process_input()
                 
         }
     }
+    // the arrow keys put the flower one unit off its starting position on that axis
     const Uint8 *key_state = SDL_GetKeyboardState(NULL);
+    glm::vec2 &flower_position = g_world.Get<Position>(g_flower)->value;
+    glm::vec2 previous_position = flower_position;
+    
     if (key_state[SDL_SCANCODE_LEFT])
     {
-        g_flower_position.x = -1.0f;
+        flower_position.x = FLOWER_INIT_SCA.x * (FLOWER_INIT_POS.x - 1.0f);
     }
 
     if (key_state[SDL_SCANCODE_RIGHT])
     {
-        g_flower_position.x = 1.0f;
+        flower_position.x = FLOWER_INIT_SCA.x * (FLOWER_INIT_POS.x + 1.0f);
     }
     if (key_state[SDL_SCANCODE_UP]) {
-        g_flower_position.y = 1.0f;
+        flower_position.y = FLOWER_INIT_SCA.y * (FLOWER_INIT_POS.y + 1.0f);
     }
     if (key_state[SDL_SCANCODE_DOWN]) {
-        g_flower_position.y = -1.0f;
+        flower_position.y = FLOWER_INIT_SCA.y * (FLOWER_INIT_POS.y - 1.0f);
     }
     
-    // This makes sure that the player can't "cheat" their way into moving faster
-    if (glm::length(g_flower_movement) > 1.0f)
+    if (flower_position != previous_position)
     {
-        g_flower_movement = glm::normalize(g_flower_movement);
+        g_hierarchy.MarkDirty(g_world.Get<TransformNode>(g_flower)->node);
     }
 }
 
@@ -180,57 +398,62 @@ void update()
     float delta_time = ticks - g_previous_ticks;
     g_previous_ticks = ticks;
     
-    /** ———— RESETTING MODEL MATRIX ———— **/
-    g_flower_model_matrix = glm::mat4(1.0f);
-    g_flower_model_matrix = glm::scale(g_flower_model_matrix, FLOWER_INIT_SCA);
-    g_flower_model_matrix = glm::translate(g_flower_model_matrix, FLOWER_INIT_POS);
-    
-    // ———————————————— PART 3 ———————————————— //
-    
-    g_flower_position += g_flower_movement * g_flower_speed * delta_time;
-    g_flower_model_matrix = glm::translate(g_flower_model_matrix, g_flower_position);
-    
-    g_flower_movement = glm::vec3(0.0f, 0.0f, 0.0f);
-    
-    // ———————————————— PART 3 ———————————————— //
-    
-    /** ———— ROTATING SPRITE ———— **/
-    g_rot_angle += ROT_SPEED * delta_time;
-    g_flower_model_matrix = glm::rotate(g_flower_model_matrix, glm::radians(g_rot_angle), glm::vec3(0.0f, 1.0f, 0.0f));
+    g_update_systems.Run(g_world, delta_time);
 }
 
-
 void render() {
+    // between frames, so no draw sees half an asset
+    g_assets.Apply();
+    
     glClear(GL_COLOR_BUFFER_BIT);
     
-    float flower_vertices[] = {
-        -0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f,
-        -0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f
-    };
-
-    float flower_texture_coordinates[] = {
-        0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f,
-        0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f,
-    };
+    g_meadow.Draw(g_flower_program, PROJECTION_MATRIX, VIEW_MATRIX);
+    
+    if (g_particles_enabled)
+    {
+        g_particle_renderer.Draw(g_particles, g_flower_texture_id);
+        glUseProgram(g_flower_program.programID);
+    }
     
-    glVertexAttribPointer(g_flower_program.positionAttribute, 2, GL_FLOAT, false, 0, flower_vertices);
-    glEnableVertexAttribArray(g_flower_program.positionAttribute);
+    if (g_use_packed_vertices)
+    {
+        bind_sprite_vertices(g_flower_program, g_packed_quad);
+    }
+    else
+    {
+        glVertexAttribPointer(g_flower_program.positionAttribute, 2, GL_FLOAT, false, 0, UNIT_SPRITE_QUAD.positions);
+        glEnableVertexAttribArray(g_flower_program.positionAttribute);
+        
+        glVertexAttribPointer(g_flower_program.texCoordAttribute, 2, GL_FLOAT, false, 0, UNIT_SPRITE_QUAD.texCoords);
+        glEnableVertexAttribArray(g_flower_program.texCoordAttribute);
+    }
     
-    glVertexAttribPointer(g_flower_program.texCoordAttribute, 2, GL_FLOAT, false, 0, flower_texture_coordinates);
-    glEnableVertexAttribArray(g_flower_program.texCoordAttribute);
+    g_visible_sprites.clear();
+    g_sprite_grid.Query(visible_rect(PROJECTION_MATRIX, VIEW_MATRIX), g_visible_sprites);
+    draw_sprites(g_world, g_flower_program, SPRITE_QUAD_VERTEX_COUNT, g_visible_sprites);
     
-    g_flower_program.SetModelMatrix(g_flower_model_matrix);
-    glBindTexture(GL_TEXTURE_2D, g_flower_texture_id);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    if (g_use_packed_vertices)
+    {
+        unbind_sprite_vertices(g_flower_program);
+    }
+    else
+    {
+        glDisableVertexAttribArray(g_flower_program.positionAttribute);
+        glDisableVertexAttribArray(g_flower_program.texCoordAttribute);
+    }
     
-    glDisableVertexAttribArray(g_flower_program.positionAttribute);
-    glDisableVertexAttribArray(g_flower_program.texCoordAttribute);
+    g_animator.Draw(g_world, g_flower_program);
     
     SDL_GL_SwapWindow(g_display_window);
 }
 
 
-void shutdown() { SDL_Quit(); }
+void shutdown()
+{
+    g_assets.Stop();
+    g_meadow.Cleanup();
+    SDL_Quit();
+}
 
 
 int main(int argc, char* argv[])
@@ -1,15 +1,18 @@
 attribute vec4 position;
 attribute vec2 texCoord;
+attribute vec4 tint;
 
 uniform mat4 modelMatrix;
 uniform mat4 viewMatrix;
 uniform mat4 projectionMatrix;
 
 varying vec2 texCoordVar;
+varying vec4 tintVar;
 
 void main()
 {
 	vec4 p = viewMatrix * modelMatrix  * position;
     texCoordVar = texCoord;
+    tintVar = tint;
 	gl_Position = projectionMatrix * p;
 }
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "AssetWatcher.h"
+#include "ImageArena.h"
+#include "MappedFile.h"
+#include "MipChain.h"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <iostream>
+
+#ifdef __linux__
+    #include <cerrno>
+    #include <cstdint>
+    #include <poll.h>
+    #include <sys/eventfd.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+    // editors save in several steps (truncate, write, rename), so a change is acted on only once its
+    // directory has been quiet this long
+    const int SETTLE_MILLISECONDS = 50;
+
+    std::string read_text(const std::string &path)
+    {
+        MappedFile file(path.c_str());
+        return file.IsOpen() ? std::string(reinterpret_cast<const char *>(file.Data()), file.Size()) : std::string();
+    }
+
+    // "shaders/vertex.glsl" is watched through "shaders"; a bare name through the working directory
+    std::string directory_of(const std::string &path)
+    {
+        size_t slash = path.find_last_of('/');
+        return slash == std::string::npos ? std::string(".") : path.substr(0, slash);
+    }
+
+    bool contains(const std::vector<std::string> &files, const std::string &file)
+    {
+        return std::find(files.begin(), files.end(), file) != files.end();
+    }
+}
+
+AssetWatcher::AssetWatcher() : stopping(false), notifyFile(-1), wakeFile(-1) {}
+
+AssetWatcher::~AssetWatcher() {
+    Stop();
+}
+
+void AssetWatcher::WatchShader(ShaderProgram &program, const char *vertexShaderFile, const char *fragmentShaderFile,
+                               std::function<void(ShaderProgram &)> reloaded) {
+    WatchedShader shader = { &program, vertexShaderFile, fragmentShaderFile, reloaded };
+    shaders.push_back(shader);
+}
+
+void AssetWatcher::WatchTexture(GLuint texture, const char *imageFile) {
+    WatchedTexture watched = { texture, imageFile };
+    textures.push_back(watched);
+}
+
+#ifdef __linux__
+
+bool AssetWatcher::Start() {
+    notifyFile = inotify_init1(IN_CLOEXEC);
+    wakeFile = eventfd(0, EFD_CLOEXEC);
+    if (notifyFile < 0 || wakeFile < 0)
+    {
+        Stop();
+        return false;
+    }
+
+    std::vector<std::string> files;
+    for (const WatchedShader &shader : shaders)
+    {
+        files.push_back(shader.vertexFile);
+        files.push_back(shader.fragmentFile);
+    }
+    for (const WatchedTexture &texture : textures) files.push_back(texture.file);
+
+    // a file replaced by rename gets a new inode, so the directory is watched, not the file
+    for (const std::string &file : files)
+    {
+        std::string directory = directory_of(file);
+        std::string prefix = directory == "." ? std::string() : directory + "/";
+
+        bool watched = false;
+        for (const auto &entry : directories) watched = watched || entry.second == prefix;
+        if (watched) continue;
+
+        int watch = inotify_add_watch(notifyFile, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (watch < 0)
+        {
+            std::cout << "Unable to watch " << directory << " for changes" << std::endl;
+            continue;
+        }
+        directories.push_back(std::make_pair(watch, prefix));
+    }
+
+    worker = std::thread(&AssetWatcher::Run, this);
+    return true;
+}
+
+void AssetWatcher::Stop() {
+    if (worker.joinable())
+    {
+        stopping = true;
+        uint64_t wake = 1;
+        ssize_t written = write(wakeFile, &wake, sizeof(wake));
+        (void) written;
+        worker.join();
+    }
+
+    if (notifyFile >= 0) close(notifyFile);
+    if (wakeFile >= 0) close(wakeFile);
+    notifyFile = wakeFile = -1;
+    directories.clear();
+    stopping = false;
+}
+
+void AssetWatcher::Run() {
+    pollfd descriptors[2] = { { notifyFile, POLLIN, 0 }, { wakeFile, POLLIN, 0 } };
+    std::vector<std::string> changed;
+
+    while (!stopping)
+    {
+        // sleep until a file changes, then keep gathering changes until they settle
+        int ready = poll(descriptors, 2, changed.empty() ? -1 : SETTLE_MILLISECONDS);
+        if (ready < 0 && errno == EINTR) continue;
+        if (ready < 0 || descriptors[1].revents != 0) break;
+
+        if (ready == 0)
+        {
+            Prepare(changed);
+            changed.clear();
+            continue;
+        }
+
+        alignas(inotify_event) char buffer[4096];
+        ssize_t length = read(notifyFile, buffer, sizeof(buffer));
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const inotify_event *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+            if (event->len == 0) continue;
+
+            for (const auto &entry : directories)
+            {
+                if (entry.first != event->wd) continue;
+                std::string file = entry.second + event->name;
+                if (!contains(changed, file)) changed.push_back(file);
+            }
+        }
+    }
+}
+
+#else
+
+bool AssetWatcher::Start() {
+    return false;
+}
+
+void AssetWatcher::Stop() {}
+
+void AssetWatcher::Run() {}
+
+#endif
+
+void AssetWatcher::Prepare(const std::vector<std::string> &changedFiles) {
+    std::vector<ShaderSources> sources;
+    for (size_t s = 0; s < shaders.size(); s++)
+    {
+        const WatchedShader &shader = shaders[s];
+        if (!contains(changedFiles, shader.vertexFile) && !contains(changedFiles, shader.fragmentFile)) continue;
+
+        ShaderSources reloaded = { s, read_text(shader.vertexFile), read_text(shader.fragmentFile) };
+        sources.push_back(reloaded);
+    }
+
+    std::vector<DecodedTexture> decoded;
+    for (size_t t = 0; t < textures.size(); t++)
+    {
+        if (!contains(changedFiles, textures[t].file)) continue;
+
+        MappedFile file(textures[t].file.c_str());
+        int width, height, number_of_components;
+        if (!file.IsOpen() || !stbi_info_from_memory(file.Data(), (int) file.Size(), &width, &height, &number_of_components))
+        {
+            std::cout << "Unable to reload " << textures[t].file << ", keeping the old texture" << std::endl;
+            continue;
+        }
+
+        // decoded into the chain's first level, then filtered down one thread wide so the game
+        // keeps the rest of the cores
+        MipLevelView levels[MAX_MIP_LEVELS];
+        DecodedTexture texture = { t, width, height, count_mip_levels(width, height), std::vector<unsigned char>() };
+        texture.pixels.resize(layout_mip_chain(NULL, width, height, levels));
+
+        int ok = stbi_load_from_memory_into(file.Data(), (int) file.Size(), texture.pixels.data(), width, height, width * STBI_rgb_alpha,
+                                            &width, &height, &number_of_components, STBI_rgb_alpha, false);
+        ImageArena::Reset();
+        if (!ok)
+        {
+            std::cout << "Unable to reload " << textures[t].file << ", keeping the old texture" << std::endl;
+            continue;
+        }
+
+        layout_mip_chain(texture.pixels.data(), width, height, levels);
+        generate_mip_chain(levels, texture.levelCount, MIP_FILTER_BOX, 1);
+        decoded.push_back(std::move(texture));
+    }
+
+    std::lock_guard<std::mutex> lock(readyMutex);
+    for (ShaderSources &shader : sources) readyShaders.push_back(std::move(shader));
+    for (DecodedTexture &texture : decoded) readyTextures.push_back(std::move(texture));
+}
+
+int AssetWatcher::Apply() {
+    std::vector<ShaderSources> sources;
+    std::vector<DecodedTexture> decoded;
+    {
+        std::lock_guard<std::mutex> lock(readyMutex);
+        if (readyShaders.empty() && readyTextures.empty()) return 0;
+        sources.swap(readyShaders);
+        decoded.swap(readyTextures);
+    }
+
+    int applied = 0;
+    for (const ShaderSources &source : sources)
+    {
+        WatchedShader &shader = shaders[source.shader];
+        if (!shader.program->Reload(source.vertex, source.fragment)) continue;
+
+        if (shader.reloaded) shader.reloaded(*shader.program);
+        std::cout << "Reloaded " << shader.vertexFile << " + " << shader.fragmentFile << std::endl;
+        applied++;
+    }
+
+    // the texture keeps its name, so sprites, sheets and tilesets holding it draw the new image
+    for (const DecodedTexture &texture : decoded)
+    {
+        MipLevelView levels[MAX_MIP_LEVELS];
+        layout_mip_chain(const_cast<unsigned char *>(texture.pixels.data()), texture.width, texture.height, levels);
+
+        glBindTexture(GL_TEXTURE_2D, textures[texture.texture].texture);
+        for (int level = 0; level < texture.levelCount; level++)
+        {
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, levels[level].width, levels[level].height, 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, levels[level].pixels);
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, texture.levelCount - 1);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, texture.levelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST);
+
+        std::cout << "Reloaded " << textures[texture.texture].file << std::endl;
+        applied++;
+    }
+
+    return applied;
+}
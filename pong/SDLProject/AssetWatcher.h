@@ -0,0 +1,89 @@
+#pragma once
+
+#ifdef _WINDOWS
+    #include <GL/glew.h>
+#endif
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL_opengl.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "ShaderProgram.h"
+
+// Reloads shaders and textures while the game runs, when their files change on disk.
+// A worker thread waits on inotify for the directories holding the watched files and does the slow
+// part off the game thread: reading shader sources, or decoding a PNG and filtering its mip chain.
+// Apply, called by the game between frames, then swaps the results in: a relinked program under the
+// same ShaderProgram, or new levels under the same texture name, so nothing holding either notices.
+// A file that fails to compile or decode leaves the old one in place. Watching needs Linux; on other
+// systems Start returns false and the game runs as before.
+class AssetWatcher {
+    public:
+
+        AssetWatcher();
+        ~AssetWatcher();
+
+        AssetWatcher(const AssetWatcher &) = delete;
+        AssetWatcher &operator=(const AssetWatcher &) = delete;
+
+        // Before Start. reloaded runs on the game thread after each swap, to set uniforms again.
+        void WatchShader(ShaderProgram &program, const char *vertexShaderFile, const char *fragmentShaderFile,
+                         std::function<void(ShaderProgram &)> reloaded = nullptr);
+        void WatchTexture(GLuint texture, const char *imageFile);
+
+        bool Start();
+        void Stop();
+
+        // Game thread, between frames: swaps in whatever the worker has finished. Returns how many
+        // assets changed.
+        int Apply();
+
+    private:
+
+        struct WatchedShader {
+            ShaderProgram *program;
+            std::string vertexFile;
+            std::string fragmentFile;
+            std::function<void(ShaderProgram &)> reloaded;
+        };
+
+        struct WatchedTexture {
+            GLuint texture;
+            std::string file;
+        };
+
+        struct ShaderSources {
+            size_t shader;
+            std::string vertex;
+            std::string fragment;
+        };
+
+        struct DecodedTexture {
+            size_t texture;
+            int width;
+            int height;
+            int levelCount;
+            std::vector<unsigned char> pixels;   // the whole mip chain, laid out by layout_mip_chain
+        };
+
+        void Run();
+        void Prepare(const std::vector<std::string> &changedFiles);
+
+        std::vector<WatchedShader> shaders;
+        std::vector<WatchedTexture> textures;
+        std::vector<std::pair<int, std::string>> directories;   // inotify watch, and the prefix of its files
+
+        std::thread worker;
+        std::atomic<bool> stopping;
+        int notifyFile;   // the inotify descriptor
+        int wakeFile;     // an eventfd Stop signals, so the worker need not poll
+
+        // filled by the worker, emptied by Apply
+        std::mutex readyMutex;
+        std::vector<ShaderSources> readyShaders;
+        std::vector<DecodedTexture> readyTextures;
+};
@@ -0,0 +1,281 @@
+#include "AudioMixer.h"
+#include "glm/detail/_lanes.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    typedef glm::detail::lanes<glm::detail::widest_float_lanes> W;
+
+    // zeros after each sound, enough for one vector load starting on its last sample
+    const size_t SOUND_PADDING = 8;
+
+    const float QUARTER_PI = 0.785398163f;
+    const double TWO_PI = 6.283185307179586;
+
+    // left += samples * (startLeft + stepLeft * ramp), and the same for right, for count frames
+    // rounded up to whole vectors; past the end of a sound the samples are padding zeros
+    void mix_voice(const float *samples, const float *ramp, float *left, float *right, int count,
+                   float startLeft, float stepLeft, float startRight, float stepRight)
+    {
+        const W::type leftStart = W::set1(startLeft), leftStep = W::set1(stepLeft);
+        const W::type rightStart = W::set1(startRight), rightStep = W::set1(stepRight);
+
+        for (int i = 0; i < count; i += W::width)
+        {
+            W::type sample = W::load(samples + i), steps = W::load(ramp + i);
+            W::store(left + i, W::fma(sample, W::fma(steps, leftStep, leftStart), W::load(left + i)));
+            W::store(right + i, W::fma(sample, W::fma(steps, rightStep, rightStart), W::load(right + i)));
+        }
+    }
+
+    // equal-power: the sum of the squared gains holds at gain^2 across the field
+    void pan_gains(float gain, float pan, float gains[2])
+    {
+        float angle = (std::min(std::max(pan, -1.0f), 1.0f) + 1.0f) * QUARTER_PI;
+        gains[0] = gain * std::cos(angle);
+        gains[1] = gain * std::sin(angle);
+    }
+}
+
+std::vector<float> synthesize_tone(int sampleRate, float startHz, float endHz, float seconds, float gain)
+{
+    std::vector<float> tone(size_t(seconds * sampleRate));
+
+    // the phase integrates the sweeping frequency so the pitch glides without jumps
+    double phase = 0.0;
+    for (size_t i = 0; i < tone.size(); i++)
+    {
+        double t = double(i) / tone.size();
+        double frequency = startHz + (endHz - startHz) * t;
+        tone[i] = float(gain * std::sin(phase) * std::exp(-5.0 * t));
+        phase += TWO_PI * frequency / sampleRate;
+    }
+
+    return tone;
+}
+
+AudioMixer::AudioMixer()
+    : commandHead(0), commandTail(0), nextVoice(NO_VOICE), voiceCount(0), device(0), sampleRate(0), bufferFrames(0),
+      callbacks(0), lateCallbacks(0), totalTicks(0), maxTicks(0), droppedCommands(0), droppedVoices(0) {
+    for (int i = 0; i < MIX_BLOCK_FRAMES + 8; i++) rampSteps[i] = float(i + 1);
+}
+
+AudioMixer::~AudioMixer() {
+    Close();
+}
+
+SoundID AudioMixer::Load(const float *samples, size_t frames) {
+    Sound sound = { this->samples.size(), frames };
+    this->samples.insert(this->samples.end(), samples, samples + frames);
+    this->samples.resize(this->samples.size() + SOUND_PADDING, 0.0f);
+
+    sounds.push_back(sound);
+    return SoundID(sounds.size() - 1);
+}
+
+bool AudioMixer::Open(int sampleRate, int bufferFrames) {
+    SDL_AudioSpec wanted, obtained;
+    SDL_memset(&wanted, 0, sizeof(wanted));
+    wanted.freq = sampleRate;
+    wanted.format = AUDIO_F32SYS;
+    wanted.channels = 2;
+    wanted.samples = Uint16(bufferFrames);
+    wanted.callback = Callback;
+    wanted.userdata = this;
+
+    // only the buffer size may change; SDL converts anything else, so Mix always writes float stereo
+    device = SDL_OpenAudioDevice(NULL, 0, &wanted, &obtained, SDL_AUDIO_ALLOW_SAMPLES_CHANGE);
+    if (device == 0) return false;
+
+    this->sampleRate = obtained.freq;
+    this->bufferFrames = obtained.samples;
+    SDL_PauseAudioDevice(device, 0);
+    return true;
+}
+
+void AudioMixer::Close() {
+    if (device != 0) SDL_CloseAudioDevice(device);
+    device = 0;
+}
+
+bool AudioMixer::Push(const Command &command) {
+    uint32_t head = commandHead.load(std::memory_order_relaxed);
+    if (head - commandTail.load(std::memory_order_acquire) == COMMAND_CAPACITY)
+    {
+        droppedCommands.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // the slot is written before the release store publishes it
+    commands[head & (COMMAND_CAPACITY - 1)] = command;
+    commandHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+VoiceID AudioMixer::Play(SoundID sound, float gain, float pan, bool loop) {
+    if (++nextVoice == NO_VOICE) ++nextVoice;
+
+    Command command = { COMMAND_PLAY, loop, sound, nextVoice, gain, pan };
+    return Push(command) ? nextVoice : NO_VOICE;
+}
+
+void AudioMixer::SetVoice(VoiceID voice, float gain, float pan) {
+    Command command = { COMMAND_SET, false, 0, voice, gain, pan };
+    Push(command);
+}
+
+void AudioMixer::Stop(VoiceID voice) {
+    Command command = { COMMAND_STOP, false, 0, voice, 0.0f, 0.0f };
+    Push(command);
+}
+
+int AudioMixer::FindVoice(VoiceID voice) const {
+    for (int v = 0; v < voiceCount; v++)
+    {
+        if (voiceIDs[v] == voice) return v;
+    }
+    return -1;
+}
+
+void AudioMixer::ApplyCommands() {
+    uint32_t tail = commandTail.load(std::memory_order_relaxed);
+    uint32_t head = commandHead.load(std::memory_order_acquire);
+
+    for (; tail != head; tail++)
+    {
+        const Command &command = commands[tail & (COMMAND_CAPACITY - 1)];
+
+        if (command.type == COMMAND_PLAY)
+        {
+            if (voiceCount == MAX_VOICES || command.sound >= sounds.size())
+            {
+                droppedVoices.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            // a new voice starts silent and ramps up to its gain over the first block
+            int v = voiceCount++;
+            voiceIDs[v] = command.voice;
+            voiceSounds[v] = command.sound;
+            voicePositions[v] = 0;
+            voiceLoops[v] = command.loop;
+            voiceStopping[v] = false;
+            voiceGains[v][0] = voiceGains[v][1] = 0.0f;
+            pan_gains(command.gain, command.pan, voiceTargets[v]);
+            continue;
+        }
+
+        int v = FindVoice(command.voice);
+        if (v < 0) continue;
+
+        if (command.type == COMMAND_SET)
+        {
+            pan_gains(command.gain, command.pan, voiceTargets[v]);
+        }
+        else
+        {
+            // ramped down, then removed
+            voiceTargets[v][0] = voiceTargets[v][1] = 0.0f;
+            voiceStopping[v] = true;
+        }
+    }
+
+    commandTail.store(tail, std::memory_order_release);
+}
+
+void AudioMixer::MixBlock(float *out, int frames) {
+    const int padded = frames + 8;
+    std::fill(left, left + padded, 0.0f);
+    std::fill(right, right + padded, 0.0f);
+
+    // the ramp reaches the target on the block's last frame
+    const float inverseFrames = 1.0f / frames;
+
+    for (int v = 0; v < voiceCount;)
+    {
+        const Sound &sound = sounds[voiceSounds[v]];
+        float *gains = voiceGains[v], *targets = voiceTargets[v];
+        float stepLeft = (targets[0] - gains[0]) * inverseFrames, stepRight = (targets[1] - gains[1]) * inverseFrames;
+
+        // a looping voice wraps as often as the block needs; any other stops at the sound's end
+        int done = 0;
+        while (done < frames && voicePositions[v] < sound.frames)
+        {
+            int count = int(std::min<size_t>(frames - done, sound.frames - voicePositions[v]));
+            mix_voice(&samples[sound.first + voicePositions[v]], rampSteps + done, left + done, right + done, count,
+                      gains[0], stepLeft, gains[1], stepRight);
+
+            done += count;
+            voicePositions[v] += count;
+            if (voiceLoops[v] && voicePositions[v] == sound.frames) voicePositions[v] = 0;
+        }
+
+        gains[0] = targets[0];
+        gains[1] = targets[1];
+
+        // finished voices give their slot to the last one
+        if (voicePositions[v] >= sound.frames || voiceStopping[v])
+        {
+            int last = --voiceCount;
+            voiceIDs[v] = voiceIDs[last];
+            voiceSounds[v] = voiceSounds[last];
+            voicePositions[v] = voicePositions[last];
+            voiceLoops[v] = voiceLoops[last];
+            voiceStopping[v] = voiceStopping[last];
+            std::copy(voiceGains[last], voiceGains[last] + 2, voiceGains[v]);
+            std::copy(voiceTargets[last], voiceTargets[last] + 2, voiceTargets[v]);
+            continue;
+        }
+
+        v++;
+    }
+
+    for (int i = 0; i < frames; i++)
+    {
+        out[i * 2]     = std::min(std::max(left[i], -1.0f), 1.0f);
+        out[i * 2 + 1] = std::min(std::max(right[i], -1.0f), 1.0f);
+    }
+}
+
+void AudioMixer::Mix(float *out, int frames) {
+    ApplyCommands();
+
+    for (int first = 0; first < frames; first += MIX_BLOCK_FRAMES)
+    {
+        MixBlock(out + first * 2, std::min(frames - first, MIX_BLOCK_FRAMES));
+    }
+}
+
+void AudioMixer::Callback(void *userdata, Uint8 *stream, int length) {
+    AudioMixer *mixer = static_cast<AudioMixer *>(userdata);
+    int frames = length / int(2 * sizeof(float));
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    mixer->Mix(reinterpret_cast<float *>(stream), frames);
+    Uint64 ticks = SDL_GetPerformanceCounter() - start;
+
+    // one thread writes these, so plain load-and-store is enough for the maximum
+    mixer->callbacks.fetch_add(1, std::memory_order_relaxed);
+    mixer->totalTicks.fetch_add(ticks, std::memory_order_relaxed);
+    if (ticks > mixer->maxTicks.load(std::memory_order_relaxed)) mixer->maxTicks.store(ticks, std::memory_order_relaxed);
+    if (double(ticks) / SDL_GetPerformanceFrequency() > double(frames) / mixer->sampleRate)
+    {
+        mixer->lateCallbacks.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+MixerStats AudioMixer::Stats() const {
+    const double microsecondsPerTick = 1e6 / double(SDL_GetPerformanceFrequency());
+
+    MixerStats stats;
+    stats.callbacks = callbacks.load(std::memory_order_relaxed);
+    stats.lateCallbacks = lateCallbacks.load(std::memory_order_relaxed);
+    stats.meanMicroseconds = stats.callbacks ? totalTicks.load(std::memory_order_relaxed) * microsecondsPerTick / stats.callbacks : 0.0;
+    stats.maxMicroseconds = maxTicks.load(std::memory_order_relaxed) * microsecondsPerTick;
+    stats.budgetMicroseconds = sampleRate ? 1e6 * bufferFrames / sampleRate : 0.0;
+    stats.droppedCommands = droppedCommands.load(std::memory_order_relaxed);
+    stats.droppedVoices = droppedVoices.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <SDL.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+const int MAX_VOICES = 256;
+
+// Frames mixed in one go; longer callbacks are mixed a block at a time, and gain changes ramp
+// across one block.
+const int MIX_BLOCK_FRAMES = 256;
+
+typedef uint16_t SoundID;
+typedef uint32_t VoiceID;
+
+const VoiceID NO_VOICE = 0;
+
+// Counters kept by the audio thread. A late callback took longer to mix than its buffer lasts to
+// play, so the device ran dry waiting for it: an underrun the player hears as a crackle.
+struct MixerStats {
+    uint64_t callbacks;
+    uint64_t lateCallbacks;
+    double   meanMicroseconds;
+    double   maxMicroseconds;
+    double   budgetMicroseconds;   // how long one callback's buffer plays for
+    uint64_t droppedCommands;      // the queue was full when the game sent them
+    uint64_t droppedVoices;        // asked to play with every voice already sounding
+};
+
+// Mono PCM of a sine sweeping from startHz to endHz over seconds, fading out exponentially: the
+// games' effects, made at load time instead of shipped as files.
+std::vector<float> synthesize_tone(int sampleRate, float startHz, float endHz, float seconds, float gain = 0.5f);
+
+// Plays preloaded mono sounds on up to MAX_VOICES voices through an SDL audio device, mixed into
+// stereo with a gain and an equal-power pan per voice.
+// The game thread talks to the audio callback only through a single-producer, single-consumer queue
+// of commands, so Play never waits on the callback and a sound starts within one buffer of the frame
+// that asked for it. Voices are mixed with glm's widest float lanes, and every gain change (starting,
+// stopping, SetVoice) ramps over one mix block instead of jumping, so nothing clicks.
+class AudioMixer {
+    public:
+
+        AudioMixer();
+        ~AudioMixer();
+
+        AudioMixer(const AudioMixer &) = delete;
+        AudioMixer &operator=(const AudioMixer &) = delete;
+
+        // Copies frames of mono float PCM at the device's rate. Every sound must be loaded before
+        // Open: the callback reads them without a lock.
+        SoundID Load(const float *samples, size_t frames);
+
+        // Opens the default device for 32-bit float stereo, asking for bufferFrames per callback:
+        // 64 to 512, fewer for lower latency at the cost of more callbacks. SDL's audio subsystem must
+        // be initialised. False, with SDL_GetError set, when no device opens.
+        bool Open(int sampleRate, int bufferFrames);
+        void Close();
+
+        int SampleRate() const { return sampleRate; }
+        int BufferFrames() const { return bufferFrames; }
+
+        // Game thread only: each call queues a command the next callback applies before mixing.
+        // pan runs from -1 (left) to 1 (right). Play returns NO_VOICE when the queue is full.
+        VoiceID Play(SoundID sound, float gain = 1.0f, float pan = 0.0f, bool loop = false);
+        void SetVoice(VoiceID voice, float gain, float pan);
+        void Stop(VoiceID voice);
+
+        // Mixes frames of interleaved stereo into out. The device callback runs this; it is public so
+        // a tool can drive the mixer without a device.
+        void Mix(float *out, int frames);
+
+        MixerStats Stats() const;
+
+    private:
+
+        enum CommandType : uint8_t {
+            COMMAND_PLAY,
+            COMMAND_SET,
+            COMMAND_STOP,
+        };
+
+        struct Command {
+            CommandType type;
+            bool loop;
+            SoundID sound;
+            VoiceID voice;
+            float gain;
+            float pan;
+        };
+
+        // a power of two, so the indices wrap with a mask
+        static const uint32_t COMMAND_CAPACITY = 1024;
+
+        struct Sound {
+            size_t first;    // into samples
+            size_t frames;
+        };
+
+        static void Callback(void *userdata, Uint8 *stream, int length);
+
+        bool Push(const Command &command);
+        void ApplyCommands();
+        int FindVoice(VoiceID voice) const;
+        void MixBlock(float *out, int frames);
+
+        // every sound back to back, each followed by zeros for the vector loads that run past its end
+        std::vector<float> samples;
+        std::vector<Sound> sounds;
+
+        Command commands[COMMAND_CAPACITY];
+        std::atomic<uint32_t> commandHead;   // written by the game thread
+        std::atomic<uint32_t> commandTail;   // written by the audio thread
+        VoiceID nextVoice;
+
+        // sounding voices, packed at the front; the audio thread owns all of these
+        int voiceCount;
+        VoiceID voiceIDs[MAX_VOICES];
+        SoundID voiceSounds[MAX_VOICES];
+        size_t voicePositions[MAX_VOICES];
+        bool voiceLoops[MAX_VOICES];
+        bool voiceStopping[MAX_VOICES];
+        float voiceGains[MAX_VOICES][2];      // left and right, where the last block ended
+        float voiceTargets[MAX_VOICES][2];
+
+        // planar accumulators and 1, 2, 3, ... for the ramps, padded for the last vector
+        float left[MIX_BLOCK_FRAMES + 8];
+        float right[MIX_BLOCK_FRAMES + 8];
+        float rampSteps[MIX_BLOCK_FRAMES + 8];
+
+        SDL_AudioDeviceID device;
+        int sampleRate;
+        int bufferFrames;
+
+        std::atomic<uint64_t> callbacks;
+        std::atomic<uint64_t> lateCallbacks;
+        std::atomic<uint64_t> totalTicks;
+        std::atomic<uint64_t> maxTicks;
+        std::atomic<uint64_t> droppedCommands;
+        std::atomic<uint64_t> droppedVoices;
+};
@@ -0,0 +1,137 @@
+#include "ImageArena.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+const size_t ARENA_ALIGNMENT  = 16;
+const size_t MIN_CHUNK_SIZE   = 1 << 20;
+
+struct alignas(16) ArenaChunk {
+    ArenaChunk *previous;
+    size_t      capacity;
+    size_t      used;
+    
+    unsigned char *Data() { return reinterpret_cast<unsigned char *>(this) + sizeof(ArenaChunk); }
+};
+
+size_t align_up(size_t size) { return (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1); }
+
+struct ArenaState {
+    ArenaChunk *head       = nullptr;
+    void       *lastBlock  = nullptr;  // most recent allocation, the only one that can grow in place
+    size_t      bytesInUse = 0;
+    size_t      highWater  = 0;
+    
+    ~ArenaState() { Release(); }
+    
+    void Release() {
+        while (head != nullptr) {
+            ArenaChunk *previous = head->previous;
+            free(head);
+            head = previous;
+        }
+    }
+    
+    ArenaChunk *Grow(size_t size) {
+        size_t capacity = MIN_CHUNK_SIZE;
+        if (head != nullptr && head->capacity * 2 > capacity) capacity = head->capacity * 2;
+        if (size > capacity) capacity = align_up(size);
+        
+        ArenaChunk *chunk = static_cast<ArenaChunk *>(malloc(sizeof(ArenaChunk) + capacity));
+        if (chunk == nullptr) return nullptr;
+        
+        chunk->previous = head;
+        chunk->capacity = capacity;
+        chunk->used     = 0;
+        head = chunk;
+        return chunk;
+    }
+    
+    void Account(size_t delta) {
+        bytesInUse += delta;
+        if (bytesInUse > highWater) highWater = bytesInUse;
+    }
+};
+
+static_assert(sizeof(ArenaChunk) % ARENA_ALIGNMENT == 0, "chunk header must keep payloads aligned");
+
+thread_local ArenaState g_arena;
+
+}
+
+void *ImageArena::Allocate(size_t size) {
+    size_t aligned = align_up(size == 0 ? 1 : size);
+    
+    ArenaChunk *chunk = g_arena.head;
+    if (chunk == nullptr || chunk->capacity - chunk->used < aligned) {
+        chunk = g_arena.Grow(aligned);
+        if (chunk == nullptr) return nullptr;
+    }
+    
+    void *block = chunk->Data() + chunk->used;
+    chunk->used += aligned;
+    g_arena.lastBlock = block;
+    g_arena.Account(aligned);
+    
+    return block;
+}
+
+void *ImageArena::Reallocate(void *block, size_t oldSize, size_t newSize) {
+    if (block == nullptr) return Allocate(newSize);
+    
+    // zlib output and PNG IDAT buffers grow by doubling right after being allocated, so the block
+    // being resized is usually the top of the current chunk and can be extended without copying.
+    ArenaChunk *chunk = g_arena.head;
+    if (block == g_arena.lastBlock) {
+        size_t offset     = static_cast<unsigned char *>(block) - chunk->Data();
+        size_t oldAligned = chunk->used - offset;
+        size_t newAligned = align_up(newSize);
+        
+        if (offset + newAligned <= chunk->capacity) {
+            chunk->used = offset + newAligned;
+            if (newAligned > oldAligned) g_arena.Account(newAligned - oldAligned);
+            else                         g_arena.bytesInUse -= oldAligned - newAligned;
+            return block;
+        }
+    }
+    
+    void *moved = Allocate(newSize);
+    if (moved == nullptr) return nullptr;
+    
+    memcpy(moved, block, oldSize < newSize ? oldSize : newSize);
+    return moved;
+}
+
+void ImageArena::Free(void *block) {
+    // Individual frees are no-ops except for the most recent block, which is simply popped.
+    if (block == nullptr || block != g_arena.lastBlock) return;
+    
+    ArenaChunk *chunk = g_arena.head;
+    size_t offset = static_cast<unsigned char *>(block) - chunk->Data();
+    g_arena.bytesInUse -= chunk->used - offset;
+    chunk->used = offset;
+    g_arena.lastBlock = nullptr;
+}
+
+void ImageArena::Reset() {
+    ArenaChunk *head = g_arena.head;
+    
+    // If the last decode spilled over several chunks, fold them into a single chunk big enough
+    // for the largest decode seen so far so the next one never leaves the fast path.
+    if (head != nullptr && head->previous != nullptr) {
+        g_arena.Release();
+        g_arena.Grow(g_arena.highWater);
+    }
+    else if (head != nullptr) {
+        head->used = 0;
+    }
+    
+    g_arena.lastBlock  = nullptr;
+    g_arena.bytesInUse = 0;
+}
+
+size_t ImageArena::BytesInUse() { return g_arena.bytesInUse; }
+
+size_t ImageArena::HighWaterMark() { return g_arena.highWater; }
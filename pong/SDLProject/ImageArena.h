@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+// Thread-local bump allocator backing stb_image's STBI_MALLOC / STBI_REALLOC_SIZED / STBI_FREE hooks.
+// Every transient buffer of a decode (zlib output, per-component planes, format conversion) comes
+// out of one contiguous block, so nothing is returned to libc until Reset() is called once the
+// decoded pixels have been uploaded to the GPU.
+class ImageArena {
+    public:
+    
+        static void *Allocate(size_t size);
+        static void *Reallocate(void *block, size_t oldSize, size_t newSize);
+        static void Free(void *block);
+    
+        // Releases every allocation made on this thread since the last reset. Pointers handed out by
+        // stbi_load* are invalid afterwards.
+        static void Reset();
+    
+        static size_t BytesInUse();
+        static size_t HighWaterMark();
+};
@@ -0,0 +1,115 @@
+#include "MappedFile.h"
+
+#ifdef _WINDOWS
+    #include <cstdio>
+    #include <cstdlib>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : data(nullptr), size(0), isOpen(false), isMapped(false) {}
+
+MappedFile::MappedFile(const char *filePath) : MappedFile() {
+    Open(filePath);
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+#ifdef _WINDOWS
+
+bool MappedFile::Open(const char *filePath) {
+    Close();
+    
+    FILE *file = fopen(filePath, "rb");
+    if (file == nullptr) return false;
+    
+    // ftell reports -1 on failure, which must not become a huge size on an open file
+    long length = fseek(file, 0, SEEK_END) == 0 ? ftell(file) : -1;
+    if (length < 0 || fseek(file, 0, SEEK_SET) != 0) {
+        fclose(file);
+        return false;
+    }
+    
+    unsigned char *contents = length > 0 ? static_cast<unsigned char *>(malloc(length)) : nullptr;
+    if (length > 0 && (contents == nullptr || fread(contents, 1, length, file) != (size_t) length)) {
+        free(contents);
+        fclose(file);
+        return false;
+    }
+    fclose(file);
+    
+    data   = contents;
+    size   = (size_t) length;
+    isOpen = true;
+    return true;
+}
+
+void MappedFile::Close() {
+    free(const_cast<unsigned char *>(data));
+    
+    data   = nullptr;
+    size   = 0;
+    isOpen = false;
+}
+
+#else
+
+bool MappedFile::Open(const char *filePath) {
+    Close();
+    
+    int descriptor = open(filePath, O_RDONLY);
+    if (descriptor < 0) return false;
+    
+    struct stat status;
+    if (fstat(descriptor, &status) != 0) {
+        close(descriptor);
+        return false;
+    }
+    
+    size   = (size_t) status.st_size;
+    isOpen = true;
+    
+    // mmap rejects zero-length mappings; an empty file is still a successfully opened file
+    if (size == 0) {
+        close(descriptor);
+        return true;
+    }
+    
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    // every asset is consumed front to back immediately, so prefault the whole range up front
+    flags |= MAP_POPULATE;
+#endif
+    
+    void *mapping = mmap(nullptr, size, PROT_READ, flags, descriptor, 0);
+    close(descriptor);
+    
+    if (mapping == MAP_FAILED) {
+        size   = 0;
+        isOpen = false;
+        return false;
+    }
+    
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    madvise(mapping, size, MADV_WILLNEED);
+    
+    data     = static_cast<const unsigned char *>(mapping);
+    isMapped = true;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (isMapped) munmap(const_cast<unsigned char *>(data), size);
+    
+    data     = nullptr;
+    size     = 0;
+    isOpen   = false;
+    isMapped = false;
+}
+
+#endif
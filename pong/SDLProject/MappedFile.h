@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+
+// Read-only view of a whole file. On POSIX systems the file is memory-mapped, so consumers such as
+// stbi_load_from_memory and glShaderSource read straight out of the page cache instead of going
+// through stdio buffers; elsewhere the contents are read into a single heap block.
+class MappedFile {
+    public:
+    
+        MappedFile();
+        explicit MappedFile(const char *filePath);
+        ~MappedFile();
+    
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+    
+        bool Open(const char *filePath);
+        void Close();
+    
+        bool IsOpen() const { return isOpen; }
+        const unsigned char *Data() const { return data; }
+        size_t Size() const { return size; }
+    
+    private:
+    
+        const unsigned char *data;
+        size_t size;
+        bool isOpen;
+        bool isMapped;
+};
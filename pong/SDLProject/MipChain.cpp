@@ -0,0 +1,289 @@
+#include "MipChain.h"
+#include "glm/gtc/color_space.hpp"
+#include "glm/gtc/constants.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int   RGBA_COMPONENTS      = 4;
+const int   LINEAR_TABLE_SIZE    = 4096;
+const int   KAISER_TAPS          = 8;
+const float KAISER_BETA          = 4.0f;
+const float KAISER_SUPPORT       = KAISER_TAPS / 2;
+const float MIN_ALPHA            = 1.0f / 512.0f;
+const int   MIN_ROWS_PER_THREAD  = 32;
+
+float         g_srgb_to_linear[256];
+unsigned char g_linear_to_srgb[LINEAR_TABLE_SIZE];
+float         g_kaiser_weights[KAISER_TAPS];
+std::once_flag g_tables_built;
+
+double bessel_i0(double x) {
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 32; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum  += term;
+    }
+    return sum;
+}
+
+void build_tables() {
+    for (int i = 0; i < 256; i++) {
+        g_srgb_to_linear[i] = glm::convertSRGBToLinear(glm::vec3(i / 255.0f)).x;
+    }
+    for (int i = 0; i < LINEAR_TABLE_SIZE; i++) {
+        float encoded = glm::convertLinearToSRGB(glm::vec3(i / float(LINEAR_TABLE_SIZE - 1))).x;
+        g_linear_to_srgb[i] = (unsigned char) (encoded * 255.0f + 0.5f);
+    }
+    
+    // a 2:1 reduction samples source texels at half-texel offsets -3.5 .. 3.5 from the output centre
+    float total = 0.0f;
+    for (int i = 0; i < KAISER_TAPS; i++) {
+        double distance = i + 0.5 - KAISER_SUPPORT;
+        double phase    = glm::pi<double>() * distance / 2.0;
+        double sinc     = std::sin(phase) / phase;
+        double window   = bessel_i0(KAISER_BETA * std::sqrt(1.0 - (distance / KAISER_SUPPORT) * (distance / KAISER_SUPPORT))) / bessel_i0(KAISER_BETA);
+        g_kaiser_weights[i] = (float) (sinc * window);
+        total += g_kaiser_weights[i];
+    }
+    for (float &weight : g_kaiser_weights) weight /= total;
+}
+
+// Four-float RGBA accumulator, one SSE register per pixel when available.
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+typedef __m128 Pixel;
+inline Pixel pixel_load(const float *p)                   { return _mm_loadu_ps(p); }
+inline void  pixel_store(float *p, Pixel v)               { _mm_storeu_ps(p, v); }
+inline Pixel pixel_zero()                                 { return _mm_setzero_ps(); }
+inline Pixel pixel_add(Pixel a, Pixel b)                  { return _mm_add_ps(a, b); }
+inline Pixel pixel_scale(Pixel a, float s)                { return _mm_mul_ps(a, _mm_set1_ps(s)); }
+inline Pixel pixel_madd(Pixel sum, Pixel a, float s)      { return _mm_add_ps(sum, _mm_mul_ps(a, _mm_set1_ps(s))); }
+#else
+struct Pixel { float v[4]; };
+inline Pixel pixel_load(const float *p)                   { Pixel r = { { p[0], p[1], p[2], p[3] } }; return r; }
+inline void  pixel_store(float *p, Pixel a)               { for (int c = 0; c < 4; c++) p[c] = a.v[c]; }
+inline Pixel pixel_zero()                                 { Pixel r = { { 0.0f, 0.0f, 0.0f, 0.0f } }; return r; }
+inline Pixel pixel_add(Pixel a, Pixel b)                  { for (int c = 0; c < 4; c++) a.v[c] += b.v[c]; return a; }
+inline Pixel pixel_scale(Pixel a, float s)                { for (int c = 0; c < 4; c++) a.v[c] *= s; return a; }
+inline Pixel pixel_madd(Pixel sum, Pixel a, float s)      { for (int c = 0; c < 4; c++) sum.v[c] += a.v[c] * s; return sum; }
+#endif
+
+// A level held as premultiplied linear RGBA floats; filtering reads and writes these so rounding
+// to 8 bits happens once per level rather than compounding down the chain.
+struct LinearLevel {
+    std::vector<float> texels;
+    int width;
+    int height;
+    
+    const float *Texel(int x, int y) const { return &texels[((size_t) y * width + x) * RGBA_COMPONENTS]; }
+    float *Texel(int x, int y) { return &texels[((size_t) y * width + x) * RGBA_COMPONENTS]; }
+};
+
+// Holds each worker until all of them have arrived, so no pass reads rows another is still writing.
+class Barrier {
+    public:
+    
+        explicit Barrier(int count) : count(count), waiting(0), generation(0) {}
+    
+        void Wait() {
+            std::unique_lock<std::mutex> lock(mutex);
+            int arrived = generation;
+            if (++waiting == count) {
+                waiting = 0;
+                generation++;
+                condition.notify_all();
+                return;
+            }
+            condition.wait(lock, [&] { return generation != arrived; });
+        }
+    
+    private:
+    
+        std::mutex mutex;
+        std::condition_variable condition;
+        int count;
+        int waiting;
+        int generation;
+};
+
+void decode_rows(const MipLevelView &view, LinearLevel &level, int begin, int end) {
+    for (int y = begin; y < end; y++) {
+        const unsigned char *source = view.pixels + (size_t) y * view.width * RGBA_COMPONENTS;
+        for (int x = 0; x < view.width; x++, source += RGBA_COMPONENTS) {
+            float alpha = source[3] / 255.0f;
+            float *texel = level.Texel(x, y);
+            texel[0] = g_srgb_to_linear[source[0]] * alpha;
+            texel[1] = g_srgb_to_linear[source[1]] * alpha;
+            texel[2] = g_srgb_to_linear[source[2]] * alpha;
+            texel[3] = alpha;
+        }
+    }
+}
+
+unsigned char encode_linear(float value) {
+    value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+    return g_linear_to_srgb[(int) (value * (LINEAR_TABLE_SIZE - 1) + 0.5f)];
+}
+
+void encode_rows(const LinearLevel &level, const MipLevelView &view, int begin, int end) {
+    for (int y = begin; y < end; y++) {
+        unsigned char *destination = view.pixels + (size_t) y * view.width * RGBA_COMPONENTS;
+        for (int x = 0; x < view.width; x++, destination += RGBA_COMPONENTS) {
+            const float *texel = level.Texel(x, y);
+            float alpha = texel[3] < 0.0f ? 0.0f : (texel[3] > 1.0f ? 1.0f : texel[3]);
+            float inverse = alpha > MIN_ALPHA ? 1.0f / alpha : 0.0f;
+            destination[0] = encode_linear(texel[0] * inverse);
+            destination[1] = encode_linear(texel[1] * inverse);
+            destination[2] = encode_linear(texel[2] * inverse);
+            destination[3] = (unsigned char) (alpha * 255.0f + 0.5f);
+        }
+    }
+}
+
+void box_rows(const LinearLevel &source, LinearLevel &level, int begin, int end) {
+    for (int y = begin; y < end; y++) {
+        const float *row0 = source.Texel(0, std::min(2 * y, source.height - 1));
+        const float *row1 = source.Texel(0, std::min(2 * y + 1, source.height - 1));
+        int x = 0;
+        
+#if GLM_ARCH & GLM_ARCH_AVX_BIT
+        // two output texels per iteration: [s0 s1] [s2 s3] from each row, folded pairwise
+        for (; x + 1 < level.width && 2 * x + 3 < source.width; x += 2) {
+            __m256 a = _mm256_add_ps(_mm256_loadu_ps(row0 + 8 * x),     _mm256_loadu_ps(row1 + 8 * x));
+            __m256 b = _mm256_add_ps(_mm256_loadu_ps(row0 + 8 * x + 8), _mm256_loadu_ps(row1 + 8 * x + 8));
+            __m256 sum = _mm256_add_ps(_mm256_permute2f128_ps(a, b, 0x20), _mm256_permute2f128_ps(a, b, 0x31));
+            _mm256_storeu_ps(level.Texel(x, y), _mm256_mul_ps(sum, _mm256_set1_ps(0.25f)));
+        }
+#endif
+        for (; x < level.width; x++) {
+            int x0 = 2 * x * RGBA_COMPONENTS;
+            int x1 = std::min(2 * x + 1, source.width - 1) * RGBA_COMPONENTS;
+            Pixel sum = pixel_add(pixel_add(pixel_load(row0 + x0), pixel_load(row0 + x1)),
+                                  pixel_add(pixel_load(row1 + x0), pixel_load(row1 + x1)));
+            pixel_store(level.Texel(x, y), pixel_scale(sum, 0.25f));
+        }
+    }
+}
+
+// Separable Kaiser: horizontal pass into a scratch level of the source height, then vertical.
+void kaiser_horizontal_rows(const LinearLevel &source, LinearLevel &scratch, int begin, int end) {
+    for (int y = begin; y < end; y++) {
+        for (int x = 0; x < scratch.width; x++) {
+            Pixel sum = pixel_zero();
+            for (int t = 0; t < KAISER_TAPS; t++) {
+                int sx = std::min(std::max(2 * x + 1 - (int) KAISER_SUPPORT + t, 0), source.width - 1);
+                sum = pixel_madd(sum, pixel_load(source.Texel(sx, y)), g_kaiser_weights[t]);
+            }
+            pixel_store(scratch.Texel(x, y), sum);
+        }
+    }
+}
+
+void kaiser_vertical_rows(const LinearLevel &scratch, LinearLevel &level, int begin, int end) {
+    for (int y = begin; y < end; y++) {
+        for (int x = 0; x < level.width; x++) {
+            Pixel sum = pixel_zero();
+            for (int t = 0; t < KAISER_TAPS; t++) {
+                int sy = std::min(std::max(2 * y + 1 - (int) KAISER_SUPPORT + t, 0), scratch.height - 1);
+                sum = pixel_madd(sum, pixel_load(scratch.Texel(x, sy)), g_kaiser_weights[t]);
+            }
+            pixel_store(level.Texel(x, y), sum);
+        }
+    }
+}
+
+}
+
+int count_mip_levels(int width, int height) {
+    int levels = 1;
+    while ((width > 1 || height > 1) && levels < MAX_MIP_LEVELS) {
+        width  = width  > 1 ? width  / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+        levels++;
+    }
+    return levels;
+}
+
+size_t layout_mip_chain(unsigned char *base, int width, int height, MipLevelView *levels) {
+    int count = count_mip_levels(width, height);
+    size_t offset = 0;
+    
+    for (int i = 0; i < count; i++) {
+        levels[i].pixels = base + offset;
+        levels[i].width  = width;
+        levels[i].height = height;
+        offset += (size_t) width * height * RGBA_COMPONENTS;
+        
+        width  = width  > 1 ? width  / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return offset;
+}
+
+void generate_mip_chain(MipLevelView *levels, int level_count, MipFilter filter, int thread_count) {
+    if (level_count < 2) return;
+    std::call_once(g_tables_built, build_tables);
+    
+    if (thread_count <= 0) thread_count = std::max(1u, std::thread::hardware_concurrency());
+    
+    // every level in linear light, sized up front so the workers never resize anything; the Kaiser
+    // filter also keeps each level's horizontal pass, as wide as the level and as tall as its source
+    std::vector<LinearLevel> linear(level_count), scratch(filter == MIP_FILTER_KAISER ? level_count : 0);
+    for (int i = 0; i < level_count; i++) {
+        linear[i].width  = levels[i].width;
+        linear[i].height = levels[i].height;
+        linear[i].texels.resize((size_t) levels[i].width * levels[i].height * RGBA_COMPONENTS);
+        
+        if (i > 0 && filter == MIP_FILTER_KAISER) {
+            scratch[i].width  = levels[i].width;
+            scratch[i].height = levels[i - 1].height;
+            scratch[i].texels.resize((size_t) scratch[i].width * scratch[i].height * RGBA_COMPONENTS);
+        }
+    }
+    
+    // the workers start once for the whole chain, each taking the same share of every pass's rows;
+    // a level's rows are only read by the next level's pass, after the barrier that ends its own
+    int workers = std::min(thread_count, std::max(1, levels[0].height / MIN_ROWS_PER_THREAD));
+    Barrier barrier(workers);
+    
+    auto work = [&](int worker) {
+        auto share = [&](int rows, int &begin, int &end) {
+            begin = rows * worker / workers;
+            end   = rows * (worker + 1) / workers;
+        };
+        
+        int begin, end;
+        share(levels[0].height, begin, end);
+        decode_rows(levels[0], linear[0], begin, end);
+        barrier.Wait();
+        
+        for (int i = 1; i < level_count; i++) {
+            if (filter == MIP_FILTER_KAISER) {
+                share(scratch[i].height, begin, end);
+                kaiser_horizontal_rows(linear[i - 1], scratch[i], begin, end);
+                barrier.Wait();
+                share(linear[i].height, begin, end);
+                kaiser_vertical_rows(scratch[i], linear[i], begin, end);
+            }
+            else {
+                share(linear[i].height, begin, end);
+                box_rows(linear[i - 1], linear[i], begin, end);
+            }
+            
+            // encoding reads only the rows this worker just wrote
+            encode_rows(linear[i], levels[i], begin, end);
+            barrier.Wait();
+        }
+    };
+    
+    std::vector<std::thread> threads;
+    for (int worker = 1; worker < workers; worker++) threads.emplace_back(work, worker);
+    work(0);
+    for (std::thread &thread : threads) thread.join();
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+
+const int MAX_MIP_LEVELS = 16;
+
+enum MipFilter {
+    MIP_FILTER_BOX,      // 2x2 average; cheap enough for load-time generation
+    MIP_FILTER_KAISER,   // 8-tap Kaiser-windowed sinc; sharper, used when cooking
+};
+
+struct MipLevelView {
+    unsigned char *pixels;   // tightly packed RGBA8, sRGB-encoded colour
+    int width;
+    int height;
+};
+
+// Number of levels in a full chain down to 1x1, capped at MAX_MIP_LEVELS.
+int count_mip_levels(int width, int height);
+
+// Points levels[0..count) at consecutive, 4-byte aligned slices of base and returns the total size.
+// With base == NULL the pointers hold byte offsets, as glTexImage2D expects for a bound pixel buffer.
+size_t layout_mip_chain(unsigned char *base, int width, int height, MipLevelView *levels);
+
+// Fills levels 1..level_count-1 from levels[0]. Filtering happens in linear light on alpha-weighted
+// colour, so edges of transparent sprites do not darken and gradients keep their brightness.
+// Rows of each level are split across thread_count worker threads (0 picks the hardware count).
+void generate_mip_chain(MipLevelView *levels, int level_count, MipFilter filter, int thread_count = 0);
@@ -0,0 +1,59 @@
+#include "NoiseGrid.h"
+#include "glm/gtc/noise.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// below this a worker spends more time starting than sampling
+const int MIN_ROWS_PER_THREAD = 16;
+
+}
+
+NoiseGridDesc default_noise_grid() {
+    NoiseGridDesc desc;
+    desc.origin     = glm::vec3(0.0f);
+    desc.animated   = false;
+    desc.step       = glm::vec2(1.0f);
+    desc.octaves    = 1;
+    desc.lacunarity = 2.0f;
+    desc.gain       = 0.5f;
+    return desc;
+}
+
+void fill_noise_grid(const NoiseGridDesc &desc, int width, int height, float *out, int thread_count) {
+    if (width <= 0 || height <= 0) return;
+    if (thread_count <= 0) thread_count = std::max(1u, std::thread::hardware_concurrency());
+    
+    int workers = std::min(thread_count, std::max(1, height / MIN_ROWS_PER_THREAD));
+    auto fill_rows = [&](int begin, int end) {
+        if (desc.animated) {
+            glm::simplexGrid(desc.origin, desc.step, (size_t) width, (size_t) begin, (size_t) end, out,
+                             desc.octaves, desc.lacunarity, desc.gain);
+        } else {
+            glm::simplexGrid(glm::vec2(desc.origin), desc.step, (size_t) width, (size_t) begin, (size_t) end, out,
+                             desc.octaves, desc.lacunarity, desc.gain);
+        }
+    };
+    
+    if (workers <= 1) {
+        fill_rows(0, height);
+        return;
+    }
+    
+    std::vector<std::thread> threads;
+    for (int i = 0; i < workers; i++) {
+        int begin = height * i / workers, end = height * (i + 1) / workers;
+        threads.emplace_back([=] { fill_rows(begin, end); });
+    }
+    for (std::thread &thread : threads) thread.join();
+}
+
+void noise_to_luminance(const float *noise, unsigned char *out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        float value = std::min(std::max(noise[i] * 0.5f + 0.5f, 0.0f), 1.0f);
+        out[i] = (unsigned char) (value * 255.0f + 0.5f);
+    }
+}
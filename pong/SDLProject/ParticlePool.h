@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "glm/vec2.hpp"
+#include "glm/vec4.hpp"
+#include "glm/gtx/soa.hpp"
+
+// One particle as the instanced renderer reads it: 16 bytes, streamed every frame.
+struct ParticleInstance {
+    float position[2];
+    float size;
+    uint8_t tint[4];   // [0, 1] as unorm8
+};
+
+// How a burst of particles starts out. Every jitter is the half-width of a uniform random spread.
+struct ParticleEmitter {
+    glm::vec2 position;
+    glm::vec2 positionJitter;   // per axis
+    glm::vec2 velocity;
+    float velocityJitter;       // per axis
+    float lifetime;             // seconds
+    float lifetimeJitter;
+    float size;                 // at birth; particles shrink to nothing over their lifetime
+    glm::vec4 color;            // at birth; alpha fades to zero over the lifetime
+};
+
+// A fixed-capacity pool of particles held as structure-of-arrays columns. Everything is allocated by
+// the constructor: emitting past the capacity drops particles instead of growing, and dead particles
+// are replaced by the last live one, so the live particles always fill the first Count() slots.
+class ParticlePool {
+    public:
+
+        explicit ParticlePool(size_t capacity);
+
+        ParticlePool(const ParticlePool &) = delete;
+        ParticlePool &operator=(const ParticlePool &) = delete;
+
+        // Returns how many of the count particles fitted.
+        size_t Emit(const ParticleEmitter &emitter, size_t count);
+
+        // Moves every particle one step under gravity, then removes the ones past their lifetime.
+        void Update(float deltaTime, const glm::vec2 &gravity);
+
+        void Clear();
+
+        // Writes up to maxCount live particles with their size and alpha faded by age; returns how many.
+        size_t WriteInstances(ParticleInstance *out, size_t maxCount) const;
+
+        size_t Count() const { return positions.size(); }
+        size_t Capacity() const { return capacity; }
+
+    private:
+
+        float Random();   // uniform in [-1, 1)
+
+        size_t capacity;
+
+        glm::soa<glm::vec2> positions;
+        glm::soa<glm::vec2> velocities;
+        std::vector<float> ages;               // as a fraction of the lifetime: dead at 1
+        std::vector<float> inverseLifetimes;   // so aging is a multiply-add and fading needs no divide
+        std::vector<float> sizes;
+        std::vector<uint32_t> colors;   // RGBA8 at birth, red in the lowest byte
+
+        uint32_t seed;
+};
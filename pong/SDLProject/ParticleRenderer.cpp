@@ -0,0 +1,71 @@
+#define GL_SILENCE_DEPRECATION
+
+#include "ParticleRenderer.h"
+#include "SpriteMesh.h"
+
+#include <SDL.h>
+
+bool particles_supported() {
+    return gl_version_at_least(3, 3) || SDL_GL_ExtensionSupported("GL_ARB_instanced_arrays");
+}
+
+void ParticleRenderer::Load(const char *vertexShaderFile, const char *fragmentShaderFile, size_t capacity) {
+    program.Load(vertexShaderFile, fragmentShaderFile);
+    instanceAttribute = glGetAttribLocation(program.programID, "instance");
+
+    this->capacity = capacity;
+    glGenBuffers(1, &instanceBuffer);
+}
+
+void ParticleRenderer::Cleanup() {
+    glDeleteBuffers(1, &instanceBuffer);
+    program.Cleanup();
+}
+
+void ParticleRenderer::Draw(const ParticlePool &pool, GLuint textureID) {
+    if (pool.Count() == 0) return;
+
+    glUseProgram(program.programID);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+
+    // a fresh store each frame: the driver hands back new memory instead of syncing on the old
+    glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(ParticleInstance), NULL, GL_STREAM_DRAW);
+    ParticleInstance *instances = (ParticleInstance *) glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+    GLsizei count = 0;
+    if (instances)
+    {
+        count = (GLsizei) pool.WriteInstances(instances, capacity);
+
+        // only a mapped buffer may be unmapped; GL_FALSE means the store was lost while mapped
+        if (glUnmapBuffer(GL_ARRAY_BUFFER) != GL_TRUE) count = 0;
+    }
+
+    const GLsizei stride = sizeof(ParticleInstance);
+    glVertexAttribPointer(instanceAttribute, 3, GL_FLOAT, false, stride, (const void *) offsetof(ParticleInstance, position));
+    glEnableVertexAttribArray(instanceAttribute);
+    glVertexAttribDivisorARB(instanceAttribute, 1);
+
+    glVertexAttribPointer(program.tintAttribute, 4, GL_UNSIGNED_BYTE, true, stride, (const void *) offsetof(ParticleInstance, tint));
+    glEnableVertexAttribArray(program.tintAttribute);
+    glVertexAttribDivisorARB(program.tintAttribute, 1);
+
+    // the quad itself comes from client memory, once per instance
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glVertexAttribPointer(program.positionAttribute, 2, GL_FLOAT, false, 0, UNIT_SPRITE_QUAD.positions);
+    glEnableVertexAttribArray(program.positionAttribute);
+    glVertexAttribPointer(program.texCoordAttribute, 2, GL_FLOAT, false, 0, UNIT_SPRITE_QUAD.texCoords);
+    glEnableVertexAttribArray(program.texCoordAttribute);
+
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glDrawArraysInstancedARB(GL_TRIANGLES, 0, SPRITE_QUAD_VERTEX_COUNT, count);
+
+    // divisors are attribute state shared with every other program
+    glVertexAttribDivisorARB(instanceAttribute, 0);
+    glVertexAttribDivisorARB(program.tintAttribute, 0);
+    glDisableVertexAttribArray(instanceAttribute);
+    glDisableVertexAttribArray(program.tintAttribute);
+    glDisableVertexAttribArray(program.positionAttribute);
+    glDisableVertexAttribArray(program.texCoordAttribute);
+
+    program.ResetTint();
+}
@@ -1,6 +1,9 @@
 #define GL_SILENCE_DEPRECATION
 
 #include "ShaderProgram.h"
+#include "MappedFile.h"
+
+#include <cstdio>
 
 void ShaderProgram::Load(const char *vertexShaderFile, const char *fragmentShaderFile) {
     
@@ -21,6 +24,10 @@ void ShaderProgram::Load(const char *vertexShaderFile, const char *fragmentShade
 	printf("Error linking shader program!\n");
     }
     
+    LookUpLocations();
+}
+
+void ShaderProgram::LookUpLocations() {
     modelMatrixUniform = glGetUniformLocation(programID, "modelMatrix");
     projectionMatrixUniform = glGetUniformLocation(programID, "projectionMatrix");
     viewMatrixUniform = glGetUniformLocation(programID, "viewMatrix");
@@ -28,11 +35,54 @@ void ShaderProgram::Load(const char *vertexShaderFile, const char *fragmentShade
     
     positionAttribute = glGetAttribLocation(programID, "position");
     texCoordAttribute = glGetAttribLocation(programID, "texCoord");
+    tintAttribute = glGetAttribLocation(programID, "tint");
+    
+    ResetTint();
 	
 	SetColor(1.0f, 1.0f, 1.0f, 1.0f);
     
 }
 
+bool ShaderProgram::Reload(const std::string &vertexSource, const std::string &fragmentSource) {
+    GLuint newVertexShader = LoadShaderFromString(vertexSource, GL_VERTEX_SHADER);
+    GLuint newFragmentShader = LoadShaderFromString(fragmentSource, GL_FRAGMENT_SHADER);
+    GLuint newProgramID = glCreateProgram();
+    glAttachShader(newProgramID, newVertexShader);
+    glAttachShader(newProgramID, newFragmentShader);
+    
+    // pin every attribute the old program had to its old location, so locations other code has
+    // already looked up (a renderer's instance attribute, say) stay right after the swap
+    GLint attributeCount = 0;
+    glGetProgramiv(programID, GL_ACTIVE_ATTRIBUTES, &attributeCount);
+    for (GLint i = 0; i < attributeCount; i++) {
+        GLchar name[64];
+        GLint size;
+        GLenum type;
+        glGetActiveAttrib(programID, i, sizeof(name), NULL, &size, &type, name);
+        GLint location = glGetAttribLocation(programID, name);
+        if (location >= 0) glBindAttribLocation(newProgramID, location, name);
+    }
+    glLinkProgram(newProgramID);
+    
+    GLint linkSuccess;
+    glGetProgramiv(newProgramID, GL_LINK_STATUS, &linkSuccess);
+    if(linkSuccess == GL_FALSE) {
+        // a compile error has been printed already; keep drawing with the old program
+        printf("Error linking reloaded shader program, keeping the old one\n");
+        glDeleteProgram(newProgramID);
+        glDeleteShader(newVertexShader);
+        glDeleteShader(newFragmentShader);
+        return false;
+    }
+    
+    Cleanup();
+    programID = newProgramID;
+    vertexShader = newVertexShader;
+    fragmentShader = newFragmentShader;
+    LookUpLocations();
+    return true;
+}
+
 void ShaderProgram::Cleanup() {
     glDeleteProgram(programID);
     glDeleteShader(vertexShader);
@@ -40,33 +90,30 @@ void ShaderProgram::Cleanup() {
 }
 
 GLuint ShaderProgram::LoadShaderFromFile(const std::string &shaderFile, GLenum type) {
-    //Open a file stream with the file name
-    std::ifstream infile(shaderFile);
+    //Map the file so the driver reads the source straight out of the page cache
+    MappedFile source(shaderFile.c_str());
     
-    if(infile.fail()) {
+    if(!source.IsOpen()) {
         std::cout << "Error opening shader file:" << shaderFile << std::endl;
     }
     
-    //Create a string buffer and stream the file to it
-    std::stringstream buffer;
-    buffer << infile.rdbuf();
-    
     // Load the shader from the contents of the file
-    return LoadShaderFromString(buffer.str(), type);
+    const char *contents = source.Size() > 0 ? reinterpret_cast<const char *>(source.Data()) : "";
+    return LoadShaderFromString(contents, (GLint) source.Size(), type);
 }
 
 GLuint ShaderProgram::LoadShaderFromString(const std::string &shaderContents, GLenum type) {
+    return LoadShaderFromString(shaderContents.c_str(), (GLint) shaderContents.size(), type);
+}
+
+GLuint ShaderProgram::LoadShaderFromString(const char *shaderContents, GLint shaderLength, GLenum type) {
     
     
     // Create a shader of specified type
     GLuint shaderID = glCreateShader(type);
     
-    // Get the pointer to the C string from the STL string
-    const char *shaderString = shaderContents.c_str();
-    GLint shaderStringLength = (GLint) shaderContents.size();
-    
     // Set the shader source to the string and compile shader
-    glShaderSource(shaderID, 1, &shaderString, &shaderStringLength);
+    glShaderSource(shaderID, 1, &shaderContents, &shaderLength);
     glCompileShader(shaderID);
     
     // Check if the shader compiled properly
@@ -89,6 +136,12 @@ void ShaderProgram::SetColor(float r, float g, float b, float a) {
 	glUniform4f(colorUniform, r, g, b, a);
 }
 
+void ShaderProgram::ResetTint() const {
+    if (tintAttribute != (GLuint) -1) {
+        glVertexAttrib4f(tintAttribute, 1.0f, 1.0f, 1.0f, 1.0f);
+    }
+}
+
 void ShaderProgram::SetViewMatrix(const glm::mat4 &matrix) {
     glUseProgram(programID);
     glUniformMatrix4fv(viewMatrixUniform, 1, GL_FALSE, &matrix[0][0]);
@@ -99,7 +152,24 @@ void ShaderProgram::SetModelMatrix(const glm::mat4 &matrix) {
     glUniformMatrix4fv(modelMatrixUniform, 1, GL_FALSE, &matrix[0][0]);
 }
 
+void ShaderProgram::SetModelMatrix(const Transform2D &transform) {
+    // the only place a 2D transform is widened to the 4x4 the shader expects
+    float matrix[16];
+    transform.ToMat4(matrix);
+    glUseProgram(programID);
+    glUniformMatrix4fv(modelMatrixUniform, 1, GL_FALSE, matrix);
+}
+
 void ShaderProgram::SetProjectionMatrix(const glm::mat4 &matrix) {
     glUseProgram(programID);
     glUniformMatrix4fv(projectionMatrixUniform, 1, GL_FALSE, &matrix[0][0]);    
 }
+
+bool gl_version_at_least(int major, int minor) {
+    // "major.minor[.release] vendor text", after an "OpenGL ES " prefix on ES contexts
+    const char *version = (const char *) glGetString(GL_VERSION);
+    int context_major = 0, context_minor = 0;
+    while (version && *version && (*version < '0' || *version > '9')) version++;
+    if (!version || sscanf(version, "%d.%d", &context_major, &context_minor) != 2) return false;
+    return context_major > major || (context_major == major && context_minor >= minor);
+}
@@ -0,0 +1,144 @@
+#include "SpriteGrid.h"
+#include "Components.h"
+#include "glm/common.hpp"
+
+#include <cmath>
+
+namespace {
+    // cell coordinates packed into one hash key, and back
+    uint64_t cell_key(int32_t x, int32_t y)
+    {
+        return (uint64_t(uint32_t(x)) << 32) | uint32_t(y);
+    }
+
+    int32_t cell_x(uint64_t key) { return int32_t(uint32_t(key >> 32)); }
+    int32_t cell_y(uint64_t key) { return int32_t(uint32_t(key)); }
+}
+
+SpriteGrid::SpriteGrid(float cellSize) : cellSize(cellSize), inverseCellSize(1.0f / cellSize), count(0) {
+    stats = CullStats { 0, 0, 0 };
+}
+
+uint64_t SpriteGrid::CellOf(const glm::vec2 &point) const {
+    return cell_key(int32_t(std::floor(point.x * inverseCellSize)), int32_t(std::floor(point.y * inverseCellSize)));
+}
+
+std::vector<SpriteGrid::Item> &SpriteGrid::Items(const Record &record) {
+    return record.oversized ? oversized : cells[record.cell];
+}
+
+void SpriteGrid::File(const Item &item) {
+    if (records.size() <= item.entity.index) records.resize(item.entity.index + 1, Record { 0, NOT_FILED, false });
+
+    Record &record = records[item.entity.index];
+    glm::vec2 size = item.max - item.min;
+    record.oversized = size.x > cellSize || size.y > cellSize;
+    record.cell = record.oversized ? 0 : CellOf(0.5f * (item.min + item.max));
+
+    std::vector<Item> &items = Items(record);
+    record.slot = uint32_t(items.size());
+    items.push_back(item);
+    count++;
+}
+
+void SpriteGrid::Unfile(uint32_t index) {
+    Record &record = records[index];
+    std::vector<Item> &items = Items(record);
+
+    // the last item of the cell fills the hole; emptied cells are kept for the next sprite to come by
+    Item &last = items.back();
+    records[last.entity.index].slot = record.slot;
+    items[record.slot] = last;
+    items.pop_back();
+
+    record.slot = NOT_FILED;
+    count--;
+}
+
+void SpriteGrid::Update(World &world, const TransformHierarchy &hierarchy) {
+    const std::vector<uint32_t> &changed = hierarchy.Changed();
+
+    for (size_t i = 0; i < changed.size(); i++)
+    {
+        Entity entity = hierarchy.Owner(changed[i]);
+        const Transform2D *transform = world.Get<Transform2D>(entity);
+        if (!transform || !world.Has<Sprite>(entity)) continue;
+
+        // the unit quad's corners under the transform reach this far from its centre on each axis
+        glm::vec2 halfExtents = 0.5f * (glm::abs(transform->xAxis) + glm::abs(transform->yAxis));
+        Item item = { entity, transform->translation - halfExtents, transform->translation + halfExtents };
+
+        if (entity.index < records.size() && records[entity.index].slot != NOT_FILED)
+        {
+            // still in the same cell: only its bounds move
+            Record &record = records[entity.index];
+            glm::vec2 size = item.max - item.min;
+            bool oversized = size.x > cellSize || size.y > cellSize;
+            if (oversized == record.oversized && (oversized || CellOf(transform->translation) == record.cell))
+            {
+                Items(record)[record.slot] = item;
+                continue;
+            }
+
+            Unfile(entity.index);
+        }
+
+        File(item);
+    }
+}
+
+void SpriteGrid::Remove(Entity entity) {
+    if (entity.index < records.size() && records[entity.index].slot != NOT_FILED) Unfile(entity.index);
+}
+
+void SpriteGrid::Test(const std::vector<Item> &items, const ViewRect &rect, std::vector<Entity> &visible) {
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        const Item &item = items[i];
+        if (item.max.x >= rect.min.x && item.min.x <= rect.max.x && item.max.y >= rect.min.y && item.min.y <= rect.max.y)
+        {
+            visible.push_back(item.entity);
+        }
+    }
+
+    stats.tested += items.size();
+}
+
+void SpriteGrid::Query(const ViewRect &rect, std::vector<Entity> &visible) {
+    stats = CullStats { 0, 0, 0 };
+    size_t first = visible.size();
+
+    // a sprite filed in a cell reaches at most half a cell beyond it
+    const float reach = 0.5f * cellSize;
+    int32_t minX = int32_t(std::floor((rect.min.x - reach) * inverseCellSize));
+    int32_t minY = int32_t(std::floor((rect.min.y - reach) * inverseCellSize));
+    int32_t maxX = int32_t(std::floor((rect.max.x + reach) * inverseCellSize));
+    int32_t maxY = int32_t(std::floor((rect.max.y + reach) * inverseCellSize));
+
+    double covered = (double(maxX) - minX + 1) * (double(maxY) - minY + 1);
+    if (covered <= double(cells.size()))
+    {
+        for (int32_t y = minY; y <= maxY; y++)
+        {
+            for (int32_t x = minX; x <= maxX; x++)
+            {
+                auto cell = cells.find(cell_key(x, y));
+                if (cell != cells.end()) Test(cell->second, rect, visible);
+            }
+        }
+    }
+    else
+    {
+        // zoomed out past the populated cells: walking those is cheaper than looking up every empty one
+        for (auto cell = cells.begin(); cell != cells.end(); ++cell)
+        {
+            int32_t x = cell_x(cell->first), y = cell_y(cell->first);
+            if (x >= minX && x <= maxX && y >= minY && y <= maxY) Test(cell->second, rect, visible);
+        }
+    }
+
+    Test(oversized, rect, visible);
+
+    stats.visible = visible.size() - first;
+    stats.culled = count - stats.visible;
+}
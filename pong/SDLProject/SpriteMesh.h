@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CookedTexture.h"
+
+const int SPRITE_QUAD_VERTEX_COUNT = 6;
+
+// Two triangles covering a rectangle centred on the origin, as the flat xy and uv arrays
+// glVertexAttribPointer reads. Everything here is built by the compiler, not at startup.
+struct SpriteQuad {
+    float positions[SPRITE_QUAD_VERTEX_COUNT * 2];
+    float texCoords[SPRITE_QUAD_VERTEX_COUNT * 2];
+};
+
+constexpr AtlasRegion FULL_TEXTURE_REGION = { 0.0f, 0.0f, 1.0f, 1.0f };
+
+// Corners in the order bottom-left, bottom-right, top-right, bottom-left, top-right, top-left.
+// Images are stored top row first, so (u0, v0) of the region lands on the top-left corner.
+constexpr SpriteQuad make_sprite_quad(float width, float height, const AtlasRegion &region = FULL_TEXTURE_REGION) {
+    return SpriteQuad {
+        {
+            -0.5f * width, -0.5f * height,   0.5f * width, -0.5f * height,   0.5f * width,  0.5f * height,
+            -0.5f * width, -0.5f * height,   0.5f * width,  0.5f * height,  -0.5f * width,  0.5f * height,
+        },
+        {
+            region.u0, region.v1,   region.u1, region.v1,   region.u1, region.v0,
+            region.u0, region.v1,   region.u1, region.v0,   region.u0, region.v0,
+        },
+    };
+}
+
+constexpr SpriteQuad UNIT_SPRITE_QUAD = make_sprite_quad(1.0f, 1.0f);
+
+static_assert(UNIT_SPRITE_QUAD.positions[0] == -0.5f && UNIT_SPRITE_QUAD.positions[1] == -0.5f &&
+              UNIT_SPRITE_QUAD.positions[10] == -0.5f && UNIT_SPRITE_QUAD.positions[11] == 0.5f,
+              "the unit quad runs from the bottom-left corner round to the top-left one");
+static_assert(UNIT_SPRITE_QUAD.texCoords[0] == 0.0f && UNIT_SPRITE_QUAD.texCoords[1] == 1.0f &&
+              UNIT_SPRITE_QUAD.texCoords[4] == 1.0f && UNIT_SPRITE_QUAD.texCoords[5] == 0.0f,
+              "the bottom-left corner samples the last image row, the top-right one the first");
+static_assert(make_sprite_quad(2.0f, 4.0f, { 0.25f, 0.5f, 0.75f, 1.0f }).positions[4] == 1.0f &&
+              make_sprite_quad(2.0f, 4.0f, { 0.25f, 0.5f, 0.75f, 1.0f }).positions[5] == 2.0f &&
+              make_sprite_quad(2.0f, 4.0f, { 0.25f, 0.5f, 0.75f, 1.0f }).texCoords[10] == 0.25f &&
+              make_sprite_quad(2.0f, 4.0f, { 0.25f, 0.5f, 0.75f, 1.0f }).texCoords[11] == 0.5f,
+              "sizes scale the corners and atlas regions map onto them");
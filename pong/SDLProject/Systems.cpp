@@ -0,0 +1,63 @@
+#include "Systems.h"
+
+#include <cmath>
+
+void integrate_velocities(World &world, TransformHierarchy &hierarchy, float deltaTime) {
+    world.EachChunk<Position, Velocity, TransformNode>([&hierarchy, deltaTime](size_t count, const Entity *, Position *positions,
+                                                                               Velocity *velocities, TransformNode *nodes) {
+        for (size_t i = 0; i < count; i++)
+        {
+            if (velocities[i].value.x == 0.0f && velocities[i].value.y == 0.0f) continue;
+
+            positions[i].value += velocities[i].value * deltaTime;
+            hierarchy.MarkDirty(nodes[i].node);
+        }
+    });
+}
+
+bool colliders_overlap(World &world, Entity a, Entity b) {
+    const Position *positionA = world.Get<Position>(a), *positionB = world.Get<Position>(b);
+    const Collider *colliderA = world.Get<Collider>(a), *colliderB = world.Get<Collider>(b);
+    if (!positionA || !positionB || !colliderA || !colliderB) return false;
+
+    return std::fabs(positionA->value.x - positionB->value.x) < colliderA->halfExtents.x + colliderB->halfExtents.x &&
+           std::fabs(positionA->value.y - positionB->value.y) < colliderA->halfExtents.y + colliderB->halfExtents.y;
+}
+
+void draw_sprites(World &world, ShaderProgram &program, int vertexCount) {
+    GLuint boundTexture = 0;
+
+    world.EachChunk<Transform2D, Sprite>([&](size_t count, const Entity *, Transform2D *transforms, Sprite *sprites) {
+        for (size_t i = 0; i < count; i++)
+        {
+            if (sprites[i].textureID != boundTexture)
+            {
+                glBindTexture(GL_TEXTURE_2D, sprites[i].textureID);
+                boundTexture = sprites[i].textureID;
+            }
+
+            program.SetModelMatrix(transforms[i]);
+            glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+        }
+    });
+}
+
+void draw_sprites(World &world, ShaderProgram &program, int vertexCount, const std::vector<Entity> &sprites) {
+    GLuint boundTexture = 0;
+
+    for (size_t i = 0; i < sprites.size(); i++)
+    {
+        const Transform2D *transform = world.Get<Transform2D>(sprites[i]);
+        const Sprite *sprite = world.Get<Sprite>(sprites[i]);
+        if (!transform || !sprite) continue;
+
+        if (sprite->textureID != boundTexture)
+        {
+            glBindTexture(GL_TEXTURE_2D, sprite->textureID);
+            boundTexture = sprite->textureID;
+        }
+
+        program.SetModelMatrix(*transform);
+        glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+    }
+}
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+// Handle to an entity of a World. Slots are reused after Destroy, so a handle also carries the
+// generation of its slot, and a handle kept past Destroy just stops being alive.
+struct Entity {
+    uint32_t index;
+    uint32_t generation;
+};
+
+const Entity NULL_ENTITY = { 0xFFFFFFFFu, 0 };
+
+// Bit i is set when component type i is present.
+typedef uint64_t ComponentMask;
+
+const int MAX_COMPONENT_TYPES = 64;
+
+// Hands out the next component type id; component_id<T>() calls it once per type.
+int register_component_type(size_t size);
+
+// Components are plain structs, copied between archetypes with memcpy.
+template<typename T>
+int component_id() {
+    static_assert(std::is_trivially_copyable<T>::value, "components are moved with memcpy");
+    static const int id = register_component_type(sizeof(T));
+    return id;
+}
+
+template<typename... Components>
+ComponentMask component_mask() {
+    ComponentMask mask = 0;
+    for (int id : std::initializer_list<int> { component_id<Components>()... }) mask |= ComponentMask(1) << id;
+    return mask;
+}
+
+// All entities with exactly the same set of components. Each component is one contiguous column,
+// so row i of every column and entities[i] describe the same entity, and a query walks plain arrays.
+struct Archetype {
+    ComponentMask mask;
+    size_t count;
+    size_t capacity;
+    Entity *entities;
+    unsigned char *columns[MAX_COMPONENT_TYPES];   // NULL for the components this archetype lacks
+};
+
+// Archetype-based entity storage. Columns grow by doubling, so creating entities allocates only when
+// an archetype outgrows its capacity (never, after Reserve), and removal swaps the last row into the
+// hole to keep every column dense.
+// Create, Destroy, Add and Remove move rows around: none of them may be called inside Each or EachChunk.
+class World {
+    public:
+
+        World();
+        ~World();
+
+        World(const World &) = delete;
+        World &operator=(const World &) = delete;
+
+        // An entity without components.
+        Entity Create();
+        template<typename... Components>
+        Entity Create(const Components &... components);
+
+        void Destroy(Entity entity);
+        bool IsAlive(Entity entity) const;
+
+        // Adding or removing moves the entity to the archetype of its new component set.
+        // Adding a component the entity already has overwrites it.
+        template<typename T> void Add(Entity entity, const T &component);
+        template<typename T> void Remove(Entity entity);
+        template<typename T> bool Has(Entity entity) const;
+
+        // NULL when the entity is dead or lacks the component. Valid until the next structural change.
+        template<typename T> T *Get(Entity entity);
+
+        // Sizes the archetype of exactly these components for count entities.
+        template<typename... Components>
+        void Reserve(size_t count);
+
+        // Calls f(count, entities, columns...) once for every non-empty archetype that has all of Components,
+        // one Components * column each.
+        template<typename... Components, typename F>
+        void EachChunk(F f);
+
+        // Calls f(components...) with references for every entity that has all of Components.
+        template<typename... Components, typename F>
+        void Each(F f);
+
+        size_t Count() const { return liveCount; }
+        size_t ArchetypeCount() const { return archetypes.size(); }
+
+    private:
+
+        struct EntityRecord {
+            Archetype *archetype;   // NULL while the slot is free
+            size_t row;
+            uint32_t generation;
+        };
+
+        Entity Allocate(Archetype *archetype);
+        Archetype *FindArchetype(ComponentMask mask);
+        void Grow(Archetype *archetype, size_t capacity);
+        void RemoveRow(Archetype *archetype, size_t row);
+        void Move(Entity entity, ComponentMask mask);
+        unsigned char *Component(Entity entity, int id) const;
+
+        std::vector<Archetype *> archetypes;
+        std::vector<EntityRecord> records;
+        std::vector<uint32_t> freeIndices;
+        size_t liveCount;
+};
+
+template<typename... Components>
+Entity World::Create(const Components &... components) {
+    Entity entity = Allocate(FindArchetype(component_mask<Components...>()));
+
+    const std::initializer_list<int> copies = { (*Get<Components>(entity) = components, 0)... };
+    (void) copies;
+
+    return entity;
+}
+
+template<typename T>
+void World::Add(Entity entity, const T &component) {
+    if (!IsAlive(entity)) return;
+
+    const ComponentMask bit = ComponentMask(1) << component_id<T>();
+    if ((records[entity.index].archetype->mask & bit) == 0) Move(entity, records[entity.index].archetype->mask | bit);
+
+    *Get<T>(entity) = component;
+}
+
+template<typename T>
+void World::Remove(Entity entity) {
+    if (!Has<T>(entity)) return;
+
+    Move(entity, records[entity.index].archetype->mask & ~(ComponentMask(1) << component_id<T>()));
+}
+
+template<typename T>
+bool World::Has(Entity entity) const {
+    return Component(entity, component_id<T>()) != nullptr;
+}
+
+template<typename T>
+T *World::Get(Entity entity) {
+    return reinterpret_cast<T *>(Component(entity, component_id<T>()));
+}
+
+template<typename... Components>
+void World::Reserve(size_t count) {
+    Archetype *archetype = FindArchetype(component_mask<Components...>());
+    if (archetype->capacity < count) Grow(archetype, count);
+}
+
+template<typename... Components, typename F>
+void World::EachChunk(F f) {
+    const ComponentMask mask = component_mask<Components...>();
+
+    for (size_t a = 0; a < archetypes.size(); a++)
+    {
+        Archetype *archetype = archetypes[a];
+        if ((archetype->mask & mask) != mask || archetype->count == 0) continue;
+
+        f(archetype->count, static_cast<const Entity *>(archetype->entities),
+          reinterpret_cast<Components *>(archetype->columns[component_id<Components>()])...);
+    }
+}
+
+template<typename... Components, typename F>
+void World::Each(F f) {
+    EachChunk<Components...>([&f](size_t count, const Entity *, Components *... columns) {
+        for (size_t i = 0; i < count; i++) f(columns[i]...);
+    });
+}
+
+// Systems run in the order they were added, each over the whole world.
+typedef void (*System)(World &world, float deltaTime);
+
+class Scheduler {
+    public:
+
+        void Add(const char *name, System system);
+        void SetEnabled(const char *name, bool enabled);
+
+        void Run(World &world, float deltaTime);
+
+    private:
+
+        struct Entry {
+            const char *name;
+            System system;
+            bool enabled;
+        };
+
+        std::vector<Entry> systems;
+};
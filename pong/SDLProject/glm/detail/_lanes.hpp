@@ -0,0 +1,211 @@
+/// @ref core
+/// @file glm/detail/_lanes.hpp
+///
+/// Arithmetic on one float, an SSE2 register or an AVX register behind one
+/// interface, so array kernels are written once and give the same results
+/// in their vector body and scalar tail. Float operations only: AVX has no
+/// 256-bit integer instructions before AVX2.
+
+#pragma once
+
+#include "setup.hpp"
+#include <cmath>
+#include <cstring>
+
+namespace glm{
+namespace detail
+{
+	template<typename V>
+	struct lanes;
+
+	template<>
+	struct lanes<float>
+	{
+		typedef float type;
+		// All ones or all zeros like the vector compares, so select and
+		// negate_if are bit operations instead of data-dependent branches.
+		typedef unsigned int mask;
+		static const int width = 1;
+
+		GLM_FUNC_QUALIFIER static type load(float const* p) { return *p; }
+		GLM_FUNC_QUALIFIER static void store(float* p, type a) { *p = a; }
+		GLM_FUNC_QUALIFIER static type set1(float s) { return s; }
+
+		GLM_FUNC_QUALIFIER static type add(type a, type b) { return a + b; }
+		GLM_FUNC_QUALIFIER static type sub(type a, type b) { return a - b; }
+		GLM_FUNC_QUALIFIER static type mul(type a, type b) { return a * b; }
+		GLM_FUNC_QUALIFIER static type div(type a, type b) { return a / b; }
+		GLM_FUNC_QUALIFIER static type fma(type a, type b, type c) { return a * b + c; }
+		GLM_FUNC_QUALIFIER static type min(type a, type b) { return a < b ? a : b; }
+		GLM_FUNC_QUALIFIER static type max(type a, type b) { return a > b ? a : b; }
+		GLM_FUNC_QUALIFIER static type abs(type a) { return std::fabs(a); }
+		GLM_FUNC_QUALIFIER static type floor(type a) { return std::floor(a); }
+		GLM_FUNC_QUALIFIER static type sqrt(type a) { return std::sqrt(a); }
+		// Exact here; the vector widths return the hardware estimate.
+		GLM_FUNC_QUALIFIER static type rsqrt(type a) { return 1.0f / std::sqrt(a); }
+		// Nearest, ties to even, for |a| < 2^22.
+		GLM_FUNC_QUALIFIER static type round(type a) { return (a + 12582912.0f) - 12582912.0f; }
+
+		GLM_FUNC_QUALIFIER static mask lt(type a, type b) { return 0u - static_cast<mask>(a < b); }
+		GLM_FUNC_QUALIFIER static mask gt(type a, type b) { return 0u - static_cast<mask>(a > b); }
+		GLM_FUNC_QUALIFIER static mask le(type a, type b) { return 0u - static_cast<mask>(a <= b); }
+		GLM_FUNC_QUALIFIER static mask ge(type a, type b) { return 0u - static_cast<mask>(a >= b); }
+		GLM_FUNC_QUALIFIER static mask eq(type a, type b) { return 0u - static_cast<mask>(a == b); }
+		GLM_FUNC_QUALIFIER static mask both(mask a, mask b) { return a & b; }
+		GLM_FUNC_QUALIFIER static mask either(mask a, mask b) { return a | b; }
+		// One bit per lane, lane 0 lowest.
+		GLM_FUNC_QUALIFIER static unsigned int bits(mask m) { return m & 1u; }
+
+		GLM_FUNC_QUALIFIER static type select(mask m, type a, type b) { return from_bits((to_bits(a) & m) | (to_bits(b) & ~m)); }
+		GLM_FUNC_QUALIFIER static type negate_if(mask m, type a) { return from_bits(to_bits(a) ^ (m & 0x80000000u)); }
+		GLM_FUNC_QUALIFIER static type copysign(type magnitude, type sign) { return std::copysign(magnitude, sign); }
+
+	private:
+		GLM_FUNC_QUALIFIER static mask to_bits(type a) { mask m; std::memcpy(&m, &a, sizeof(m)); return m; }
+		GLM_FUNC_QUALIFIER static type from_bits(mask m) { type a; std::memcpy(&a, &m, sizeof(a)); return a; }
+	};
+
+	// GCC warns that __m128's vector attributes are dropped when it names a template argument. They
+	// are: lanes<__m128> is only a key, and its members spell out the real types. widest_lanes below
+	// lets the kernels pick their lanes without naming one themselves.
+#	if GLM_COMPILER & GLM_COMPILER_GCC
+#		pragma GCC diagnostic push
+#		pragma GCC diagnostic ignored "-Wignored-attributes"
+#	endif
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	template<>
+	struct lanes<__m128>
+	{
+		typedef __m128 type;
+		typedef __m128 mask;
+		static const int width = 4;
+
+		GLM_FUNC_QUALIFIER static type load(float const* p) { return _mm_loadu_ps(p); }
+		GLM_FUNC_QUALIFIER static void store(float* p, type a) { _mm_storeu_ps(p, a); }
+		GLM_FUNC_QUALIFIER static type set1(float s) { return _mm_set1_ps(s); }
+
+		GLM_FUNC_QUALIFIER static type add(type a, type b) { return _mm_add_ps(a, b); }
+		GLM_FUNC_QUALIFIER static type sub(type a, type b) { return _mm_sub_ps(a, b); }
+		GLM_FUNC_QUALIFIER static type mul(type a, type b) { return _mm_mul_ps(a, b); }
+		GLM_FUNC_QUALIFIER static type div(type a, type b) { return _mm_div_ps(a, b); }
+		GLM_FUNC_QUALIFIER static type fma(type a, type b, type c)
+		{
+#			if defined(__FMA__) || ((GLM_COMPILER & GLM_COMPILER_VC) && (GLM_ARCH & GLM_ARCH_AVX2_BIT))
+				return _mm_fmadd_ps(a, b, c);
+#			else
+				return _mm_add_ps(_mm_mul_ps(a, b), c);
+#			endif
+		}
+		GLM_FUNC_QUALIFIER static type min(type a, type b) { return _mm_min_ps(a, b); }
+		GLM_FUNC_QUALIFIER static type max(type a, type b) { return _mm_max_ps(a, b); }
+		GLM_FUNC_QUALIFIER static type abs(type a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+		GLM_FUNC_QUALIFIER static type floor(type a)
+		{
+#			if GLM_ARCH & GLM_ARCH_SSE41_BIT
+				return _mm_floor_ps(a);
+#			else
+				type const r = round(a);
+				return _mm_sub_ps(r, _mm_and_ps(_mm_cmpgt_ps(r, a), _mm_set1_ps(1.0f)));
+#			endif
+		}
+		GLM_FUNC_QUALIFIER static type sqrt(type a) { return _mm_sqrt_ps(a); }
+		GLM_FUNC_QUALIFIER static type rsqrt(type a) { return _mm_rsqrt_ps(a); }
+		GLM_FUNC_QUALIFIER static type round(type a)
+		{
+			type const Magic = _mm_set1_ps(12582912.0f);
+			return _mm_sub_ps(_mm_add_ps(a, Magic), Magic);
+		}
+
+		GLM_FUNC_QUALIFIER static mask lt(type a, type b) { return _mm_cmplt_ps(a, b); }
+		GLM_FUNC_QUALIFIER static mask gt(type a, type b) { return _mm_cmpgt_ps(a, b); }
+		GLM_FUNC_QUALIFIER static mask le(type a, type b) { return _mm_cmple_ps(a, b); }
+		GLM_FUNC_QUALIFIER static mask ge(type a, type b) { return _mm_cmpge_ps(a, b); }
+		GLM_FUNC_QUALIFIER static mask eq(type a, type b) { return _mm_cmpeq_ps(a, b); }
+		GLM_FUNC_QUALIFIER static mask both(mask a, mask b) { return _mm_and_ps(a, b); }
+		GLM_FUNC_QUALIFIER static mask either(mask a, mask b) { return _mm_or_ps(a, b); }
+		GLM_FUNC_QUALIFIER static unsigned int bits(mask m) { return static_cast<unsigned int>(_mm_movemask_ps(m)); }
+
+		GLM_FUNC_QUALIFIER static type select(mask m, type a, type b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+		GLM_FUNC_QUALIFIER static type negate_if(mask m, type a) { return _mm_xor_ps(a, _mm_and_ps(m, _mm_set1_ps(-0.0f))); }
+		GLM_FUNC_QUALIFIER static type copysign(type magnitude, type sign)
+		{
+			type const SignBit = _mm_set1_ps(-0.0f);
+			return _mm_or_ps(_mm_andnot_ps(SignBit, magnitude), _mm_and_ps(SignBit, sign));
+		}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+#	if GLM_ARCH & GLM_ARCH_AVX_BIT
+	template<>
+	struct lanes<__m256>
+	{
+		typedef __m256 type;
+		typedef __m256 mask;
+		static const int width = 8;
+
+		GLM_FUNC_QUALIFIER static type load(float const* p) { return _mm256_loadu_ps(p); }
+		GLM_FUNC_QUALIFIER static void store(float* p, type a) { _mm256_storeu_ps(p, a); }
+		GLM_FUNC_QUALIFIER static type set1(float s) { return _mm256_set1_ps(s); }
+
+		GLM_FUNC_QUALIFIER static type add(type a, type b) { return _mm256_add_ps(a, b); }
+		GLM_FUNC_QUALIFIER static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+		GLM_FUNC_QUALIFIER static type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+		GLM_FUNC_QUALIFIER static type div(type a, type b) { return _mm256_div_ps(a, b); }
+		GLM_FUNC_QUALIFIER static type fma(type a, type b, type c)
+		{
+#			if defined(__FMA__) || ((GLM_COMPILER & GLM_COMPILER_VC) && (GLM_ARCH & GLM_ARCH_AVX2_BIT))
+				return _mm256_fmadd_ps(a, b, c);
+#			else
+				return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#			endif
+		}
+		GLM_FUNC_QUALIFIER static type min(type a, type b) { return _mm256_min_ps(a, b); }
+		GLM_FUNC_QUALIFIER static type max(type a, type b) { return _mm256_max_ps(a, b); }
+		GLM_FUNC_QUALIFIER static type abs(type a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+		GLM_FUNC_QUALIFIER static type floor(type a) { return _mm256_floor_ps(a); }
+		GLM_FUNC_QUALIFIER static type sqrt(type a) { return _mm256_sqrt_ps(a); }
+		GLM_FUNC_QUALIFIER static type rsqrt(type a) { return _mm256_rsqrt_ps(a); }
+		GLM_FUNC_QUALIFIER static type round(type a)
+		{
+			type const Magic = _mm256_set1_ps(12582912.0f);
+			return _mm256_sub_ps(_mm256_add_ps(a, Magic), Magic);
+		}
+
+		GLM_FUNC_QUALIFIER static mask lt(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+		GLM_FUNC_QUALIFIER static mask gt(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+		GLM_FUNC_QUALIFIER static mask le(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+		GLM_FUNC_QUALIFIER static mask ge(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+		GLM_FUNC_QUALIFIER static mask eq(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+		GLM_FUNC_QUALIFIER static mask both(mask a, mask b) { return _mm256_and_ps(a, b); }
+		GLM_FUNC_QUALIFIER static mask either(mask a, mask b) { return _mm256_or_ps(a, b); }
+		GLM_FUNC_QUALIFIER static unsigned int bits(mask m) { return static_cast<unsigned int>(_mm256_movemask_ps(m)); }
+
+		// Masks are whole-lane compare results; blendv would also work, but GCC rewrites it into
+		// 256-bit integer sign tests that plain AVX lacks and then splits them into scalar code.
+		GLM_FUNC_QUALIFIER static type select(mask m, type a, type b) { return _mm256_or_ps(_mm256_and_ps(m, a), _mm256_andnot_ps(m, b)); }
+		GLM_FUNC_QUALIFIER static type negate_if(mask m, type a) { return _mm256_xor_ps(a, _mm256_and_ps(m, _mm256_set1_ps(-0.0f))); }
+		GLM_FUNC_QUALIFIER static type copysign(type magnitude, type sign)
+		{
+			type const SignBit = _mm256_set1_ps(-0.0f);
+			return _mm256_or_ps(_mm256_andnot_ps(SignBit, magnitude), _mm256_and_ps(SignBit, sign));
+		}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_AVX_BIT
+
+	// The widest float register the target has.
+#	if GLM_ARCH & GLM_ARCH_AVX_BIT
+		typedef __m256 widest_float_lanes;
+#	elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+		typedef __m128 widest_float_lanes;
+#	else
+		typedef float widest_float_lanes;
+#	endif
+
+	typedef lanes<widest_float_lanes> widest_lanes;
+
+#	if GLM_COMPILER & GLM_COMPILER_GCC
+#		pragma GCC diagnostic pop
+#	endif
+}//namespace detail
+}//namespace glm
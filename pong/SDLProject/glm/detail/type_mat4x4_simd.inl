@@ -1,6 +1,21 @@
 /// @ref core
 
-namespace glm
-{
+#include "../simd/matrix.h"
 
+namespace glm{
+namespace detail
+{
+#	if GLM_ARCH & GLM_ARCH_AVX_BIT
+	template<qualifier Q, bool Aligned>
+	struct compute_mat4_mul<float, Q, Aligned>
+	{
+		GLM_FUNC_QUALIFIER static mat<4, 4, float, Q> call(mat<4, 4, float, Q> const& m1, mat<4, 4, float, Q> const& m2)
+		{
+			mat<4, 4, float, Q> Result;
+			glm_mat4_mul_avx(&m1[0][0], &m2[0][0], &Result[0][0]);
+			return Result;
+		}
+	};
+#	endif
+}//namespace detail
 }//namespace glm
@@ -174,6 +174,7 @@
 #include "./gtx/quaternion.hpp"
 #include "./gtx/raw_data.hpp"
 #include "./gtx/rotate_vector.hpp"
+#include "./gtx/soa.hpp"
 #include "./gtx/spline.hpp"
 #include "./gtx/std_based_type.hpp"
 #if !(GLM_COMPILER & GLM_COMPILER_CUDA)
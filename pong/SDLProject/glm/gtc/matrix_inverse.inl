@@ -1,7 +1,24 @@
 /// @ref gtc_matrix_inverse
 
-namespace glm
+namespace glm{
+namespace detail
 {
+	template<typename T, qualifier Q, bool Aligned>
+	struct compute_affineInverse
+	{
+		GLM_FUNC_QUALIFIER static mat<4, 4, T, Q> call(mat<4, 4, T, Q> const& m)
+		{
+			mat<3, 3, T, Q> const Inv(inverse(mat<3, 3, T, Q>(m)));
+
+			return mat<4, 4, T, Q>(
+				vec<4, T, Q>(Inv[0], static_cast<T>(0)),
+				vec<4, T, Q>(Inv[1], static_cast<T>(0)),
+				vec<4, T, Q>(Inv[2], static_cast<T>(0)),
+				vec<4, T, Q>(-Inv * vec<3, T, Q>(m[3]), static_cast<T>(1)));
+		}
+	};
+}//namespace detail
+
 	template<typename T, qualifier Q>
 	GLM_FUNC_QUALIFIER mat<3, 3, T, Q> affineInverse(mat<3, 3, T, Q> const& m)
 	{
@@ -16,13 +33,7 @@ namespace glm
 	template<typename T, qualifier Q>
 	GLM_FUNC_QUALIFIER mat<4, 4, T, Q> affineInverse(mat<4, 4, T, Q> const& m)
 	{
-		mat<3, 3, T, Q> const Inv(inverse(mat<3, 3, T, Q>(m)));
-
-		return mat<4, 4, T, Q>(
-			vec<4, T, Q>(Inv[0], static_cast<T>(0)),
-			vec<4, T, Q>(Inv[1], static_cast<T>(0)),
-			vec<4, T, Q>(Inv[2], static_cast<T>(0)),
-			vec<4, T, Q>(-Inv * vec<3, T, Q>(m[3]), static_cast<T>(1)));
+		return detail::compute_affineInverse<T, Q, detail::is_aligned<Q>::value>::call(m);
 	}
 
 	template<typename T, qualifier Q>
@@ -116,3 +127,7 @@ namespace glm
 		return Inverse;
 	}
 }//namespace glm
+
+#if GLM_CONFIG_SIMD == GLM_ENABLE
+#	include "matrix_inverse_simd.inl"
+#endif
@@ -0,0 +1,26 @@
+#if GLM_ARCH & GLM_ARCH_AVX_BIT
+
+#include "../simd/matrix.h"
+
+namespace glm{
+namespace detail
+{
+	template<qualifier Q, bool Aligned>
+	struct compute_affineInverse<float, Q, Aligned>
+	{
+		GLM_FUNC_QUALIFIER static mat<4, 4, float, Q> call(mat<4, 4, float, Q> const& m)
+		{
+			glm_vec4 const In[4] = {_mm_loadu_ps(&m[0][0]), _mm_loadu_ps(&m[1][0]), _mm_loadu_ps(&m[2][0]), _mm_loadu_ps(&m[3][0])};
+			glm_vec4 Out[4];
+			glm_mat4_affine_inverse(In, Out);
+
+			mat<4, 4, float, Q> Result;
+			for(length_t i = 0; i < 4; ++i)
+				_mm_storeu_ps(&Result[i][0], Out[i]);
+			return Result;
+		}
+	};
+}//namespace detail
+}//namespace glm
+
+#endif//GLM_ARCH & GLM_ARCH_AVX_BIT
@@ -20,12 +20,14 @@
 #include "../detail/setup.hpp"
 #include "../detail/qualifier.hpp"
 #include "../detail/_noise.hpp"
+#include "../detail/_lanes.hpp"
 #include "../geometric.hpp"
 #include "../common.hpp"
 #include "../vector_relational.hpp"
 #include "../vec2.hpp"
 #include "../vec3.hpp"
 #include "../vec4.hpp"
+#include <cstddef>
 
 #if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
 #	pragma message("GLM: GLM_GTC_noise extension included")
@@ -55,6 +57,67 @@ namespace glm
 	GLM_FUNC_DECL T simplex(
 		vec<L, T, Q> const& p);
 
+	/// Classic perlin noise at count points: out[i] = perlin(p[i]) up to float rounding.
+	/// Evaluates 8 or 4 points at a time with AVX or SSE2, one at a time otherwise.
+	/// @see gtc_noise
+	template<qualifier Q>
+	GLM_FUNC_DECL void perlin(
+		vec<2, float, Q> const* p,
+		float* out,
+		std::size_t count);
+
+	/// Simplex noise at count points: out[i] = simplex(p[i]) up to float rounding.
+	/// @see gtc_noise
+	template<length_t L, qualifier Q>
+	GLM_FUNC_DECL void simplex(
+		vec<L, float, Q> const* p,
+		float* out,
+		std::size_t count);
+
+	/// Fractal Brownian motion over simplex noise at count points.
+	/// Octave k samples p * lacunarity^k with weight gain^k, and the sum is
+	/// divided by the total weight so the result stays in [-1, 1].
+	/// @see gtc_noise
+	template<length_t L, qualifier Q>
+	GLM_FUNC_DECL void simplexFbm(
+		vec<L, float, Q> const* p,
+		float* out,
+		std::size_t count,
+		int octaves,
+		float lacunarity = 2.0f,
+		float gain = 0.5f);
+
+	/// Fills rows [firstRow, lastRow) of a width-wide grid of simplex fBm:
+	/// out[y * width + x] samples origin + vec2(x, y) * step. Disjoint row
+	/// ranges can be filled from different threads.
+	/// @see gtc_noise
+	template<qualifier Q>
+	GLM_FUNC_DECL void simplexGrid(
+		vec<2, float, Q> const& origin,
+		vec<2, float, Q> const& step,
+		std::size_t width,
+		std::size_t firstRow,
+		std::size_t lastRow,
+		float* out,
+		int octaves = 1,
+		float lacunarity = 2.0f,
+		float gain = 0.5f);
+
+	/// The same over the plane z = origin.z of 3D simplex noise; moving
+	/// origin.z over time animates the field.
+	/// @see gtc_noise
+	template<qualifier Q>
+	GLM_FUNC_DECL void simplexGrid(
+		vec<3, float, Q> const& origin,
+		vec<2, float, Q> const& step,
+		std::size_t width,
+		std::size_t firstRow,
+		std::size_t lastRow,
+		float* out,
+		int octaves = 1,
+		float lacunarity = 2.0f,
+		float gain = 0.5f);
+
 	/// @}
 }//namespace glm
 
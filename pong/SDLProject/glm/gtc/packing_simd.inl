@@ -0,0 +1,139 @@
+/// @ref gtc_packing
+/// @file glm/gtc/packing_simd.inl
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+namespace glm{
+namespace detail
+{
+	// Blocks of 8 values for the array conversions in packing.inl. With SSE2
+	// the results equal the scalar functions bit for bit; F16C rounds half
+	// floats to nearest even where toFloat16 rounds ties away from zero, and quiets NaNs.
+
+	// Four 32-bit lanes holding 16-bit results to four packed uint16
+	GLM_FUNC_QUALIFIER __m128i pack_low16(__m128i a, __m128i b)
+	{
+		// Sign-extend first so the saturating pack keeps the bit pattern
+		return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16), _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+	}
+
+	GLM_FUNC_QUALIFIER __m128i select_si128(__m128i m, __m128i a, __m128i b)
+	{
+		return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+	}
+
+	// Rounds x >= 0 to the nearest integer, ties away from zero, like round()
+	GLM_FUNC_QUALIFIER __m128i round_unsigned(__m128 x)
+	{
+		__m128i const t = _mm_cvttps_epi32(x);
+		__m128 const up = _mm_cmpge_ps(_mm_sub_ps(x, _mm_cvtepi32_ps(t)), _mm_set1_ps(0.5f));
+		return _mm_sub_epi32(t, _mm_castps_si128(up));
+	}
+
+	// Rounds x to the nearest integer, ties away from zero, like round()
+	GLM_FUNC_QUALIFIER __m128i round_signed(__m128 x)
+	{
+		__m128i const t = _mm_cvttps_epi32(x);
+		__m128 const f = _mm_sub_ps(x, _mm_cvtepi32_ps(t));
+		__m128 const up = _mm_cmpge_ps(f, _mm_set1_ps(0.5f));
+		__m128 const down = _mm_cmple_ps(f, _mm_set1_ps(-0.5f));
+		return _mm_add_epi32(_mm_sub_epi32(t, _mm_castps_si128(up)), _mm_castps_si128(down));
+	}
+
+	// toFloat16 on four lanes
+	GLM_FUNC_QUALIFIER __m128i to_float16(__m128 v)
+	{
+		__m128i const i = _mm_castps_si128(v);
+		__m128i const s = _mm_and_si128(_mm_srli_epi32(i, 16), _mm_set1_epi32(0x8000));
+		__m128i const a = _mm_and_si128(i, _mm_set1_epi32(0x7fffffff));
+
+		// Normalized: rebias the exponent and round on bit 12; a carry into the
+		// exponent is correct as is, and anything past the largest half is infinity.
+		__m128i n = _mm_srli_epi32(_mm_add_epi32(_mm_sub_epi32(a, _mm_set1_epi32(0x38000000)), _mm_set1_epi32(0x1000)), 13);
+		n = select_si128(_mm_cmpgt_epi32(n, _mm_set1_epi32(0x7c00)), _mm_set1_epi32(0x7c00), n);
+
+		// Denormalized: |v| * 2^24 rounded half up is the significand
+		__m128 const d = _mm_add_ps(_mm_mul_ps(_mm_castsi128_ps(a), _mm_set1_ps(16777216.0f)), _mm_set1_ps(0.5f));
+		__m128i const dn = _mm_cvttps_epi32(d);
+
+		// Infinity, or a NaN that keeps its top 10 significand bits and at least one set bit
+		__m128i const m = _mm_srli_epi32(_mm_and_si128(i, _mm_set1_epi32(0x007fffff)), 13);
+		__m128i const nanBit = _mm_and_si128(_mm_cmpeq_epi32(m, _mm_setzero_si128()), _mm_set1_epi32(1));
+		__m128i const special = select_si128(_mm_cmpeq_epi32(a, _mm_set1_epi32(0x7f800000)), _mm_set1_epi32(0x7c00), _mm_or_si128(_mm_set1_epi32(0x7c00), _mm_or_si128(m, nanBit)));
+
+		__m128i r = select_si128(_mm_cmplt_epi32(a, _mm_set1_epi32(0x38800000)), dn, n);
+		r = select_si128(_mm_cmplt_epi32(a, _mm_set1_epi32(0x33000000)), _mm_setzero_si128(), r);
+		r = select_si128(_mm_cmpgt_epi32(a, _mm_set1_epi32(0x7f7fffff)), special, r);
+		return _mm_or_si128(r, s);
+	}
+
+	// toFloat32 on four lanes held in the low 16 bits of each 32-bit lane
+	GLM_FUNC_QUALIFIER __m128 to_float32(__m128i h)
+	{
+		__m128i const e = _mm_set1_epi32(0x7c00 << 13);
+		__m128i o = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7fff)), 13);
+		__m128i const exp = _mm_and_si128(o, e);
+		o = _mm_add_epi32(o, _mm_set1_epi32((127 - 15) << 23));
+
+		// Infinity and NaN get the rest of the float exponent
+		__m128i const special = _mm_cmpeq_epi32(exp, e);
+		o = _mm_add_epi32(o, _mm_and_si128(special, _mm_set1_epi32((128 - 16) << 23)));
+
+		// Denormals: one more exponent step, then subtract the implicit bit as a float
+		__m128i const denormal = _mm_cmpeq_epi32(exp, _mm_setzero_si128());
+		__m128 const renormalized = _mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(o, _mm_set1_epi32(1 << 23))), _mm_castsi128_ps(_mm_set1_epi32(113 << 23)));
+		o = select_si128(denormal, _mm_castps_si128(renormalized), o);
+
+		return _mm_castsi128_ps(_mm_or_si128(o, _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16)));
+	}
+
+	GLM_FUNC_QUALIFIER void packHalf8(float const* v, uint16* p)
+	{
+#		if (GLM_ARCH & GLM_ARCH_AVX_BIT) && (defined(__F16C__) || ((GLM_COMPILER & GLM_COMPILER_VC) && (GLM_ARCH & GLM_ARCH_AVX2_BIT)))
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_cvtps_ph(_mm256_loadu_ps(v), _MM_FROUND_TO_NEAREST_INT));
+#		else
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p), pack_low16(to_float16(_mm_loadu_ps(v)), to_float16(_mm_loadu_ps(v + 4))));
+#		endif
+	}
+
+	GLM_FUNC_QUALIFIER void unpackHalf8(uint16 const* p, float* v)
+	{
+		__m128i const h = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+#		if (GLM_ARCH & GLM_ARCH_AVX_BIT) && (defined(__F16C__) || ((GLM_COMPILER & GLM_COMPILER_VC) && (GLM_ARCH & GLM_ARCH_AVX2_BIT)))
+			_mm256_storeu_ps(v, _mm256_cvtph_ps(h));
+#		else
+			_mm_storeu_ps(v, to_float32(_mm_unpacklo_epi16(h, _mm_setzero_si128())));
+			_mm_storeu_ps(v + 4, to_float32(_mm_unpackhi_epi16(h, _mm_setzero_si128())));
+#		endif
+	}
+
+	GLM_FUNC_QUALIFIER __m128 clamp_ps(__m128 v, float lo, float hi)
+	{
+		return _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(lo)), _mm_set1_ps(hi));
+	}
+
+	GLM_FUNC_QUALIFIER void packUnorm1x16_8(float const* v, uint16* p)
+	{
+		__m128i const a = round_unsigned(_mm_mul_ps(clamp_ps(_mm_loadu_ps(v), 0.0f, 1.0f), _mm_set1_ps(65535.0f)));
+		__m128i const b = round_unsigned(_mm_mul_ps(clamp_ps(_mm_loadu_ps(v + 4), 0.0f, 1.0f), _mm_set1_ps(65535.0f)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p), pack_low16(a, b));
+	}
+
+	GLM_FUNC_QUALIFIER void packSnorm1x16_8(float const* v, uint16* p)
+	{
+		__m128i const a = round_signed(_mm_mul_ps(clamp_ps(_mm_loadu_ps(v), -1.0f, 1.0f), _mm_set1_ps(32767.0f)));
+		__m128i const b = round_signed(_mm_mul_ps(clamp_ps(_mm_loadu_ps(v + 4), -1.0f, 1.0f), _mm_set1_ps(32767.0f)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_packs_epi32(a, b));
+	}
+
+	GLM_FUNC_QUALIFIER void packUnorm1x8_8(float const* v, uint8* p)
+	{
+		__m128i const a = round_unsigned(_mm_mul_ps(clamp_ps(_mm_loadu_ps(v), 0.0f, 1.0f), _mm_set1_ps(255.0f)));
+		__m128i const b = round_unsigned(_mm_mul_ps(clamp_ps(_mm_loadu_ps(v + 4), 0.0f, 1.0f), _mm_set1_ps(255.0f)));
+		__m128i const words = _mm_packs_epi32(a, b);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packus_epi16(words, words));
+	}
+}//namespace detail
+}//namespace glm
+
+#endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
@@ -14,6 +14,8 @@
 
 // Dependency:
 #include "../gtc/constants.hpp"
+#include "../detail/_lanes.hpp"
+#include <cstddef>
 
 #if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
 #	ifndef GLM_ENABLE_EXPERIMENTAL
@@ -73,6 +75,27 @@ namespace glm
 	template<typename T>
 	GLM_FUNC_DECL T fastAtan(T angle);
 
+	/// Sines of count angles in radians, 8 or 4 at a time with AVX or SSE2.
+	/// Cody-Waite reduction by pi/2 and minimax polynomials: at most 2 ULP from
+	/// the correctly rounded result for |angle| <= pi and 6 ULP for |angle| <= 100.
+	/// Up to |angle| = 8192 the absolute error stays below 1e-7, but results
+	/// near a zero lose relative precision. out may alias angles.
+	/// From GLM_GTX_fast_trigonometry extension.
+	GLM_FUNC_DECL void fastSin(float const* angles, float* out, std::size_t count);
+
+	/// Cosines of count angles in radians; same method and error bound as the array fastSin.
+	/// From GLM_GTX_fast_trigonometry extension.
+	GLM_FUNC_DECL void fastCos(float const* angles, float* out, std::size_t count);
+
+	/// Sines and cosines of count angles from one range reduction.
+	/// From GLM_GTX_fast_trigonometry extension.
+	GLM_FUNC_DECL void fastSinCos(float const* angles, float* sines, float* cosines, std::size_t count);
+
+	/// atan2(y[i], x[i]) for count finite pairs, in [-pi, pi]; at most 3 ULP.
+	/// Signed zeros follow std::atan2: atan2(+-0, +0) is +-0 and atan2(+-0, -0) is +-pi.
+	/// From GLM_GTX_fast_trigonometry extension.
+	GLM_FUNC_DECL void fastAtan(float const* y, float const* x, float* out, std::size_t count);
+
 	/// @}
 }//namespace glm
 
@@ -0,0 +1,211 @@
+/// @ref gtx_soa
+/// @file glm/gtx/soa.hpp
+///
+/// @see core (dependence)
+///
+/// @defgroup gtx_soa GLM_GTX_soa
+/// @ingroup gtx
+///
+/// Include <glm/gtx/soa.hpp> to use the features of this extension.
+///
+/// Structure-of-arrays storage for vectors and batch transform kernels.
+/// Each component lives in its own 32-byte aligned array padded to a multiple
+/// of 8 elements, so float kernels can run 8 points at a time with AVX
+/// (fused multiply-add when the compiler enables FMA) and fall back to scalar
+/// code otherwise.
+///
+/// Rotations batch the same way: soa<quat> for 3D, and for 2D rotors held as
+/// (cos(angle / 2), sin(angle / 2)) in a soa<vec2>, which are quaternions
+/// about z with only their w and z parts stored.
+
+#pragma once
+
+// Dependency:
+#include "../glm.hpp"
+#include "../gtc/quaternion.hpp"
+#include "fast_square_root.hpp"
+#include "fast_trigonometry.hpp"
+#include <cstddef>
+
+#if GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
+#	ifndef GLM_ENABLE_EXPERIMENTAL
+#		pragma message("GLM: GLM_GTX_soa is an experimental extension and may change in the future. Use #define GLM_ENABLE_EXPERIMENTAL before including it, if you really want to use it.")
+#	else
+#		pragma message("GLM: GLM_GTX_soa extension included")
+#	endif
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_soa
+	/// @{
+
+	template<typename vecType>
+	class soa;
+
+	/// Structure-of-arrays container of L-component vectors.
+	/// component(c)[i] is component c of element i. Elements added by resize()
+	/// are zero; the padding past size() is scratch space for the kernels.
+	///
+	/// @see gtx_soa
+	template<length_t L, typename T, qualifier Q>
+	class soa<vec<L, T, Q> >
+	{
+	public:
+		typedef vec<L, T, Q> value_type;
+		typedef T component_type;
+
+		static const length_t components = L;
+		static const std::size_t alignment = 32;
+		static const std::size_t lanes = 8;
+
+		soa();
+		explicit soa(std::size_t count);
+		soa(soa const& other);
+		soa(soa&& other);
+		~soa();
+
+		soa& operator=(soa const& other);
+		soa& operator=(soa&& other);
+
+		std::size_t size() const { return this->count_; }
+		std::size_t capacity() const { return this->capacity_; }
+		bool empty() const { return this->count_ == 0; }
+
+		void reserve(std::size_t count);
+		void resize(std::size_t count);
+		void clear() { this->count_ = 0; }
+
+		void push_back(value_type const& v);
+		value_type get(std::size_t i) const;
+		void set(std::size_t i, value_type const& v);
+
+		T* component(length_t c) { return this->data_ + c * this->capacity_; }
+		T const* component(length_t c) const { return this->data_ + c * this->capacity_; }
+
+	private:
+		void reallocate(std::size_t capacity);
+
+		void* block_;
+		T* data_;
+		std::size_t count_;
+		std::size_t capacity_;
+	};
+
+	/// Structure-of-arrays container of quaternions. Components are stored as
+	/// x, y, z, w whatever the memory layout of qua, so the container is also a
+	/// soa<vec4> of (x, y, z, w).
+	///
+	/// @see gtx_soa
+	template<typename T, qualifier Q>
+	class soa<qua<T, Q> > : public soa<vec<4, T, Q> >
+	{
+	public:
+		typedef qua<T, Q> value_type;
+
+		soa() {}
+		explicit soa(std::size_t count) : soa<vec<4, T, Q> >(count) {}
+
+		void push_back(value_type const& q);
+		value_type get(std::size_t i) const;
+		void set(std::size_t i, value_type const& q);
+	};
+
+	/// How soaMix interpolates rotations.
+	///
+	/// @see gtx_soa
+	enum soa_rotation_mix
+	{
+		soa_slerp,	///< Spherical interpolation along the shortest arc, like slerp.
+		soa_nlerp	///< Normalized lerp with a corrected parameter: its rotations are within 8e-4 radians of soa_slerp's (4e-4 between the quaternions) and about 3 times faster with SIMD.
+	};
+
+	/// Transforms every vector of in by m and stores the result in out.
+	/// out is resized to in.size(); in and out may be the same container.
+	///
+	/// @see gtx_soa
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void soaTransform(mat<4, 4, T, Q> const& m, soa<vec<4, T, Q> > const& in, soa<vec<4, T, Q> >& out);
+
+	/// Transforms every point (w = 1) of in by m and keeps xyz, without the perspective divide.
+	///
+	/// @see gtx_soa
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void soaTransform(mat<4, 4, T, Q> const& m, soa<vec<3, T, Q> > const& in, soa<vec<3, T, Q> >& out);
+
+	/// Transforms every point (z = 0, w = 1) of in by m and keeps xy, without the perspective divide.
+	///
+	/// @see gtx_soa
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void soaTransform(mat<4, 4, T, Q> const& m, soa<vec<2, T, Q> > const& in, soa<vec<2, T, Q> >& out);
+
+	/// Transforms in[i] by m[i]. m must point to in.size() matrices.
+	/// out is resized to in.size(); in and out may be the same container.
+	///
+	/// @see gtx_soa
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void soaTransform(mat<4, 4, T, Q> const* m, soa<vec<4, T, Q> > const& in, soa<vec<4, T, Q> >& out);
+
+	/// Transforms the point in[i] (w = 1) by m[i] and keeps xyz.
+	///
+	/// @see gtx_soa
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void soaTransform(mat<4, 4, T, Q> const* m, soa<vec<3, T, Q> > const& in, soa<vec<3, T, Q> >& out);
+
+	/// Transforms the point in[i] (z = 0, w = 1) by m[i] and keeps xy.
+	///
+	/// @see gtx_soa
+	template<typename T, qualifier Q>
+	GLM_FUNC_DECL void soaTransform(mat<4, 4, T, Q> const* m, soa<vec<2, T, Q> > const& in, soa<vec<2, T, Q> >& out);
+
+	/// Scales every vector of in to unit length. A zero vector gives NaN or infinite components.
+	/// out is resized to in.size(); in and out may be the same container. Also normalizes
+	/// quaternions and 2D rotors.
+	///
+	/// @see gtx_soa
+	template<length_t L, qualifier Q>
+	GLM_FUNC_DECL void soaNormalize(soa<vec<L, float, Q> > const& in, soa<vec<L, float, Q> >& out);
+
+	/// Advances every point by one semi-implicit Euler step: velocities[i] += acceleration * deltaTime,
+	/// then positions[i] += velocities[i] * deltaTime. positions and velocities must have the same size.
+	///
+	/// @see gtx_soa
+	template<length_t L, qualifier Q>
+	GLM_FUNC_DECL void soaIntegrate(soa<vec<L, float, Q> >& positions, soa<vec<L, float, Q> >& velocities, vec<L, float, Q> const& acceleration, float deltaTime);
+
+	/// Interpolates between the unit quaternions x[i] and y[i] by a, along the shortest arc.
+	/// x and y must have the same size; out is resized to it and may be x or y.
+	///
+	/// @see gtx_soa
+	template<qualifier Q>
+	GLM_FUNC_DECL void soaMix(soa<qua<float, Q> > const& x, soa<qua<float, Q> > const& y, float a, soa<qua<float, Q> >& out, soa_rotation_mix mode = soa_slerp);
+
+	/// Interpolates between x[i] and y[i] by a[i]. a must point to x.size() values.
+	///
+	/// @see gtx_soa
+	template<qualifier Q>
+	GLM_FUNC_DECL void soaMix(soa<qua<float, Q> > const& x, soa<qua<float, Q> > const& y, float const* a, soa<qua<float, Q> >& out, soa_rotation_mix mode = soa_slerp);
+
+	/// Interpolates between the unit 2D rotors x[i] and y[i] by a, along the shortest arc.
+	/// x and y must have the same size; out is resized to it and may be x or y.
+	///
+	/// @see gtx_soa
+	template<qualifier Q>
+	GLM_FUNC_DECL void soaRotorMix(soa<vec<2, float, Q> > const& x, soa<vec<2, float, Q> > const& y, float a, soa<vec<2, float, Q> >& out, soa_rotation_mix mode = soa_slerp);
+
+	/// Interpolates between the 2D rotors x[i] and y[i] by a[i]. a must point to x.size() values.
+	///
+	/// @see gtx_soa
+	template<qualifier Q>
+	GLM_FUNC_DECL void soaRotorMix(soa<vec<2, float, Q> > const& x, soa<vec<2, float, Q> > const& y, float const* a, soa<vec<2, float, Q> >& out, soa_rotation_mix mode = soa_slerp);
+
+	/// Writes mat4_cast(q[i]) to out[i] for every unit quaternion of q.
+	///
+	/// @see gtx_soa
+	template<qualifier Q>
+	GLM_FUNC_DECL void soaMat4Cast(soa<qua<float, Q> > const& q, mat<4, 4, float, Q>* out);
+
+	/// @}
+}// namespace glm
+
+#include "soa.inl"
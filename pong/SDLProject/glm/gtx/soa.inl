@@ -0,0 +1,671 @@
+/// @ref gtx_soa
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace glm{
+namespace detail
+{
+	// Input components past L are implicit: z = 0 and w = 1, so vec2 and vec3
+	// batches are transformed as points.
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void soa_transform_point(mat<4, 4, T, Q> const& m, T const* const* in, T* const* out, std::size_t i)
+	{
+		T const x = in[0][i];
+		T const y = in[1][i];
+		T const z = L > 2 ? in[2][i] : static_cast<T>(0);
+		T const w = L > 3 ? in[3][i] : static_cast<T>(1);
+
+		T const rx = m[0][0] * x + m[1][0] * y + m[2][0] * z + m[3][0] * w;
+		T const ry = m[0][1] * x + m[1][1] * y + m[2][1] * z + m[3][1] * w;
+		T const rz = m[0][2] * x + m[1][2] * y + m[2][2] * z + m[3][2] * w;
+		T const rw = m[0][3] * x + m[1][3] * y + m[2][3] * z + m[3][3] * w;
+
+		out[0][i] = rx;
+		out[1][i] = ry;
+		if(L > 2)
+			out[2][i] = rz;
+		if(L > 3)
+			out[3][i] = rw;
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void soa_transform_scalar(mat<4, 4, T, Q> const* m, std::size_t stride, T const* const* in, T* const* out, std::size_t first, std::size_t last)
+	{
+		if(stride == 0)
+		{
+			// A local copy cannot alias out, so the matrix stays in registers.
+			mat<4, 4, T, Q> const M = *m;
+			for(std::size_t i = first; i < last; ++i)
+				soa_transform_point<L>(M, in, out, i);
+		}
+		else
+		{
+			for(std::size_t i = first; i < last; ++i)
+				soa_transform_point<L>(m[i], in, out, i);
+		}
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	struct compute_soa_transform
+	{
+		GLM_FUNC_QUALIFIER static void call(mat<4, 4, T, Q> const* m, std::size_t stride, T const* const* in, T* const* out, std::size_t count)
+		{
+			soa_transform_scalar<L, T, Q>(m, stride, in, out, 0, count);
+		}
+	};
+
+#	if GLM_ARCH & GLM_ARCH_AVX_BIT
+	GLM_FUNC_QUALIFIER __m256 soa_madd(__m256 a, __m256 b, __m256 c)
+	{
+#		if defined(__FMA__) || ((GLM_COMPILER & GLM_COMPILER_VC) && (GLM_ARCH & GLM_ARCH_AVX2_BIT))
+			return _mm256_fmadd_ps(a, b, c);
+#		else
+			return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#		endif
+	}
+
+	// Row c of a matrix, each coefficient broadcast to the 8 lanes.
+	struct soa_row
+	{
+		__m256 x, y, z, w;
+	};
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER soa_row soa_broadcast_row(mat<4, 4, float, Q> const& m, length_t c)
+	{
+		soa_row r;
+		r.x = _mm256_set1_ps(m[0][c]);
+		r.y = _mm256_set1_ps(m[1][c]);
+		r.z = _mm256_set1_ps(m[2][c]);
+		r.w = _mm256_set1_ps(m[3][c]);
+		return r;
+	}
+
+	template<length_t L>
+	GLM_FUNC_QUALIFIER __m256 soa_dot(soa_row const& r, __m256 x, __m256 y, __m256 z, __m256 w)
+	{
+		__m256 a = L > 3 ? _mm256_mul_ps(r.w, w) : r.w;
+		if(L > 2)
+			a = soa_madd(r.z, z, a);
+		a = soa_madd(r.y, y, a);
+		return soa_madd(r.x, x, a);
+	}
+
+	// Column j of matrices K and K + 4 side by side, one per 128-bit lane.
+	template<int K, qualifier Q>
+	GLM_FUNC_QUALIFIER __m256 soa_load_columns(mat<4, 4, float, Q> const* m, length_t j)
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(&m[K][j][0])), _mm_loadu_ps(&m[K + 4][j][0]), 1);
+	}
+
+	// Points K and K + 4 of the block transformed by their own matrices, as
+	// xyzw in the low and high 128-bit lanes.
+	template<length_t L, int K, qualifier Q>
+	GLM_FUNC_QUALIFIER __m256 soa_transform_pair(mat<4, 4, float, Q> const* m, __m256 x, __m256 y, __m256 z, __m256 w)
+	{
+		__m256 a = soa_load_columns<K>(m, 3);
+		if(L > 3)
+			a = _mm256_mul_ps(a, _mm256_shuffle_ps(w, w, _MM_SHUFFLE(K, K, K, K)));
+		if(L > 2)
+			a = soa_madd(soa_load_columns<K>(m, 2), _mm256_shuffle_ps(z, z, _MM_SHUFFLE(K, K, K, K)), a);
+		a = soa_madd(soa_load_columns<K>(m, 1), _mm256_shuffle_ps(y, y, _MM_SHUFFLE(K, K, K, K)), a);
+		return soa_madd(soa_load_columns<K>(m, 0), _mm256_shuffle_ps(x, x, _MM_SHUFFLE(K, K, K, K)), a);
+	}
+
+	template<length_t L, qualifier Q>
+	struct compute_soa_transform<L, float, Q>
+	{
+		GLM_FUNC_QUALIFIER static void call(mat<4, 4, float, Q> const* m, std::size_t stride, float const* const* in, float* const* out, std::size_t count)
+		{
+			__m256 const zero = _mm256_setzero_ps();
+			__m256 const one = _mm256_set1_ps(1.0f);
+
+			if(stride == 0)
+			{
+				// One matrix: broadcast it once. Component arrays are padded to a
+				// multiple of 8, so the last partial block runs in full.
+				soa_row const r0 = soa_broadcast_row(*m, 0);
+				soa_row const r1 = soa_broadcast_row(*m, 1);
+				soa_row const r2 = soa_broadcast_row(*m, 2);
+				soa_row const r3 = soa_broadcast_row(*m, 3);
+
+				for(std::size_t i = 0; i < count; i += 8)
+				{
+					__m256 const x = _mm256_load_ps(in[0] + i);
+					__m256 const y = _mm256_load_ps(in[1] + i);
+					__m256 const z = L > 2 ? _mm256_load_ps(in[2] + i) : zero;
+					__m256 const w = L > 3 ? _mm256_load_ps(in[3] + i) : one;
+
+					__m256 const rx = soa_dot<L>(r0, x, y, z, w);
+					__m256 const ry = soa_dot<L>(r1, x, y, z, w);
+					__m256 const rz = soa_dot<L>(r2, x, y, z, w);
+					__m256 const rw = soa_dot<L>(r3, x, y, z, w);
+
+					_mm256_store_ps(out[0] + i, rx);
+					_mm256_store_ps(out[1] + i, ry);
+					if(L > 2)
+						_mm256_store_ps(out[2] + i, rz);
+					if(L > 3)
+						_mm256_store_ps(out[3] + i, rw);
+				}
+				return;
+			}
+
+			// One matrix per point: transform the block as four pairs of points,
+			// then transpose the xyzw results back into component arrays. This
+			// reads each matrix with four vector loads where gathers would need 16.
+			std::size_t i = 0;
+			for(; i + 8 <= count; i += 8)
+			{
+				__m256 const x = _mm256_load_ps(in[0] + i);
+				__m256 const y = _mm256_load_ps(in[1] + i);
+				__m256 const z = L > 2 ? _mm256_load_ps(in[2] + i) : zero;
+				__m256 const w = L > 3 ? _mm256_load_ps(in[3] + i) : one;
+
+				__m256 const p0 = soa_transform_pair<L, 0>(m + i, x, y, z, w);
+				__m256 const p1 = soa_transform_pair<L, 1>(m + i, x, y, z, w);
+				__m256 const p2 = soa_transform_pair<L, 2>(m + i, x, y, z, w);
+				__m256 const p3 = soa_transform_pair<L, 3>(m + i, x, y, z, w);
+
+				__m256 const t0 = _mm256_unpacklo_ps(p0, p1);
+				__m256 const t1 = _mm256_unpackhi_ps(p0, p1);
+				__m256 const t2 = _mm256_unpacklo_ps(p2, p3);
+				__m256 const t3 = _mm256_unpackhi_ps(p2, p3);
+
+				_mm256_store_ps(out[0] + i, _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)));
+				_mm256_store_ps(out[1] + i, _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)));
+				if(L > 2)
+					_mm256_store_ps(out[2] + i, _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+				if(L > 3)
+					_mm256_store_ps(out[3] + i, _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+			}
+			soa_transform_scalar<L, float, Q>(m, stride, in, out, i, count);
+		}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_AVX_BIT
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void soa_transform(mat<4, 4, T, Q> const* m, std::size_t stride, soa<vec<L, T, Q> > const& in, soa<vec<L, T, Q> >& out)
+	{
+		out.resize(in.size());
+
+		T const* src[4] = {NULL, NULL, NULL, NULL};
+		T* dst[4] = {NULL, NULL, NULL, NULL};
+		for(length_t c = 0; c < L; ++c)
+		{
+			src[c] = in.component(c);
+			dst[c] = out.component(c);
+		}
+		compute_soa_transform<L, T, Q>::call(m, stride, src, dst, in.size());
+	}
+
+	// Rotations: L = 4 for quaternions (x, y, z, w), L = 2 for 2D rotors.
+	template<length_t L, typename V>
+	GLM_FUNC_QUALIFIER V soa_rotation_dot(V const* x, V const* y)
+	{
+		typedef lanes<V> W;
+
+		V d = W::mul(x[0], y[0]);
+		for(length_t c = 1; c < L; ++c)
+			d = W::fma(x[c], y[c], d);
+		return d;
+	}
+
+	// out = wx * x + wy * y, with the sign of wy already chosen for the shortest arc
+	template<length_t L, typename V>
+	GLM_FUNC_QUALIFIER void soa_rotation_blend(V const* x, V wx, V const* y, V wy, V* out)
+	{
+		typedef lanes<V> W;
+
+		for(length_t c = 0; c < L; ++c)
+			out[c] = W::fma(wx, x[c], W::mul(wy, y[c]));
+	}
+
+	template<length_t L, typename V>
+	GLM_FUNC_QUALIFIER void soa_rotation_normalize(V* v)
+	{
+		typedef lanes<V> W;
+
+		V const s = inversesqrt_lanes(soa_rotation_dot<L>(v, v));
+		for(length_t c = 0; c < L; ++c)
+			v[c] = W::mul(v[c], s);
+	}
+
+	template<length_t L, typename V>
+	GLM_FUNC_QUALIFIER void soa_rotation_slerp(V const* x, V const* y, V a, V* out)
+	{
+		typedef lanes<V> W;
+		typedef typename W::mask M;
+
+		// Flip y onto the hemisphere of x. The angle between them comes from
+		// |x - y| and |x + y|, which stays accurate where acos(dot) does not.
+		M const flip = W::lt(soa_rotation_dot<L>(x, y), W::set1(0.0f));
+		V z[L];
+		for(length_t c = 0; c < L; ++c)
+			z[c] = W::negate_if(flip, y[c]);
+
+		V d[L], s[L];
+		for(length_t c = 0; c < L; ++c)
+		{
+			d[c] = W::sub(x[c], z[c]);
+			s[c] = W::add(x[c], z[c]);
+		}
+		V const angle = W::mul(W::set1(2.0f), atan2_lanes(W::sqrt(soa_rotation_dot<L>(d, d)), W::sqrt(soa_rotation_dot<L>(s, s))));
+
+		// sin((1 - a) t) = sin t cos(a t) - cos t sin(a t)
+		V sinAngle, cosAngle, sinA, cosA;
+		sincos_lanes(angle, sinAngle, cosAngle);
+		sincos_lanes(W::mul(a, angle), sinA, cosA);
+		V const inverseSin = W::div(W::set1(1.0f), sinAngle);
+		V wx = W::mul(W::sub(W::mul(sinAngle, cosA), W::mul(cosAngle, sinA)), inverseSin);
+		V wz = W::mul(sinA, inverseSin);
+
+		// Below 2^-20 radians the linear weights are exact to float precision
+		M const tiny = W::lt(angle, W::set1(9.5367431640625e-7f));
+		wx = W::select(tiny, W::sub(W::set1(1.0f), a), wx);
+		wz = W::select(tiny, a, wz);
+
+		soa_rotation_blend<L>(x, wx, z, wz, out);
+	}
+
+	template<length_t L, typename V>
+	GLM_FUNC_QUALIFIER void soa_rotation_nlerp(V const* x, V const* y, V a, V* out)
+	{
+		typedef lanes<V> W;
+
+		// Parameter correction fitted to slerp over the cosine of the angle
+		// (Kapoulkine, "Approximating slerp"), then nlerp along the shortest arc.
+		V const cosine = soa_rotation_dot<L>(x, y);
+		V const d = W::abs(cosine);
+		V const A = W::fma(W::fma(W::fma(W::set1(-1.43519f), d, W::set1(3.55645f)), d, W::set1(-3.2452f)), d, W::set1(1.0904f));
+		V const B = W::fma(W::fma(W::set1(0.215638f), d, W::set1(-1.06021f)), d, W::set1(0.848013f));
+		V const h = W::sub(a, W::set1(0.5f));
+		V const k = W::fma(W::mul(A, h), h, B);
+		V const t = W::fma(W::mul(W::mul(a, h), W::sub(a, W::set1(1.0f))), k, a);
+
+		V const wz = W::negate_if(W::lt(cosine, W::set1(0.0f)), t);
+		soa_rotation_blend<L>(x, W::sub(W::set1(1.0f), t), y, wz, out);
+		soa_rotation_normalize<L>(out);
+	}
+
+	// One rotation at a time plain arithmetic beats the bitmask lanes, so the
+	// scalar path goes through qua, with a rotor as the quaternion (c, 0, 0, s).
+	template<length_t L>
+	GLM_FUNC_QUALIFIER qua<float, defaultp> soa_rotation_load(float const* const* v, std::size_t i)
+	{
+		return L == 4 ? qua<float, defaultp>(v[3][i], v[0][i], v[1][i], v[2][i]) : qua<float, defaultp>(v[0][i], 0.0f, 0.0f, v[L - 1][i]);
+	}
+
+	template<length_t L>
+	GLM_FUNC_QUALIFIER void soa_rotation_store(qua<float, defaultp> const& q, float* const* v, std::size_t i)
+	{
+		if(L == 4)
+		{
+			v[0][i] = q.x;
+			v[1][i] = q.y;
+			v[2][i] = q.z;
+			v[3][i] = q.w;
+		}
+		else
+		{
+			v[0][i] = q.w;
+			v[L - 1][i] = q.z;
+		}
+	}
+
+	GLM_FUNC_QUALIFIER qua<float, defaultp> soa_rotation_nlerp(qua<float, defaultp> const& x, qua<float, defaultp> const& y, float a)
+	{
+		float const cosine = dot(x, y);
+		float const d = std::fabs(cosine);
+		float const A = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+		float const B = 0.848013f + d * (-1.06021f + d * 0.215638f);
+		float const k = A * (a - 0.5f) * (a - 0.5f) + B;
+		float const t = a + a * (a - 0.5f) * (a - 1.0f) * k;
+
+		return normalize(x * (1.0f - t) + y * (cosine < 0.0f ? -t : t));
+	}
+
+	template<length_t L, typename V>
+	GLM_FUNC_QUALIFIER void soa_rotation_mix_at(float const* const* x, float const* const* y, float const* a, std::size_t stride, float* const* out, std::size_t i, soa_rotation_mix mode)
+	{
+		typedef lanes<V> W;
+
+		V vx[L], vy[L], r[L];
+		for(length_t c = 0; c < L; ++c)
+		{
+			vx[c] = W::load(x[c] + i);
+			vy[c] = W::load(y[c] + i);
+		}
+		V const va = stride == 0 ? W::set1(*a) : W::load(a + i);
+
+		if(mode == soa_slerp)
+			soa_rotation_slerp<L>(vx, vy, va, r);
+		else
+			soa_rotation_nlerp<L>(vx, vy, va, r);
+
+		for(length_t c = 0; c < L; ++c)
+			W::store(out[c] + i, r[c]);
+	}
+
+	template<length_t L, qualifier Q>
+	GLM_FUNC_QUALIFIER void soa_mix_rotations(soa<vec<L, float, Q> > const& x, soa<vec<L, float, Q> > const& y, float const* a, std::size_t stride, soa<vec<L, float, Q> >& out, soa_rotation_mix mode)
+	{
+		typedef widest_lanes W;
+
+		assert(x.size() == y.size());
+		out.resize(x.size());
+
+		float const* px[L];
+		float const* py[L];
+		float* pout[L];
+		for(length_t c = 0; c < L; ++c)
+		{
+			px[c] = x.component(c);
+			py[c] = y.component(c);
+			pout[c] = out.component(c);
+		}
+
+		// a may be a plain array, so only whole blocks run wide
+		std::size_t const count = x.size();
+		std::size_t const body = W::width > 1 ? count - count % W::width : 0;
+
+		std::size_t i = 0;
+		for(; i < body; i += W::width)
+			soa_rotation_mix_at<L, W::type>(px, py, a, stride, pout, i, mode);
+		for(; i < count; ++i)
+		{
+			qua<float, defaultp> const qx = soa_rotation_load<L>(px, i);
+			qua<float, defaultp> const qy = soa_rotation_load<L>(py, i);
+			float const ai = a[stride * i];
+			soa_rotation_store<L>(mode == soa_slerp ? slerp(qx, qy, ai) : soa_rotation_nlerp(qx, qy, ai), pout, i);
+		}
+	}
+}//namespace detail
+
+	template<length_t L, typename T, qualifier Q>
+	const length_t soa<vec<L, T, Q> >::components;
+
+	template<length_t L, typename T, qualifier Q>
+	const std::size_t soa<vec<L, T, Q> >::alignment;
+
+	template<length_t L, typename T, qualifier Q>
+	const std::size_t soa<vec<L, T, Q> >::lanes;
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER soa<vec<L, T, Q> >::soa()
+		: block_(NULL), data_(NULL), count_(0), capacity_(0)
+	{}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER soa<vec<L, T, Q> >::soa(std::size_t count)
+		: block_(NULL), data_(NULL), count_(0), capacity_(0)
+	{
+		this->resize(count);
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER soa<vec<L, T, Q> >::soa(soa const& other)
+		: block_(NULL), data_(NULL), count_(0), capacity_(0)
+	{
+		*this = other;
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER soa<vec<L, T, Q> >::soa(soa&& other)
+		: block_(other.block_), data_(other.data_), count_(other.count_), capacity_(other.capacity_)
+	{
+		other.block_ = NULL;
+		other.data_ = NULL;
+		other.count_ = 0;
+		other.capacity_ = 0;
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER soa<vec<L, T, Q> >::~soa()
+	{
+		std::free(this->block_);
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER soa<vec<L, T, Q> >& soa<vec<L, T, Q> >::operator=(soa const& other)
+	{
+		if(this == &other)
+			return *this;
+
+		this->count_ = 0;
+		this->reserve(other.count_);
+		if(other.count_ > 0)
+			for(length_t c = 0; c < L; ++c)
+				std::memcpy(this->component(c), other.component(c), other.count_ * sizeof(T));
+		this->count_ = other.count_;
+		return *this;
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER soa<vec<L, T, Q> >& soa<vec<L, T, Q> >::operator=(soa&& other)
+	{
+		if(this == &other)
+			return *this;
+
+		std::free(this->block_);
+		this->block_ = other.block_;
+		this->data_ = other.data_;
+		this->count_ = other.count_;
+		this->capacity_ = other.capacity_;
+		other.block_ = NULL;
+		other.data_ = NULL;
+		other.count_ = 0;
+		other.capacity_ = 0;
+		return *this;
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void soa<vec<L, T, Q> >::reallocate(std::size_t capacity)
+	{
+		std::size_t const bytes = capacity * L * sizeof(T);
+		void* block = std::malloc(bytes + alignment);
+		if(block == NULL)
+			throw std::bad_alloc();
+		std::memset(block, 0, bytes + alignment);
+
+		std::size_t const address = reinterpret_cast<std::size_t>(block);
+		T* data = reinterpret_cast<T*>((address + alignment - 1) & ~(alignment - 1));
+		if(this->count_ > 0)
+			for(length_t c = 0; c < L; ++c)
+				std::memcpy(data + c * capacity, this->component(c), this->count_ * sizeof(T));
+
+		std::free(this->block_);
+		this->block_ = block;
+		this->data_ = data;
+		this->capacity_ = capacity;
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void soa<vec<L, T, Q> >::reserve(std::size_t count)
+	{
+		if(count <= this->capacity_)
+			return;
+
+		// Keep every component array a whole number of 8-wide blocks so each
+		// one starts on the alignment boundary.
+		std::size_t capacity = this->capacity_ < lanes ? lanes : this->capacity_ * 2;
+		if(capacity < count)
+			capacity = count;
+		this->reallocate((capacity + lanes - 1) & ~(lanes - 1));
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void soa<vec<L, T, Q> >::resize(std::size_t count)
+	{
+		this->reserve(count);
+		if(count > this->count_)
+			for(length_t c = 0; c < L; ++c)
+				std::memset(this->component(c) + this->count_, 0, (count - this->count_) * sizeof(T));
+		this->count_ = count;
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void soa<vec<L, T, Q> >::push_back(value_type const& v)
+	{
+		this->reserve(this->count_ + 1);
+		this->set(this->count_++, v);
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER typename soa<vec<L, T, Q> >::value_type soa<vec<L, T, Q> >::get(std::size_t i) const
+	{
+		value_type v;
+		for(length_t c = 0; c < L; ++c)
+			v[c] = this->component(c)[i];
+		return v;
+	}
+
+	template<length_t L, typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void soa<vec<L, T, Q> >::set(std::size_t i, value_type const& v)
+	{
+		for(length_t c = 0; c < L; ++c)
+			this->component(c)[i] = v[c];
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void soaTransform(mat<4, 4, T, Q> const& m, soa<vec<4, T, Q> > const& in, soa<vec<4, T, Q> >& out)
+	{
+		detail::soa_transform(&m, 0, in, out);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void soaTransform(mat<4, 4, T, Q> const& m, soa<vec<3, T, Q> > const& in, soa<vec<3, T, Q> >& out)
+	{
+		detail::soa_transform(&m, 0, in, out);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void soaTransform(mat<4, 4, T, Q> const& m, soa<vec<2, T, Q> > const& in, soa<vec<2, T, Q> >& out)
+	{
+		detail::soa_transform(&m, 0, in, out);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void soaTransform(mat<4, 4, T, Q> const* m, soa<vec<4, T, Q> > const& in, soa<vec<4, T, Q> >& out)
+	{
+		detail::soa_transform(m, 1, in, out);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void soaTransform(mat<4, 4, T, Q> const* m, soa<vec<3, T, Q> > const& in, soa<vec<3, T, Q> >& out)
+	{
+		detail::soa_transform(m, 1, in, out);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void soaTransform(mat<4, 4, T, Q> const* m, soa<vec<2, T, Q> > const& in, soa<vec<2, T, Q> >& out)
+	{
+		detail::soa_transform(m, 1, in, out);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void soa<qua<T, Q> >::push_back(value_type const& q)
+	{
+		std::size_t const i = this->size();
+		this->resize(i + 1);
+		this->set(i, q);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER typename soa<qua<T, Q> >::value_type soa<qua<T, Q> >::get(std::size_t i) const
+	{
+		return value_type(this->component(3)[i], this->component(0)[i], this->component(1)[i], this->component(2)[i]);
+	}
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void soa<qua<T, Q> >::set(std::size_t i, value_type const& q)
+	{
+		this->component(0)[i] = q.x;
+		this->component(1)[i] = q.y;
+		this->component(2)[i] = q.z;
+		this->component(3)[i] = q.w;
+	}
+
+	template<length_t L, qualifier Q>
+	GLM_FUNC_QUALIFIER void soaNormalize(soa<vec<L, float, Q> > const& in, soa<vec<L, float, Q> >& out)
+	{
+		typedef detail::widest_lanes W;
+
+		out.resize(in.size());
+
+		// The padding makes every component array a whole number of blocks
+		for(std::size_t i = 0; i < in.size(); i += W::width)
+		{
+			W::type v[L];
+			for(length_t c = 0; c < L; ++c)
+				v[c] = W::load(in.component(c) + i);
+			detail::soa_rotation_normalize<L>(v);
+			for(length_t c = 0; c < L; ++c)
+				W::store(out.component(c) + i, v[c]);
+		}
+	}
+
+	template<length_t L, qualifier Q>
+	GLM_FUNC_QUALIFIER void soaIntegrate(soa<vec<L, float, Q> >& positions, soa<vec<L, float, Q> >& velocities, vec<L, float, Q> const& acceleration, float deltaTime)
+	{
+		typedef detail::widest_lanes W;
+
+		assert(positions.size() == velocities.size());
+
+		typename W::type const dt = W::set1(deltaTime);
+		typename W::type dv[L];
+		for(length_t c = 0; c < L; ++c)
+			dv[c] = W::set1(acceleration[c] * deltaTime);
+
+		// One component at a time through local pointers, which stores through them cannot change;
+		// padding past size() is scratch, so whole blocks run to the end
+		std::size_t const count = positions.size();
+		for(length_t c = 0; c < L; ++c)
+		{
+			float* const p = positions.component(c);
+			float* const v = velocities.component(c);
+			for(std::size_t i = 0; i < count; i += W::width)
+			{
+				typename W::type const velocity = W::add(W::load(v + i), dv[c]);
+				W::store(v + i, velocity);
+				W::store(p + i, W::fma(velocity, dt, W::load(p + i)));
+			}
+		}
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void soaMix(soa<qua<float, Q> > const& x, soa<qua<float, Q> > const& y, float a, soa<qua<float, Q> >& out, soa_rotation_mix mode)
+	{
+		detail::soa_mix_rotations<4, Q>(x, y, &a, 0, out, mode);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void soaMix(soa<qua<float, Q> > const& x, soa<qua<float, Q> > const& y, float const* a, soa<qua<float, Q> >& out, soa_rotation_mix mode)
+	{
+		detail::soa_mix_rotations<4, Q>(x, y, a, 1, out, mode);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void soaRotorMix(soa<vec<2, float, Q> > const& x, soa<vec<2, float, Q> > const& y, float a, soa<vec<2, float, Q> >& out, soa_rotation_mix mode)
+	{
+		detail::soa_mix_rotations<2, Q>(x, y, &a, 0, out, mode);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void soaRotorMix(soa<vec<2, float, Q> > const& x, soa<vec<2, float, Q> > const& y, float const* a, soa<vec<2, float, Q> >& out, soa_rotation_mix mode)
+	{
+		detail::soa_mix_rotations<2, Q>(x, y, a, 1, out, mode);
+	}
+
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void soaMat4Cast(soa<qua<float, Q> > const& q, mat<4, 4, float, Q>* out)
+	{
+		// Each matrix is written whole; the compiler already vectorizes mat4_cast
+		// better than a wide kernel that has to scatter its results.
+		for(std::size_t i = 0; i < q.size(); ++i)
+			out[i] = mat4_cast(q.get(i));
+	}
+}//namespace glm
@@ -11,6 +11,9 @@
 #define GL_GLEXT_PROTOTYPES 1
 #define LOG(argument) std::cout << argument << '\n'
 #define STB_IMAGE_IMPLEMENTATION
+#define STBI_MALLOC(size)                          ImageArena::Allocate(size)
+#define STBI_REALLOC_SIZED(block, old_size, size)  ImageArena::Reallocate(block, old_size, size)
+#define STBI_FREE(block)                           ImageArena::Free(block)
 
 #ifdef _WINDOWS
 #include <GL/glew.h>
@@ -21,8 +24,26 @@
 #include "glm/mat4x4.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "ShaderProgram.h"
+#include "ImageArena.h"
+#include "MappedFile.h"
+#include "CookedTexture.h"
+#include "MipChain.h"
+#include "Transform2D.h"
+#include "VertexFormat.h"
+#include "SpriteMesh.h"
+#include "World.h"
+#include "Components.h"
+#include "TransformHierarchy.h"
+#include "Systems.h"
+#include "ParticlePool.h"
+#include "ParticleRenderer.h"
+#include "TextRenderer.h"
+#include "AudioMixer.h"
+#include "AssetWatcher.h"
 #include "stb_image.h"
 #include <cmath>
+#include <cstring>
+#include <cstdio>
 
 const int WINDOW_WIDTH  = 640,
           WINDOW_HEIGHT = 480;
@@ -48,7 +69,8 @@ float RAND_X  =  rand() % 5 + (-3),
 
 
 const char V_SHADER_PATH[] = "shaders/vertex_textured.glsl",
-           F_SHADER_PATH[] = "shaders/fragment_textured.glsl";
+           F_SHADER_PATH[] = "shaders/fragment_textured.glsl",
+           V_PARTICLE_SHADER_PATH[] = "shaders/vertex_particle.glsl";
 
 /**------------------------SPRITES---------------------------------**/
 
@@ -59,9 +81,23 @@ const char BALL_SPRITE[] = "textures/ball.png";
 
 
 /**------------------------INITIAL POSITION---------------------------------**/
-const glm::vec3 LEFT_PADDLE_INIT_POS = glm::vec3(-4.74f, 0.0f, 0.0f);
-const glm::vec3 RIGHT_PADDLE_INIT_POS = glm::vec3(4.78f, 0.0f, 0.0f);
-const glm::vec3 BALL_INIT_POS = glm::vec3(0.0f, 0.0f, 0.0f);
+GLM_CONSTEXPR const glm::vec3 LEFT_PADDLE_INIT_POS = glm::vec3(-4.74f, 0.0f, 0.0f);
+GLM_CONSTEXPR const glm::vec3 RIGHT_PADDLE_INIT_POS = glm::vec3(4.78f, 0.0f, 0.0f);
+GLM_CONSTEXPR const glm::vec3 BALL_INIT_POS = glm::vec3(0.0f, 0.0f, 0.0f);
+
+/**------------------------CAMERA---------------------------------**/
+// Fixed for the whole game, so both matrices are computed by the compiler. glm is constexpr only
+// in C++14 builds without GLM_FORCE_INTRINSICS; elsewhere GLM_CONSTEXPR is empty and they are
+// plain constants built at startup.
+GLM_CONSTEXPR const glm::mat4 VIEW_MATRIX       = glm::mat4(1.0f);
+GLM_CONSTEXPR const glm::mat4 PROJECTION_MATRIX = glm::ortho(-5.0f, 5.0f, -3.75f, 3.75f, -1.0f, 1.0f);
+
+#if GLM_HAS_CONSTEXPR
+static_assert(PROJECTION_MATRIX[0][0] == 0.2f && PROJECTION_MATRIX[3][0] == 0.0f,
+              "x from -5 to 5 fills the viewport");
+static_assert(PROJECTION_MATRIX[1][1] == 2.0f / 7.5f && PROJECTION_MATRIX[3][1] == 0.0f,
+              "y from -3.75 to 3.75 fills the viewport, keeping the 4:3 window square");
+#endif
 
 const int NUMBER_OF_TEXTURES = 1;
 const GLint LEVEL_OF_DETAIL  = 0,
@@ -79,33 +115,90 @@ GLuint        g_left_paddle_texture_id;
 GLuint        g_right_paddle_texture_id;
 GLuint        g_ball_texture_id;
 
+/**------------------------HOT RELOAD---------------------------------**/
+// shaders and sprites saved while the game runs show up from the next frame on
+AssetWatcher g_assets;
 
-glm::mat4 g_view_matrix,
-          g_projection_matrix;
 
-glm::mat4 g_left_paddle_model_matrix,
-          g_right_paddle_model_matrix,
-          g_ball_model_matrix;
+// UNIT_SPRITE_QUAD in the compact layout, used whenever the context reads half floats
+PackedSpriteVertex g_packed_quad[SPRITE_QUAD_VERTEX_COUNT];
+bool g_use_packed_vertices = false;
 
 float g_previous_ticks  = 0.0f;
 
 float x = 0.0;
 
-/**------------------------MOTION VECTORS--------------------------------**/
-glm::vec3 g_left_paddle_movement = glm::vec3(0.0f, 0.0f, 0.0f);
-glm::vec3 g_left_paddle_position = glm::vec3(0.0f, 0.0f, 0.0f);
-float g_left_paddle_speed = 4.0f;
+/**------------------------ENTITIES--------------------------------**/
+// Paddles and ball are entities of one world; update runs the systems below over it in order.
+const float PADDLE_SPEED = 4.0f,
+            BALL_SPEED   = 1.5f;
+
+// half sizes summing to the 0.65 the ball and a paddle are allowed to close to on each axis
+GLM_CONSTEXPR const glm::vec2 PADDLE_HALF_EXTENTS = glm::vec2(0.5f, 0.5f),
+                              BALL_HALF_EXTENTS   = glm::vec2(0.15f, 0.15f);
+
+// how close to the top and bottom walls a paddle stops and the ball bounces
+const float PADDLE_WALL_MARGIN = 0.035f,
+            BALL_WALL_MARGIN   = 0.1f;
+
+// A paddle moved by two keys.
+struct PaddleControls {
+    SDL_Scancode up;
+    SDL_Scancode down;
+};
+
+// Tags the ball.
+struct Ball {};
+
+/**------------------------PARTICLES--------------------------------**/
+const size_t PARTICLE_CAPACITY = 4096;
+
+const float TRAIL_PARTICLES_PER_SECOND = 90.0f;
+const size_t SPARKS_PER_HIT = 24;
 
-glm::vec3 g_right_paddle_movement = glm::vec3(0.0f, 0.0f, 0.0f);
-glm::vec3 g_right_paddle_position = glm::vec3(0.0f, 0.0f, 0.0f);
-float g_right_paddle_speed = 4.0f;
+// the trail hangs where the ball was; sparks burst out of every bounce
+const ParticleEmitter TRAIL_EMITTER = { glm::vec2(0.0f), glm::vec2(0.04f), glm::vec2(0.0f), 0.1f, 0.4f, 0.1f, 0.18f, glm::vec4(1.0f, 1.0f, 1.0f, 0.5f) };
+const ParticleEmitter SPARK_EMITTER = { glm::vec2(0.0f), glm::vec2(0.02f), glm::vec2(0.0f), 2.5f, 0.35f, 0.15f, 0.08f, glm::vec4(1.0f, 0.85f, 0.4f, 1.0f) };
 
-glm::vec3 g_ball_movement = glm::vec3(RAND_X, RAND_Y, 0.0f);
-glm::vec3 g_ball_position = glm::vec3(0.0f, 0.0f, 0.0f);
-float g_ball_speed = 1.5f;
+ParticlePool g_particles(PARTICLE_CAPACITY);
+ParticleRenderer g_particle_renderer;
+bool g_particles_enabled = false;
+float g_trail_particles_owed = 0.0f;
+
+/**------------------------SCORE--------------------------------**/
+// a ball past either end scores for the player at the other end and is served again from the middle
+const int WINNING_SCORE = 5;
+const size_t TEXT_CAPACITY = 64;
+const float SCORE_HEIGHT = 0.5f;
+GLM_CONSTEXPR const glm::vec2 SCORE_POSITION = glm::vec2(0.0f, 3.6f);
+
+int g_left_score  = 0,
+    g_right_score = 0;
+
+TextRenderer g_text;
+TextLabel g_score_label;
+
+/**------------------------SOUND--------------------------------**/
+// 256 frames at 48 kHz is 5.3 ms, so a hit is heard within a frame or so of the collision
+const int AUDIO_SAMPLE_RATE   = 48000,
+          AUDIO_BUFFER_FRAMES = 256;
+
+AudioMixer g_mixer;
+bool g_audio_enabled = false;
+SoundID g_paddle_sound, g_wall_sound, g_score_sound;
+
+World g_world;
+TransformHierarchy g_hierarchy;
+Scheduler g_update_systems;
 
 GLuint load_texture(const char* filepath);
-void draw_object(glm::mat4 &object_model_matrix, GLuint &object_texture_id);
+void control_paddles(World &world, float delta_time);
+void bounce_ball(World &world, float delta_time);
+void score_when_ball_leaves(World &world, float delta_time);
+void show_score();
+void emit_ball_trail(World &world, float delta_time);
+void emit_sparks(const glm::vec2 &position);
+void play_sound(SoundID sound, const glm::vec2 &position);
 void initialise();
 void process_input();
 void update();
@@ -129,38 +222,71 @@ int main(int argc, char* argv[])
 
 GLuint load_texture(const char* filepath)
 {
+    // prefer the cooked container next to the source image, re-cooking it whenever the source changes;
+    // a cooked texture needs no decode at all, just a mapping and one upload per mip level
+    std::string cooked_path = std::string(filepath) + COOKED_TEXTURE_EXTENSION;
+    if (is_cooked_texture_current(filepath, cooked_path.c_str()) || cook_texture(filepath, cooked_path.c_str()))
+    {
+        GLuint textureID = load_cooked_texture(cooked_path.c_str());
+        ImageArena::Reset();
+        if (textureID != 0) return textureID;
+    }
+    
+    // decode straight out of the mapped file instead of through stdio
+    MappedFile file(filepath);
+    
     int width, height, number_of_components;
-    unsigned char* image = stbi_load(filepath, &width, &height, &number_of_components, STBI_rgb_alpha);
+    if (!file.IsOpen() || !stbi_info_from_memory(file.Data(), (int) file.Size(), &width, &height, &number_of_components))
+    {
+        LOG("Unable to load image. Make sure the path is correct.");
+        assert(false);
+    }
     
-    if (image == NULL)
+    // the chain is decoded and filtered in arena memory, and each level is uploaded straight from there
+    MipLevelView levels[MAX_MIP_LEVELS];
+    int level_count = count_mip_levels(width, height);
+    size_t chain_size = layout_mip_chain(NULL, width, height, levels);
+    
+    stbi_uc* pixels = (stbi_uc*) ImageArena::Allocate(chain_size);
+    int decoded = pixels != NULL && stbi_load_from_memory_into(file.Data(), (int) file.Size(), pixels, width, height, width * STBI_rgb_alpha,
+                                                               &width, &height, &number_of_components, STBI_rgb_alpha, false);
+    if (!decoded)
     {
         LOG("Unable to load image. Make sure the path is correct.");
         assert(false);
     }
     
+    layout_mip_chain(pixels, width, height, levels);
+    generate_mip_chain(levels, level_count, MIP_FILTER_BOX);
+    
     GLuint textureID;
     glGenTextures(NUMBER_OF_TEXTURES, &textureID);
     glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexImage2D(GL_TEXTURE_2D, LEVEL_OF_DETAIL, GL_RGBA, width, height, TEXTURE_BORDER, GL_RGBA, GL_UNSIGNED_BYTE, image);
+    for (int level = 0; level < level_count; level++)
+    {
+        glTexImage2D(GL_TEXTURE_2D, LEVEL_OF_DETAIL + level, GL_RGBA, levels[level].width, levels[level].height, TEXTURE_BORDER,
+                     GL_RGBA, GL_UNSIGNED_BYTE, levels[level].pixels);
+    }
     
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level_count - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, level_count > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     
-    stbi_image_free(image);
+    // every intermediate buffer of this decode goes back to the arena in one step
+    ImageArena::Reset();
     
     return textureID;
 }
 
-void draw_object(glm::mat4 &object_model_matrix, GLuint &object_texture_id)
+void set_camera(ShaderProgram &program)
 {
-    g_pong_program.SetModelMatrix(object_model_matrix);
-    glBindTexture(GL_TEXTURE_2D, object_texture_id);
-    glDrawArrays(GL_TRIANGLES, 0, 6); // we are now drawing 2 triangles, so we use 6 instead of 3
+    program.SetProjectionMatrix(PROJECTION_MATRIX);
+    program.SetViewMatrix(VIEW_MATRIX);
 }
 
 void initialise()
 {
-    SDL_Init(SDL_INIT_VIDEO);
+    SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO);
     g_display_window = SDL_CreateWindow("PONG",
                                         SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
                                         WINDOW_WIDTH, WINDOW_HEIGHT,
@@ -174,24 +300,22 @@ void initialise()
 #endif
     glViewport(VIEWPORT_X, VIEWPORT_Y, VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
     
-    g_view_matrix = glm::mat4(1.0f);
-    g_projection_matrix = glm::ortho(-5.0f, 5.0f, -3.75f, 3.75f, -1.0f, 1.0f);
     g_pong_program.Load(V_SHADER_PATH, F_SHADER_PATH);
     
-    /**-------------------------RIGHT PADDLE MATRIX---------------------------------**/
-    g_right_paddle_model_matrix = glm::mat4(1.0f);
-    g_right_paddle_model_matrix = glm::translate(g_right_paddle_model_matrix, RIGHT_PADDLE_INIT_POS);
+    g_use_packed_vertices = packed_vertices_supported();
+    pack_sprite_vertices(UNIT_SPRITE_QUAD.positions, UNIT_SPRITE_QUAD.texCoords, NULL, g_packed_quad, SPRITE_QUAD_VERTEX_COUNT);
     
-    /**-------------------------LEFT PADDLE MODEL MATRIX---------------------------------**/
-    g_left_paddle_model_matrix = glm::mat4(1.0f);
-    g_left_paddle_model_matrix = glm::translate(g_left_paddle_model_matrix, LEFT_PADDLE_INIT_POS);
+    g_pong_program.SetProjectionMatrix(PROJECTION_MATRIX);
+    g_pong_program.SetViewMatrix(VIEW_MATRIX);
     
-    /**-------------------------BALL MODEL MATRIX---------------------------------**/
-    g_ball_model_matrix = glm::mat4(1.0f);
-    g_ball_model_matrix = glm::translate(g_ball_model_matrix, BALL_INIT_POS);
-    
-    g_pong_program.SetProjectionMatrix(g_projection_matrix);
-    g_pong_program.SetViewMatrix(g_view_matrix);
+    // without instancing the game just runs without effects
+    g_particles_enabled = particles_supported();
+    if (g_particles_enabled)
+    {
+        g_particle_renderer.Load(V_PARTICLE_SHADER_PATH, F_SHADER_PATH, PARTICLE_CAPACITY);
+        g_particle_renderer.SetProjectionMatrix(PROJECTION_MATRIX);
+        g_particle_renderer.SetViewMatrix(VIEW_MATRIX);
+    }
     
     glUseProgram(g_pong_program.programID);
     
@@ -199,6 +323,66 @@ void initialise()
     g_left_paddle_texture_id = load_texture(LEFT_PADDLE_SPRITE);
     g_right_paddle_texture_id = load_texture(RIGHT_PADDLE_SPRITE);
     g_ball_texture_id = load_texture(BALL_SPRITE);
+    LOG("Image arena high-water mark: " << ImageArena::HighWaterMark() << " bytes");
+    
+    g_assets.WatchShader(g_pong_program, V_SHADER_PATH, F_SHADER_PATH, set_camera);
+    if (g_particles_enabled) g_assets.WatchShader(g_particle_renderer.program, V_PARTICLE_SHADER_PATH, F_SHADER_PATH, set_camera);
+    g_assets.WatchTexture(g_left_paddle_texture_id, LEFT_PADDLE_SPRITE);
+    g_assets.WatchTexture(g_right_paddle_texture_id, RIGHT_PADDLE_SPRITE);
+    g_assets.WatchTexture(g_ball_texture_id, BALL_SPRITE);
+    if (g_assets.Start()) LOG("Watching shaders and textures for changes");
+    
+    /**------------------------CREATING ENTITIES---------------------------------**/
+    const glm::vec2 NO_VELOCITY = glm::vec2(0.0f);
+    
+    glm::vec2 ball_direction = glm::vec2(RAND_X, RAND_Y);
+    if (glm::length(ball_direction) > 1.0f)
+    {
+        ball_direction = glm::normalize(ball_direction);
+    }
+    
+    Entity right_paddle = g_world.Create(Position { glm::vec2(RIGHT_PADDLE_INIT_POS) }, Rotation { 0.0f }, Scale { glm::vec2(1.0f) },
+                                         Velocity { NO_VELOCITY }, Collider { PADDLE_HALF_EXTENTS }, Transform2D::Identity(),
+                                         Sprite { g_right_paddle_texture_id }, PaddleControls { SDL_SCANCODE_UP, SDL_SCANCODE_DOWN });
+    Entity left_paddle  = g_world.Create(Position { glm::vec2(LEFT_PADDLE_INIT_POS) }, Rotation { 0.0f }, Scale { glm::vec2(1.0f) },
+                                         Velocity { NO_VELOCITY }, Collider { PADDLE_HALF_EXTENTS }, Transform2D::Identity(),
+                                         Sprite { g_left_paddle_texture_id }, PaddleControls { SDL_SCANCODE_W, SDL_SCANCODE_S });
+    Entity ball         = g_world.Create(Position { glm::vec2(BALL_INIT_POS) }, Rotation { 0.0f }, Scale { glm::vec2(1.0f) },
+                                         Velocity { ball_direction * BALL_SPEED }, Collider { BALL_HALF_EXTENTS }, Transform2D::Identity(),
+                                         Sprite { g_ball_texture_id }, Ball {});
+    
+    // nothing moves until a paddle key is pressed or the ball is integrated, so after this first
+    // update only the moving objects' transforms are ever recomposed
+    g_hierarchy.Attach(g_world, right_paddle);
+    g_hierarchy.Attach(g_world, left_paddle);
+    g_hierarchy.Attach(g_world, ball);
+    g_hierarchy.Update(g_world);
+    
+    // effects are made here rather than loaded, and all of them before the device starts pulling
+    std::vector<float> paddle_hit = synthesize_tone(AUDIO_SAMPLE_RATE, 440.0f, 330.0f, 0.08f),
+                       wall_hit   = synthesize_tone(AUDIO_SAMPLE_RATE, 660.0f, 660.0f, 0.05f, 0.3f),
+                       point      = synthesize_tone(AUDIO_SAMPLE_RATE, 520.0f, 260.0f, 0.35f);
+    g_paddle_sound = g_mixer.Load(paddle_hit.data(), paddle_hit.size());
+    g_wall_sound   = g_mixer.Load(wall_hit.data(), wall_hit.size());
+    g_score_sound  = g_mixer.Load(point.data(), point.size());
+    
+    g_audio_enabled = g_mixer.Open(AUDIO_SAMPLE_RATE, AUDIO_BUFFER_FRAMES);
+    if (!g_audio_enabled) LOG("No audio device, playing silently: " << SDL_GetError());
+    
+    g_text.Load(TEXT_CAPACITY);
+    g_score_label = g_text.CreateLabel(16, SCORE_POSITION, SCORE_HEIGHT, glm::vec4(1.0f), TEXT_ALIGN_CENTER);
+    show_score();
+    
+    // collisions are decided on this frame's positions, before anything moves
+    g_update_systems.Add("control paddles", control_paddles);
+    g_update_systems.Add("bounce ball", bounce_ball);
+    g_update_systems.Add("score", score_when_ball_leaves);
+    g_update_systems.Add("integrate velocities", [](World &world, float delta_time) { integrate_velocities(world, g_hierarchy, delta_time); });
+    g_update_systems.Add("update transforms", [](World &world, float) { g_hierarchy.Update(world); });
+    g_update_systems.Add("emit ball trail", emit_ball_trail);
+    g_update_systems.Add("update particles", [](World &, float delta_time) { g_particles.Update(delta_time, glm::vec2(0.0f)); });
+    g_update_systems.SetEnabled("emit ball trail", g_particles_enabled);
+    g_update_systems.SetEnabled("update particles", g_particles_enabled);
 
     
     glEnable(GL_BLEND);
@@ -221,41 +405,6 @@ void process_input()
                 
         }
     }
-    
-    /**------------------------RIGHT PADDLE KEYBINDING---------------------------------**/
-    const Uint8 *key_state = SDL_GetKeyboardState(NULL);
-    
-    if (key_state[SDL_SCANCODE_UP]) {
-        g_right_paddle_movement.y = 1.0f;
-    }
-    if (key_state[SDL_SCANCODE_DOWN]) {
-        g_right_paddle_movement.y = -1.0f;
-    }
-    
-    /**------------------------LEFT PADDLE KEYBINDING---------------------------------**/
-    if (key_state[SDL_SCANCODE_W]) {
-        g_left_paddle_movement.y = 1.0f;
-    }
-    if (key_state[SDL_SCANCODE_S]) {
-        g_left_paddle_movement.y = -1.0f;
-    }
-    
-    /**------------------------NORMALIZATION---------------------------------**/
-    if (glm::length(g_right_paddle_movement) > 1.0f)
-    {
-        g_right_paddle_movement = glm::normalize(g_right_paddle_movement);
-    }
-    
-    if (glm::length(g_left_paddle_movement) > 1.0f)
-    {
-        g_left_paddle_movement = glm::normalize(g_left_paddle_movement);
-    }
-    
-    if (glm::length(g_ball_movement) > 1.0f)
-    {
-        g_ball_movement = glm::normalize(g_ball_movement);
-    }
-    
 }
 
 void update()
@@ -266,124 +415,183 @@ void update()
     float delta_time = ticks - g_previous_ticks;
     g_previous_ticks = ticks;
     
-    /** ———— COLLISION DETECTION ———— **/
-    float paddle_collision_factor = 0.035;
-    float ball_collision_factor = 0.1;
-    float ball_paddle_collision_factor = 0.65f;
-    
-    // RIGHT PADDLE
-    float right_pad_top_y_distance = fabs(g_right_paddle_position.y - MAX_Y) - (1.0f * paddle_collision_factor);
-    float right_pad_bottom_y_distance = fabs(g_right_paddle_position.y - MIN_Y) - (1.0f * paddle_collision_factor);
-    
-    // LEFT PADDLE
-    float left_pad_top_y_distance = fabs(g_left_paddle_position.y - MAX_Y) - (1.0f * paddle_collision_factor);
-    float left_pad_bottom_y_distance = fabs(g_left_paddle_position.y - MIN_Y) - (1.0f * paddle_collision_factor);
-    
-    // BALL
-    float ball_top_y_distance = fabs(g_ball_position.y - MAX_Y) - (1.0f * ball_collision_factor);
-    float ball_bottom_y_distance = fabs(g_ball_position.y - MIN_Y) - (1.0f * ball_collision_factor);
-    float ball_left_pad_distance_X = fabs(g_ball_position.x - LEFT_PADDLE_INIT_POS.x) - ((1.0f * ball_paddle_collision_factor + 1.0f * ball_paddle_collision_factor) / 2);
-    float ball_left_pad_distance_Y = fabs(g_ball_position.y - g_left_paddle_position.y) - ((1.0f * ball_paddle_collision_factor + 1.0f * ball_paddle_collision_factor) / 2);
-    float ball_right_pad_distance_X = fabs(g_ball_position.x - RIGHT_PADDLE_INIT_POS.x) - ((1.0f * ball_paddle_collision_factor + 1.0f * ball_paddle_collision_factor) / 2);
-    float ball_right_pad_distance_Y = fabs(g_ball_position.y - g_right_paddle_position.y) - ((1.0f * ball_paddle_collision_factor + 1.0f * ball_paddle_collision_factor) / 2);
+    g_update_systems.Run(g_world, delta_time);
+}
 
+void control_paddles(World &world, float)
+{
+    // the keyboard state is current as of the last SDL_PollEvent in process_input
+    const Uint8 *key_state = SDL_GetKeyboardState(NULL);
     
+    world.EachChunk<PaddleControls, Position, Velocity>([key_state](size_t count, const Entity *, PaddleControls *controls,
+                                                                    Position *positions, Velocity *velocities)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            float direction = 0.0f;
+            if (key_state[controls[i].up])   direction =  1.0f;
+            if (key_state[controls[i].down]) direction = -1.0f;
+            
+            // a paddle touching a wall can only move away from it
+            if (fabs(positions[i].value.y - MAX_Y) < PADDLE_WALL_MARGIN && direction > 0.0f) direction = 0.0f;
+            if (fabs(positions[i].value.y - MIN_Y) < PADDLE_WALL_MARGIN && direction < 0.0f) direction = 0.0f;
+            
+            velocities[i].value = glm::vec2(0.0f, direction * PADDLE_SPEED);
+        }
+    });
+}
+
+void bounce_ball(World &world, float)
+{
+    world.EachChunk<Ball, Velocity>([&world](size_t count, const Entity *balls, Ball *, Velocity *velocities)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            // a ball still inside a margin after bouncing is already heading away, so it only bounces,
+            // and only sparks and plays a sound, while moving towards the wall or paddle it touches
+            const glm::vec2 &position = world.Get<Position>(balls[i])->value;
+            bool at_top    = fabs(position.y - MAX_Y) < BALL_WALL_MARGIN && velocities[i].value.y > 0.0f,
+                 at_bottom = fabs(position.y - MIN_Y) < BALL_WALL_MARGIN && velocities[i].value.y < 0.0f;
+            if (at_top || at_bottom)
+            {
+                velocities[i].value.y *= -1.0f;
+                emit_sparks(position);
+                play_sound(g_wall_sound, position);
+            }
+            
+            // the same ball and paddle overlap the old per-object distance checks tested
+            const Entity ball = balls[i];
+            Velocity &velocity = velocities[i];
+            world.EachChunk<PaddleControls>([&](size_t paddle_count, const Entity *paddles, PaddleControls *)
+            {
+                for (size_t j = 0; j < paddle_count; j++)
+                {
+                    float towards_paddle = world.Get<Position>(paddles[j])->value.x - position.x;
+                    if (towards_paddle * velocity.value.x > 0.0f && colliders_overlap(world, ball, paddles[j]))
+                    {
+                        velocity.value.x *= -1.0f;
+                        emit_sparks(position);
+                        play_sound(g_paddle_sound, position);
+                    }
+                }
+            });
+        }
+    });
+}
+
+void score_when_ball_leaves(World &world, float)
+{
+    world.Each<Ball, Position, TransformNode>([](Ball &, Position &position, TransformNode &node)
+    {
+        if (position.value.x <= MAX_X && position.value.x >= MIN_X) return;
+        
+        if (position.value.x > MAX_X) g_left_score++;
+        else                          g_right_score++;
+        play_sound(g_score_sound, position.value);
+        
+        // the ball keeps its velocity, so it is served at whoever just missed it
+        position.value = glm::vec2(BALL_INIT_POS);
+        g_hierarchy.MarkDirty(node.node);
+        
+        show_score();
+        if (g_left_score == WINNING_SCORE || g_right_score == WINNING_SCORE) g_game_is_running = false;
+    });
+}
+
+void show_score()
+{
+    char score[16];
+    snprintf(score, sizeof(score), "%d   %d", g_left_score, g_right_score);
+    g_text.SetText(g_score_label, score);
+}
+
+void emit_ball_trail(World &world, float delta_time)
+{
+    // whole particles only, carrying the fraction over so the trail is even at any frame rate
+    g_trail_particles_owed += TRAIL_PARTICLES_PER_SECOND * delta_time;
+    size_t count = (size_t) g_trail_particles_owed;
+    g_trail_particles_owed -= count;
     
-    /** ———— RESETTING MODEL MATRIX ———— **/
-    g_right_paddle_model_matrix = glm::mat4(1.0f);
-    g_right_paddle_model_matrix = glm::translate(g_right_paddle_model_matrix, RIGHT_PADDLE_INIT_POS);
+    world.Each<Ball, Position>([count](Ball &, Position &position)
+    {
+        ParticleEmitter trail = TRAIL_EMITTER;
+        trail.position = position.value;
+        g_particles.Emit(trail, count);
+    });
+}
+
+void emit_sparks(const glm::vec2 &position)
+{
+    if (!g_particles_enabled) return;
     
-    g_left_paddle_model_matrix = glm::mat4(1.0f);
-    g_left_paddle_model_matrix = glm::translate(g_left_paddle_model_matrix, LEFT_PADDLE_INIT_POS);
+    ParticleEmitter sparks = SPARK_EMITTER;
+    sparks.position = position;
+    g_particles.Emit(sparks, SPARKS_PER_HIT);
+}
+
+void play_sound(SoundID sound, const glm::vec2 &position)
+{
+    if (!g_audio_enabled) return;
     
-    g_ball_model_matrix = glm::mat4(1.0f);
-    g_ball_model_matrix = glm::translate(g_ball_model_matrix, BALL_INIT_POS);
+    // heard from where on the court it happened
+    g_mixer.Play(sound, 1.0f, position.x / MAX_X);
+}
+
+void render() {
+    // between frames, so no draw sees half an asset
+    g_assets.Apply();
     
-    // ------------ TRANSLATION --------------- //
+    glClear(GL_COLOR_BUFFER_BIT);
     
-    // RIGHT PADDLE
-    if (right_pad_top_y_distance < 0.0f)
+    // under the sprites, so the trail stays behind the ball
+    if (g_particles_enabled)
     {
-        g_right_paddle_movement.y = (g_right_paddle_movement.y > 0.0f) ? 0.0f : g_right_paddle_movement.y;
+        g_particle_renderer.Draw(g_particles, g_ball_texture_id);
+        glUseProgram(g_pong_program.programID);
     }
-    if (right_pad_bottom_y_distance < 0.0f)
-    {
-        g_right_paddle_movement.y = (g_right_paddle_movement.y < 0.0f) ? 0.0f : g_right_paddle_movement.y;
-    }
-    g_right_paddle_position += g_right_paddle_movement * g_right_paddle_speed * delta_time;
-    g_right_paddle_model_matrix = glm::translate(g_right_paddle_model_matrix, g_right_paddle_position);
-    g_right_paddle_movement = glm::vec3(0.0f, 0.0f, 0.0f);
     
-    // LEFT PADDLE
-    if (left_pad_top_y_distance < 0.0f)
+    if (g_use_packed_vertices)
     {
-        g_left_paddle_movement.y = (g_left_paddle_movement.y > 0.0f) ? 0.0f : g_left_paddle_movement.y;
+        bind_sprite_vertices(g_pong_program, g_packed_quad);
     }
-    if (left_pad_bottom_y_distance < 0.0f)
+    else
     {
-        g_left_paddle_movement.y = (g_left_paddle_movement.y < 0.0f) ? 0.0f : g_left_paddle_movement.y;
+        glVertexAttribPointer(g_pong_program.positionAttribute, 2, GL_FLOAT, false, 0, UNIT_SPRITE_QUAD.positions);
+        glEnableVertexAttribArray(g_pong_program.positionAttribute);
+        
+        glVertexAttribPointer(g_pong_program.texCoordAttribute, 2, GL_FLOAT, false, 0, UNIT_SPRITE_QUAD.texCoords);
+        glEnableVertexAttribArray(g_pong_program.texCoordAttribute);
     }
-    g_left_paddle_position += g_left_paddle_movement * g_left_paddle_speed * delta_time;
-    g_left_paddle_model_matrix = glm::translate(g_left_paddle_model_matrix, g_left_paddle_position);
-    g_left_paddle_movement = glm::vec3(0.0f, 0.0f, 0.0f);
     
-    // BALL
-    LOG(ball_left_pad_distance_X);
-    if (ball_top_y_distance < 0.0f)
-    {
-        g_ball_movement.y *= -1.0f;
-    }
-    if (ball_bottom_y_distance < 0.0f)
-    {
-        g_ball_movement.y *= -1.0f;
-    }
-    if (ball_left_pad_distance_X < 0.0f && ball_left_pad_distance_Y < 0.0f)
+    draw_sprites(g_world, g_pong_program, SPRITE_QUAD_VERTEX_COUNT);
+    
+    if (g_use_packed_vertices)
     {
-        g_ball_movement.x *= -1.0f;
+        unbind_sprite_vertices(g_pong_program);
     }
-    if (ball_right_pad_distance_X < 0.0f && ball_right_pad_distance_Y < 0.0f)
+    else
     {
-        g_ball_movement.x *= -1.0f;
+        glDisableVertexAttribArray(g_pong_program.positionAttribute);
+        glDisableVertexAttribArray(g_pong_program.texCoordAttribute);
     }
     
-    if (g_ball_position.x > MAX_X || g_ball_position.x < MIN_X){
-        shutdown();
-    }
-    
-    
-    g_ball_position += g_ball_movement * g_ball_speed * delta_time;
-    g_ball_model_matrix = glm::translate(g_ball_model_matrix, g_ball_position);
+    g_text.Draw(g_pong_program);
     
+    SDL_GL_SwapWindow(g_display_window);
 }
 
-void render() {
-    glClear(GL_COLOR_BUFFER_BIT);
-    
-    float vertices[] = {
-        -0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f,
-        -0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f
-    };
-
-    float texture_coordinates[] = {
-        0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f,
-        0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f,
-    };
-    
-    glVertexAttribPointer(g_pong_program.positionAttribute, 2, GL_FLOAT, false, 0, vertices);
-    glEnableVertexAttribArray(g_pong_program.positionAttribute);
-    
-    glVertexAttribPointer(g_pong_program.texCoordAttribute, 2, GL_FLOAT, false, 0, texture_coordinates);
-    glEnableVertexAttribArray(g_pong_program.texCoordAttribute);
-    
-    draw_object(g_right_paddle_model_matrix, g_right_paddle_texture_id);
-    draw_object(g_left_paddle_model_matrix, g_left_paddle_texture_id);
-    draw_object(g_ball_model_matrix, g_ball_texture_id);
-    
+void shutdown()
+{
+    g_assets.Stop();
+    g_text.Cleanup();
     
-    glDisableVertexAttribArray(g_pong_program.positionAttribute);
-    glDisableVertexAttribArray(g_pong_program.texCoordAttribute);
+    MixerStats audio = g_mixer.Stats();
+    g_mixer.Close();
+    if (g_audio_enabled)
+    {
+        LOG("Audio: " << audio.callbacks << " callbacks, " << audio.lateCallbacks << " late, mean " << audio.meanMicroseconds
+            << " us, max " << audio.maxMicroseconds << " us of " << audio.budgetMicroseconds << " us");
+    }
     
-    SDL_GL_SwapWindow(g_display_window);
+    SDL_Quit();
 }
-
-void shutdown() { SDL_Quit(); }
@@ -0,0 +1,19 @@
+attribute vec4 position;
+attribute vec2 texCoord;
+attribute vec3 instance;
+attribute vec4 tint;
+
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+
+varying vec2 texCoordVar;
+varying vec4 tintVar;
+
+// One unit quad drawn once per particle: instance holds the particle's centre and size.
+void main()
+{
+	vec4 p = viewMatrix * vec4(instance.xy + position.xy * instance.z, 0.0, 1.0);
+    texCoordVar = texCoord;
+    tintVar = tint;
+	gl_Position = projectionMatrix * p;
+}
@@ -437,6 +437,14 @@ STBIDEF stbi_uc *stbi_load               (char              const *filename,
 STBIDEF stbi_uc *stbi_load_from_memory   (stbi_uc           const *buffer, int len   , int *x, int *y, int *comp, int req_comp);
 STBIDEF stbi_uc *stbi_load_from_callbacks(stbi_io_callbacks const *clbk  , void *user, int *x, int *y, int *comp, int req_comp);
 
+// decode into caller-owned memory (a mip chain, an atlas page sub-rectangle, ...) whose rows are
+// 'dst_stride' bytes apart and which can hold at most dst_w x dst_h pixels of req_comp components;
+// use stbi_info_from_memory to size it. the image is still decoded into stb_image's own buffer in
+// the file's layout; format conversion, the optional bottom-up row order and the copy into the
+// destination then share one pass, where stbi_load converts and flips in passes of their own.
+// returns 1 on success, 0 on failure (including an image larger than the destination)
+STBIDEF int      stbi_load_from_memory_into(stbi_uc const *buffer, int len, stbi_uc *dst, int dst_w, int dst_h, int dst_stride, int *x, int *y, int *comp, int req_comp, int flip_vertically);
+
 #ifndef STBI_NO_STDIO
 STBIDEF stbi_uc *stbi_load_from_file  (FILE *f,                  int *x, int *y, int *comp, int req_comp);
 // for stbi_load_from_file, file pointer is left pointing immediately after image
@@ -502,6 +510,20 @@ STBIDEF void stbi_convert_iphone_png_to_rgb(int flag_true_if_should_convert);
 // flip the image vertically, so the first pixel in the output array is the bottom left
 STBIDEF void stbi_set_flip_vertically_on_load(int flag_true_if_should_flip);
 
+#ifndef STBI_NO_GIF
+// animated GIF streaming: frames are decoded one at a time into a single RGBA canvas that is
+// reused for the whole animation, so memory stays constant regardless of frame count. the
+// buffer passed to open must outlive the stream. next returns the canvas (valid until the
+// following call) and the frame's delay in milliseconds, or NULL once the last frame has been
+// returned or on error; rewind starts over from the first frame.
+typedef struct stbi_gif_stream stbi_gif_stream;
+
+STBIDEF stbi_gif_stream *stbi_gif_stream_open_memory(stbi_uc const *buffer, int len, int *x, int *y);
+STBIDEF stbi_uc         *stbi_gif_stream_next       (stbi_gif_stream *stream, int *delay_ms);
+STBIDEF int              stbi_gif_stream_rewind     (stbi_gif_stream *stream);
+STBIDEF void             stbi_gif_stream_close      (stbi_gif_stream *stream);
+#endif
+
 // ZLIB client - used by PNG, available for other purposes
 
 STBIDEF char *stbi_zlib_decode_malloc_guesssize(const char *buffer, int len, int initial_size, int *outlen);
@@ -928,6 +950,8 @@ static float   *stbi__ldr_to_hdr(stbi_uc *data, int x, int y, int comp);
 static stbi_uc *stbi__hdr_to_ldr(float   *data, int x, int y, int comp);
 #endif
 
+static void stbi__convert_row(unsigned char *src, unsigned char *dest, int img_n, int req_comp, unsigned int x);
+
 static int stbi__vertically_flip_on_load = 0;
 
 STBIDEF void stbi_set_flip_vertically_on_load(int flag_true_if_should_flip)
@@ -1069,6 +1093,43 @@ STBIDEF stbi_uc *stbi_load_from_memory(stbi_uc const *buffer, int len, int *x, i
    return stbi__load_flip(&s,x,y,comp,req_comp);
 }
 
+STBIDEF int stbi_load_from_memory_into(stbi_uc const *buffer, int len, stbi_uc *dst, int dst_w, int dst_h, int dst_stride, int *x, int *y, int *comp, int req_comp, int flip_vertically)
+{
+   stbi__context s;
+   unsigned char *result;
+   int img_n, j;
+
+   if (req_comp < 1 || req_comp > 4) return stbi__err("bad req_comp", "Internal error");
+
+   // decode in the file's native layout; conversion to req_comp is folded into the copy below
+   stbi__start_mem(&s,buffer,len);
+   s.img_out_n = 0;
+   result = stbi__load_main(&s,x,y,&img_n,0);
+   if (result == NULL) return 0;
+
+   // the PNG loader reports the file's channels but may output more: a tRNS colour key on a grey or
+   // RGB image adds an alpha channel. Only it sets img_out_n, so that is the real row layout
+   if (s.img_out_n) img_n = s.img_out_n;
+
+   if (*x > dst_w || *y > dst_h || dst_stride < *x * req_comp) {
+      STBI_FREE(result);
+      return stbi__err("too large", "Destination buffer is smaller than the image");
+   }
+
+   for (j=0; j < *y; ++j) {
+      unsigned char *src  = result + j * *x * img_n;
+      unsigned char *dest = dst + (flip_vertically ? *y - 1 - j : j) * dst_stride;
+      if (img_n == req_comp)
+         memcpy(dest, src, *x * img_n);
+      else
+         stbi__convert_row(src, dest, img_n, req_comp, *x);
+   }
+
+   if (comp) *comp = img_n;
+   STBI_FREE(result);
+   return 1;
+}
+
 STBIDEF stbi_uc *stbi_load_from_callbacks(stbi_io_callbacks const *clbk, void *user, int *x, int *y, int *comp, int req_comp)
 {
    stbi__context s;
@@ -1338,9 +1399,36 @@ static stbi_uc stbi__compute_y(int r, int g, int b)
    return (stbi_uc) (((r*77) + (g*150) +  (29*b)) >> 8);
 }
 
+static void stbi__convert_row(unsigned char *src, unsigned char *dest, int img_n, int req_comp, unsigned int x)
+{
+   int i;
+
+   #define COMBO(a,b)  ((a)*8+(b))
+   #define CASE(a,b)   case COMBO(a,b): for(i=x-1; i >= 0; --i, src += a, dest += b)
+   // convert source image with img_n components to one with req_comp components;
+   // avoid switch per pixel, so use switch per scanline and massive macros
+   switch (COMBO(img_n, req_comp)) {
+      CASE(1,2) dest[0]=src[0], dest[1]=255; break;
+      CASE(1,3) dest[0]=dest[1]=dest[2]=src[0]; break;
+      CASE(1,4) dest[0]=dest[1]=dest[2]=src[0], dest[3]=255; break;
+      CASE(2,1) dest[0]=src[0]; break;
+      CASE(2,3) dest[0]=dest[1]=dest[2]=src[0]; break;
+      CASE(2,4) dest[0]=dest[1]=dest[2]=src[0], dest[3]=src[1]; break;
+      CASE(3,4) dest[0]=src[0],dest[1]=src[1],dest[2]=src[2],dest[3]=255; break;
+      CASE(3,1) dest[0]=stbi__compute_y(src[0],src[1],src[2]); break;
+      CASE(3,2) dest[0]=stbi__compute_y(src[0],src[1],src[2]), dest[1] = 255; break;
+      CASE(4,1) dest[0]=stbi__compute_y(src[0],src[1],src[2]); break;
+      CASE(4,2) dest[0]=stbi__compute_y(src[0],src[1],src[2]), dest[1] = src[3]; break;
+      CASE(4,3) dest[0]=src[0],dest[1]=src[1],dest[2]=src[2]; break;
+      default: STBI_ASSERT(0);
+   }
+   #undef CASE
+   #undef COMBO
+}
+
 static unsigned char *stbi__convert_format(unsigned char *data, int img_n, int req_comp, unsigned int x, unsigned int y)
 {
-   int i,j;
+   int j;
    unsigned char *good;
 
    if (req_comp == img_n) return data;
@@ -1352,31 +1440,8 @@ static unsigned char *stbi__convert_format(unsigned char *data, int img_n, int r
       return stbi__errpuc("outofmem", "Out of memory");
    }
 
-   for (j=0; j < (int) y; ++j) {
-      unsigned char *src  = data + j * x * img_n   ;
-      unsigned char *dest = good + j * x * req_comp;
-
-      #define COMBO(a,b)  ((a)*8+(b))
-      #define CASE(a,b)   case COMBO(a,b): for(i=x-1; i >= 0; --i, src += a, dest += b)
-      // convert source image with img_n components to one with req_comp components;
-      // avoid switch per pixel, so use switch per scanline and massive macros
-      switch (COMBO(img_n, req_comp)) {
-         CASE(1,2) dest[0]=src[0], dest[1]=255; break;
-         CASE(1,3) dest[0]=dest[1]=dest[2]=src[0]; break;
-         CASE(1,4) dest[0]=dest[1]=dest[2]=src[0], dest[3]=255; break;
-         CASE(2,1) dest[0]=src[0]; break;
-         CASE(2,3) dest[0]=dest[1]=dest[2]=src[0]; break;
-         CASE(2,4) dest[0]=dest[1]=dest[2]=src[0], dest[3]=src[1]; break;
-         CASE(3,4) dest[0]=src[0],dest[1]=src[1],dest[2]=src[2],dest[3]=255; break;
-         CASE(3,1) dest[0]=stbi__compute_y(src[0],src[1],src[2]); break;
-         CASE(3,2) dest[0]=stbi__compute_y(src[0],src[1],src[2]), dest[1] = 255; break;
-         CASE(4,1) dest[0]=stbi__compute_y(src[0],src[1],src[2]); break;
-         CASE(4,2) dest[0]=stbi__compute_y(src[0],src[1],src[2]), dest[1] = src[3]; break;
-         CASE(4,3) dest[0]=src[0],dest[1]=src[1],dest[2]=src[2]; break;
-         default: STBI_ASSERT(0);
-      }
-      #undef CASE
-   }
+   for (j=0; j < (int) y; ++j)
+      stbi__convert_row(data + j * x * img_n, good + j * x * req_comp, img_n, req_comp, x);
 
    STBI_FREE(data);
    return good;
@@ -5721,6 +5786,7 @@ typedef struct
    int max_x, max_y;
    int cur_x, cur_y;
    int line_size;
+   stbi_uc *history;                   // streaming only: canvas regions saved for "dispose to previous"
 } stbi__gif;
 
 static int stbi__gif_test_raw(stbi__context *s)
@@ -5932,23 +5998,30 @@ static stbi_uc *stbi__gif_load_next(stbi__context *s, stbi__gif *g, int *comp, i
       return 0; // stbi__g_failure_reason set by stbi__gif_header
 
    prev_out = g->out;
-   g->out = (stbi_uc *) stbi__malloc(4 * g->w * g->h);
-   if (g->out == 0) return stbi__errpuc("outofmem", "Out of memory");
+   // a stream draws every frame over the previous one in place; one-shot loads get a fresh canvas
+   if (g->history == 0 || prev_out == 0) {
+      g->out = (stbi_uc *) stbi__malloc(4 * g->w * g->h);
+      if (g->out == 0) return stbi__errpuc("outofmem", "Out of memory");
+   }
 
    switch ((g->eflags & 0x1C) >> 2) {
       case 0: // unspecified (also always used on 1st frame)
          stbi__fill_gif_background(g, 0, 0, 4 * g->w, 4 * g->w * g->h);
          break;
       case 1: // do not dispose
-         if (prev_out) memcpy(g->out, prev_out, 4 * g->w * g->h);
+         if (prev_out && prev_out != g->out) memcpy(g->out, prev_out, 4 * g->w * g->h);
          g->old_out = prev_out;
          break;
       case 2: // dispose to background
-         if (prev_out) memcpy(g->out, prev_out, 4 * g->w * g->h);
+         if (prev_out && prev_out != g->out) memcpy(g->out, prev_out, 4 * g->w * g->h);
          stbi__fill_gif_background(g, g->start_x, g->start_y, g->max_x, g->max_y);
          break;
       case 3: // dispose to previous
-         if (g->old_out) {
+         if (prev_out && prev_out != g->out) memcpy(g->out, prev_out, 4 * g->w * g->h);
+         if (g->history) {
+            for (i = g->start_y; i < g->max_y; i += 4 * g->w)
+               memcpy(&g->out[i + g->start_x], &g->history[i + g->start_x], g->max_x - g->start_x);
+         } else if (g->old_out) {
             for (i = g->start_y; i < g->max_y; i += 4 * g->w)
                memcpy(&g->out[i + g->start_x], &g->old_out[i + g->start_x], g->max_x - g->start_x);
          }
@@ -6000,6 +6073,12 @@ static stbi_uc *stbi__gif_load_next(stbi__context *s, stbi__gif *g, int *comp, i
             } else
                return stbi__errpuc("missing color table", "Corrupt GIF");
 
+            // this frame will be disposed to previous: remember what it is about to cover
+            if (g->history && ((g->eflags & 0x1C) >> 2) == 3) {
+               for (i = g->start_y; i < g->max_y; i += 4 * g->w)
+                  memcpy(&g->history[i + g->start_x], &g->out[i + g->start_x], g->max_x - g->start_x);
+            }
+
             o = stbi__process_gif_raster(s, g);
             if (o == NULL) return NULL;
 
@@ -6063,6 +6142,78 @@ static int stbi__gif_info(stbi__context *s, int *x, int *y, int *comp)
 {
    return stbi__gif_info_raw(s,x,y,comp);
 }
+
+struct stbi_gif_stream
+{
+   stbi__context s;
+   stbi__gif g;
+   stbi_uc const *buffer;
+   int len;
+};
+
+STBIDEF stbi_gif_stream *stbi_gif_stream_open_memory(stbi_uc const *buffer, int len, int *x, int *y)
+{
+   stbi_gif_stream *stream = (stbi_gif_stream *) stbi__malloc(sizeof(stbi_gif_stream));
+   if (stream == NULL) return (stbi_gif_stream *) stbi__errpuc("outofmem", "Out of memory");
+   memset(stream, 0, sizeof(*stream));
+
+   stream->buffer = buffer;
+   stream->len = len;
+   stbi__start_mem(&stream->s, buffer, len);
+   if (!stbi__gif_header(&stream->s, &stream->g, NULL, 0)) {
+      STBI_FREE(stream);
+      return NULL;
+   }
+
+   stream->g.history = (stbi_uc *) stbi__malloc(4 * stream->g.w * stream->g.h);
+   if (stream->g.history == NULL) {
+      STBI_FREE(stream);
+      return (stbi_gif_stream *) stbi__errpuc("outofmem", "Out of memory");
+   }
+
+   // the canvas is allocated up front so stbi__gif_load_next never re-reads the header
+   stream->g.out = (stbi_uc *) stbi__malloc(4 * stream->g.w * stream->g.h);
+   if (stream->g.out == NULL) {
+      STBI_FREE(stream->g.history);
+      STBI_FREE(stream);
+      return (stbi_gif_stream *) stbi__errpuc("outofmem", "Out of memory");
+   }
+
+   if (x) *x = stream->g.w;
+   if (y) *y = stream->g.h;
+   return stream;
+}
+
+STBIDEF stbi_uc *stbi_gif_stream_next(stbi_gif_stream *stream, int *delay_ms)
+{
+   int comp;
+   stbi_uc *frame = stbi__gif_load_next(&stream->s, &stream->g, &comp, 4);
+   if (frame == (stbi_uc *) &stream->s) return NULL;  // end of animation marker
+
+   if (delay_ms) *delay_ms = stream->g.delay * 10;
+   return frame;
+}
+
+STBIDEF int stbi_gif_stream_rewind(stbi_gif_stream *stream)
+{
+   stbi__gif *g = &stream->g;
+
+   stbi__start_mem(&stream->s, stream->buffer, stream->len);
+   if (!stbi__gif_header(&stream->s, g, NULL, 0)) return 0;
+
+   g->eflags = 0;
+   g->delay  = 0;
+   g->old_out = NULL;
+   return 1;
+}
+
+STBIDEF void stbi_gif_stream_close(stbi_gif_stream *stream)
+{
+   if (stream == NULL) return;
+   STBI_FREE(stream->g.out);
+   STBI_FREE(stream->g.history);
+   STBI_FREE(stream);
+}
 #endif
 
 // *************************************************************************************************
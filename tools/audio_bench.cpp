@@ -0,0 +1,180 @@
+/**
+* Checks and timing report for AudioMixer, the mixer under pong's sound effects.
+*
+* It first drives Mix directly, with no device: panning, ramps and voice expiry are checked against
+* closed-form results, and a full mixer of 256 voices is timed at several buffer sizes against the
+* time each buffer takes to play. Then it opens a real device through SDL, by default the dummy
+* driver, which pulls buffers on its own thread at the device rate with no sound card, and plays
+* effects from this thread at 60 frames a second, as the game does. It reports the callback times,
+* late callbacks (underruns) and dropped commands. From the repository root:
+*   c++ -std=c++14 -O2 -DNDEBUG -Ipong/SDLProject -I/Library/Frameworks/SDL2.framework/Headers \
+*       tools/audio_bench.cpp pong/SDLProject/AudioMixer.cpp -F/Library/Frameworks -framework SDL2 -o audio_bench
+*   ./audio_bench [driver] [buffer frames] [seconds]
+* The driver is any SDL_AUDIODRIVER name; "disk" writes the output to sdlaudio.raw for listening.
+* Add -DGLM_FORCE_AVX -mavx -mf16c to mix with glm's SIMD lanes as the game's x86_64 build does; its
+* arm64 build has no intrinsics. Exits with 1 when a check fails.
+**/
+#include "AudioMixer.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+    const int SAMPLE_RATE = 48000;
+
+    int g_failures = 0;
+
+    void check(bool passed, const char *what)
+    {
+        std::printf("%-58s %s\n", what, passed ? "ok" : "FAILED");
+        if (!passed) g_failures++;
+    }
+
+    void run_checks()
+    {
+        const std::vector<float> ones(1000, 1.0f);
+        std::vector<float> out(MIX_BLOCK_FRAMES * 2 * 4);
+
+        {
+            // hard left: all of the gain on the left once the opening ramp is done
+            AudioMixer mixer;
+            SoundID sound = mixer.Load(ones.data(), ones.size());
+            mixer.Play(sound, 0.5f, -1.0f);
+            mixer.Mix(out.data(), MIX_BLOCK_FRAMES * 2);
+
+            const float *second = &out[MIX_BLOCK_FRAMES * 2];
+            check(std::fabs(second[0] - 0.5f) < 1e-5f && std::fabs(second[1]) < 1e-5f, "a voice panned hard left plays on the left only");
+        }
+        {
+            // centred: equal-power, so each side gets gain / sqrt(2)
+            AudioMixer mixer;
+            SoundID sound = mixer.Load(ones.data(), ones.size());
+            mixer.Play(sound, 1.0f, 0.0f);
+            mixer.Mix(out.data(), MIX_BLOCK_FRAMES * 2);
+
+            const float *second = &out[MIX_BLOCK_FRAMES * 2];
+            check(std::fabs(second[0] - 0.70710678f) < 1e-5f && std::fabs(second[1] - 0.70710678f) < 1e-5f,
+                  "a centred voice is split at equal power");
+
+            // the opening ramp climbs evenly from silence, without a step
+            float largest_step = out[0];
+            for (int i = 1; i < MIX_BLOCK_FRAMES; i++) largest_step = std::fmax(largest_step, out[i * 2] - out[(i - 1) * 2]);
+            check(largest_step < 0.70710678f / MIX_BLOCK_FRAMES + 1e-5f, "a starting voice fades in over one block");
+
+            // stopping fades out over the next block and then frees the voice
+            mixer.Stop(1);
+            mixer.Mix(out.data(), MIX_BLOCK_FRAMES * 2);
+            check(std::fabs(out[(MIX_BLOCK_FRAMES - 1) * 2]) < 1e-5f && out[(MIX_BLOCK_FRAMES / 2) * 2] > 0.3f &&
+                  std::fabs(out[MIX_BLOCK_FRAMES * 2]) < 1e-6f, "a stopped voice fades out, then falls silent");
+        }
+        {
+            // a one-shot ends with its sound; a looping voice wraps around it
+            AudioMixer mixer;
+            std::vector<float> click(100, 1.0f);
+            SoundID sound = mixer.Load(click.data(), click.size());
+            mixer.Play(sound, 1.0f, -1.0f);
+            mixer.Play(sound, 1.0f, 1.0f, true);
+            mixer.Mix(out.data(), MIX_BLOCK_FRAMES);
+            mixer.Mix(out.data(), MIX_BLOCK_FRAMES);
+
+            check(std::fabs(out[0]) < 1e-6f && std::fabs(out[1] - 1.0f) < 1e-5f && std::fabs(out[199 * 2 + 1] - 1.0f) < 1e-5f,
+                  "one-shots end with their sound, loops keep going");
+        }
+        {
+            // more voices than the mixer holds: the rest are counted, not mixed
+            AudioMixer mixer;
+            SoundID sound = mixer.Load(ones.data(), ones.size());
+            for (int i = 0; i < MAX_VOICES + 10; i++) mixer.Play(sound, 0.001f);
+            mixer.Mix(out.data(), 64);
+            check(mixer.Stats().droppedVoices == 10, "plays past MAX_VOICES are dropped and counted");
+        }
+    }
+
+    // 256 looping voices of one second of noise each, so every voice is mixed every frame
+    void run_offline_timing()
+    {
+        AudioMixer mixer;
+        std::vector<float> noise(SAMPLE_RATE);
+        for (size_t i = 0; i < noise.size(); i++) noise[i] = (std::rand() / float(RAND_MAX) - 0.5f) * 0.01f;
+
+        SoundID sound = mixer.Load(noise.data(), noise.size());
+        for (int i = 0; i < MAX_VOICES; i++) mixer.Play(sound, 0.5f, (i % 17) / 8.0f - 1.0f, true);
+
+        std::printf("\n%d voices mixed without a device\n", MAX_VOICES);
+        std::printf("%-14s %12s %12s %10s\n", "buffer frames", "us/buffer", "budget us", "load");
+
+        std::vector<float> out(1024 * 2);
+        const int sizes[] = { 64, 128, 256, 512, 1024 };
+        for (int s = 0; s < 5; s++)
+        {
+            int frames = sizes[s];
+            int buffers = SAMPLE_RATE * 4 / frames;   // four seconds of audio
+
+            auto start = std::chrono::steady_clock::now();
+            for (int b = 0; b < buffers; b++) mixer.Mix(out.data(), frames);
+            double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / buffers;
+
+            double budget = 1e6 * frames / SAMPLE_RATE;
+            std::printf("%-14d %12.2f %12.1f %9.1f%%\n", frames, microseconds, budget, 100.0 * microseconds / budget);
+        }
+    }
+
+    void run_device(const char *driver, int buffer_frames, int seconds)
+    {
+        SDL_setenv("SDL_AUDIODRIVER", driver, 1);
+        if (SDL_InitSubSystem(SDL_INIT_AUDIO) != 0)
+        {
+            std::printf("\nno %s audio driver: %s\n", driver, SDL_GetError());
+            return;
+        }
+
+        AudioMixer mixer;
+        std::vector<float> blip = synthesize_tone(SAMPLE_RATE, 440.0f, 330.0f, 0.08f);
+        SoundID sound = mixer.Load(blip.data(), blip.size());
+
+        if (!mixer.Open(SAMPLE_RATE, buffer_frames))
+        {
+            std::printf("\nthe %s driver opened no device: %s\n", driver, SDL_GetError());
+            SDL_Quit();
+            return;
+        }
+
+        // a burst of hits every frame, as many as a busy game might fire
+        const int FRAMES_PER_SECOND = 60, HITS_PER_FRAME = 8;
+        for (int frame = 0; frame < seconds * FRAMES_PER_SECOND; frame++)
+        {
+            for (int hit = 0; hit < HITS_PER_FRAME; hit++) mixer.Play(sound, 0.1f, (hit - 4) / 4.0f);
+            SDL_Delay(1000 / FRAMES_PER_SECOND);
+        }
+
+        MixerStats stats = mixer.Stats();
+        mixer.Close();
+        SDL_Quit();
+
+        std::printf("\n%s driver, %d frames per buffer asked, %d got, %d s\n", driver, buffer_frames, mixer.BufferFrames(), seconds);
+        std::printf("callbacks %llu, late %llu, mean %.1f us, max %.1f us, budget %.1f us\n",
+                    (unsigned long long) stats.callbacks, (unsigned long long) stats.lateCallbacks,
+                    stats.meanMicroseconds, stats.maxMicroseconds, stats.budgetMicroseconds);
+        std::printf("dropped commands %llu, dropped voices %llu\n",
+                    (unsigned long long) stats.droppedCommands, (unsigned long long) stats.droppedVoices);
+
+        if (stats.callbacks == 0) g_failures++;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const char *driver = argc > 1 ? argv[1] : "dummy";
+    int buffer_frames = argc > 2 ? std::atoi(argv[2]) : 256;
+    int seconds = argc > 3 ? std::atoi(argv[3]) : 5;
+
+    run_checks();
+    run_offline_timing();
+    run_device(driver, buffer_frames, seconds);
+
+    if (g_failures > 0) std::printf("\n%d check(s) FAILED\n", g_failures);
+    return g_failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,43 @@
+/**
+* Offline texture cooker. Writes a ".ctex" container next to every image given on the command line
+* whose source has changed since it was last cooked, so the games can skip PNG decoding at start-up.
+*
+* Both projects carry identical copies of the sources it needs; from the repository root:
+*   c++ -std=c++14 -O2 -Ipong/SDLProject -I/Library/Frameworks/SDL2.framework/Headers \
+*       tools/cook_textures.cpp pong/SDLProject/TextureCooker.cpp pong/SDLProject/MipChain.cpp \
+*       pong/SDLProject/MappedFile.cpp \
+*       -o cook_textures
+*   ./cook_textures pong/SDLProject/textures/*.png 2d_scene/SDLProject/textures/*.png
+**/
+#define STB_IMAGE_IMPLEMENTATION
+
+#include "CookedTexture.h"
+#include "stb_image.h"
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[])
+{
+    int failures = 0;
+    
+    for (int i = 1; i < argc; i++)
+    {
+        std::string cooked_path = std::string(argv[i]) + COOKED_TEXTURE_EXTENSION;
+        
+        if (is_cooked_texture_current(argv[i], cooked_path.c_str()))
+        {
+            std::cout << "up to date  " << argv[i] << '\n';
+        }
+        else if (cook_texture(argv[i], cooked_path.c_str()))
+        {
+            std::cout << "cooked      " << cooked_path << '\n';
+        }
+        else
+        {
+            std::cout << "FAILED      " << argv[i] << ": " << stbi_failure_reason() << '\n';
+            failures++;
+        }
+    }
+    
+    return failures == 0 ? 0 : 1;
+}
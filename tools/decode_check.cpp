@@ -0,0 +1,156 @@
+/**
+* Checks stbi_load_from_memory_into, the decoder the games use to write pixels straight into a
+* texture's upload buffer, against stb_image's own stbi_load_from_memory.
+*
+* The images in tools/images are 4x3 PNGs whose decoded channel count differs from the file's: grey
+* and RGB images with a tRNS colour key (at 8 and 16 bits), which decode with an extra alpha channel,
+* and a palette with transparency. Each is decoded into a padded destination, upright and flipped,
+* and compared byte for byte. The colour-keyed pixels must come out transparent.
+*
+* It also plays animated.gif, a 4x3 animation using every disposal method, through stbi_gif_stream,
+* which AnimatedTexture decodes from, and compares each frame and delay against stb_image's own
+* stbi__gif_load_next drawing onto a fresh canvas per frame, for two loops either side of a rewind.
+* From the repository root:
+*   c++ -std=c++14 -O2 -Ipong/SDLProject tools/decode_check.cpp pong/SDLProject/MappedFile.cpp -o decode_check
+*   ./decode_check
+* Exits with 1 when a check fails.
+**/
+#define STB_IMAGE_IMPLEMENTATION
+#include "MappedFile.h"
+#include "stb_image.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+    const int WIDTH = 4, HEIGHT = 3;
+
+    // the pixels drawn with the colour key, or palette entry 0, in every test image
+    const bool TRANSPARENT[HEIGHT][WIDTH] = {
+        { true,  false, false, true  },
+        { false, true,  false, false },
+        { true,  false, false, true  },
+    };
+
+    int g_failures = 0;
+
+    void check(bool passed, const std::string &what)
+    {
+        std::printf("%-58s %s\n", what.c_str(), passed ? "ok" : "FAILED");
+        if (!passed) g_failures++;
+    }
+
+    void check_image(const char *name)
+    {
+        std::string path = std::string("tools/images/") + name;
+        MappedFile file(path.c_str());
+        if (!file.IsOpen())
+        {
+            check(false, path + " opens");
+            return;
+        }
+
+        int width, height, components;
+        stbi_uc *expected = stbi_load_from_memory(file.Data(), (int) file.Size(), &width, &height, &components, STBI_rgb_alpha);
+        if (expected == NULL || width != WIDTH || height != HEIGHT)
+        {
+            check(false, path + " decodes");
+            return;
+        }
+
+        bool keyed = true;
+        for (int y = 0; y < HEIGHT; y++)
+        {
+            for (int x = 0; x < WIDTH; x++) keyed = keyed && (expected[(y * WIDTH + x) * 4 + 3] == 0) == TRANSPARENT[y][x];
+        }
+        check(keyed, std::string(name) + ": keyed pixels are transparent");
+
+        // a wider destination than the image, so a wrong source stride cannot line up by chance
+        const int STRIDE = WIDTH * 4 + 12;
+        for (int flip = 0; flip < 2; flip++)
+        {
+            std::vector<stbi_uc> into(STRIDE * HEIGHT, 0xCD);
+            int decoded = stbi_load_from_memory_into(file.Data(), (int) file.Size(), into.data(), WIDTH, HEIGHT, STRIDE,
+                                                     &width, &height, &components, STBI_rgb_alpha, flip);
+
+            bool same = decoded != 0;
+            for (int y = 0; same && y < HEIGHT; y++)
+            {
+                const stbi_uc *row = &into[(flip ? HEIGHT - 1 - y : y) * STRIDE];
+                same = std::memcmp(row, expected + y * WIDTH * 4, WIDTH * 4) == 0 && row[WIDTH * 4] == 0xCD;
+            }
+            check(same, std::string(name) + (flip ? ": decoded into, flipped" : ": decoded into, upright"));
+        }
+
+        stbi_image_free(expected);
+    }
+
+    void check_gif_stream(const char *name)
+    {
+        std::string path = std::string("tools/images/") + name;
+        MappedFile file(path.c_str());
+        if (!file.IsOpen())
+        {
+            check(false, path + " opens");
+            return;
+        }
+
+        // the reference: the one-shot path, which allocates a canvas per frame and copies the last one in
+        stbi__context context;
+        stbi__start_mem(&context, file.Data(), (int) file.Size());
+        std::vector<stbi__gif> gif(1);
+        std::memset(gif.data(), 0, sizeof(stbi__gif));
+
+        std::vector<std::vector<stbi_uc>> frames;
+        std::vector<int> delays;
+        std::vector<stbi_uc *> canvases;
+        for (;;)
+        {
+            int components;
+            stbi_uc *canvas = stbi__gif_load_next(&context, gif.data(), &components, 4);
+            if (canvas == NULL || canvas == (stbi_uc *) &context) break;
+
+            canvases.push_back(canvas);
+            frames.emplace_back(canvas, canvas + WIDTH * HEIGHT * 4);
+            delays.push_back(gif[0].delay * 10);
+        }
+        for (stbi_uc *canvas : canvases) STBI_FREE(canvas);
+        check(frames.size() == 5, std::string(name) + ": reference decodes 5 frames");
+
+        int width, height;
+        stbi_gif_stream *stream = stbi_gif_stream_open_memory(file.Data(), (int) file.Size(), &width, &height);
+        check(stream != NULL && width == WIDTH && height == HEIGHT, std::string(name) + ": stream opens");
+        if (stream == NULL) return;
+
+        for (int loop = 0; loop < 2; loop++)
+        {
+            bool same = true;
+            for (size_t i = 0; same && i < frames.size(); i++)
+            {
+                int delay = -1;
+                stbi_uc *canvas = stbi_gif_stream_next(stream, &delay);
+                same = canvas != NULL && std::memcmp(canvas, frames[i].data(), frames[i].size()) == 0 && delay == delays[i];
+            }
+            same = same && stbi_gif_stream_next(stream, NULL) == NULL;
+            check(same, std::string(name) + (loop == 0 ? ": streamed frames and delays" : ": streamed again after rewind"));
+
+            if (loop == 0) check(stbi_gif_stream_rewind(stream) != 0, std::string(name) + ": stream rewinds");
+        }
+
+        stbi_gif_stream_close(stream);
+    }
+}
+
+int main()
+{
+    check_image("rgb_trns.png");
+    check_image("rgb16_trns.png");
+    check_image("grey_trns.png");
+    check_image("palette_trns.png");
+    check_gif_stream("animated.gif");
+
+    if (g_failures > 0) std::printf("\n%d check(s) FAILED\n", g_failures);
+    return g_failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,860 @@
+/**
+* Microbenchmarks for the glm operations the games depend on: matrix products and inverses, the
+* transform builders, vector normalization, quaternions, half-float packing, noise and the
+* gtx/intersect tests, next to the batch kernels that replace them in hot loops.
+*
+* One binary measures one glm configuration. tools/glm_bench.sh builds it at every architecture
+* level and writes a JSON report per level; by hand, from the repository root:
+*   c++ -std=c++14 -O2 -DNDEBUG -DGLM_FORCE_AVX2 -mavx2 -mfma -mf16c -Ipong/SDLProject \
+*       tools/glm_bench.cpp -o glm_bench
+*   ./glm_bench --benchmark_out=avx2.json
+*
+* The flags and the JSON layout follow Google Benchmark, so its tools/compare.py can diff two
+* reports. Times are per operation: every benchmark applies its operation to a batch of inputs and
+* reports the batch time divided by the batch size.
+*   --benchmark_filter=<regex>       run only the benchmarks whose name matches
+*   --benchmark_min_time=<seconds>   measure each benchmark for at least this long (default 0.5)
+*   --benchmark_repetitions=<n>      repeat each measurement and add mean, median and stddev
+*   --benchmark_format=console|json  what to print on stdout
+*   --benchmark_out=<file>           also write the JSON report to file
+**/
+#define GLM_ENABLE_EXPERIMENTAL
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_inverse.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/noise.hpp"
+#include "glm/gtc/packing.hpp"
+#include "glm/gtc/quaternion.hpp"
+#include "glm/gtx/fast_square_root.hpp"
+#include "glm/gtx/fast_trigonometry.hpp"
+#include "glm/gtx/intersect.hpp"
+#include "glm/gtx/soa.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Inputs per timed batch: enough to hide the call and loop overhead, while a batch of matrices
+    // and its results still fit in L2.
+    const size_t BATCH = 512;
+
+    // Keeps the compiler from deleting or hoisting work whose results are never read: the pointer
+    // escapes, and the memory clobber forces every batch to reload its inputs and store its outputs.
+    inline void escape(const void *pointer)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(pointer) : "memory");
+#else
+        static const void *volatile sink;
+        sink = pointer;
+#endif
+    }
+
+    /**----INPUTS----**/
+
+    glm::mat4 g_matrices[BATCH], g_other_matrices[BATCH];
+    glm::vec2 g_points2[BATCH];
+    glm::vec3 g_points[BATCH], g_other_points[BATCH], g_directions[BATCH], g_axes[BATCH];
+    glm::vec3 g_triangles[BATCH][3];
+    glm::quat g_rotations[BATCH], g_other_rotations[BATCH];
+    float g_angles[BATCH], g_fractions[BATCH], g_radii[BATCH], g_positive[BATCH];
+    glm::uint16 g_halves[BATCH];
+    glm::soa<glm::quat> g_soa_rotations, g_other_soa_rotations;
+    glm::soa<glm::vec2> g_soa_points2, g_soa_directions2, g_soa_box_min, g_soa_box_max, g_soa_axes, g_soa_half_extents;
+
+    /**----OUTPUTS----**/
+
+    glm::mat4 g_matrix_out[BATCH];
+    glm::vec2 g_vec2_out[BATCH];
+    glm::vec3 g_vec3_out[BATCH], g_other_vec3_out[BATCH], g_exit_out[BATCH], g_exit_normal_out[BATCH];
+    glm::quat g_quat_out[BATCH];
+    float g_float_out[BATCH], g_other_float_out[BATCH];
+    glm::uint16 g_half_out[BATCH];
+    bool g_hit_out[BATCH];
+    glm::uint32 g_hit_mask_out[BATCH / 32];
+    glm::soa<glm::quat> g_soa_rotation_out;
+    glm::soa<glm::vec2> g_soa_points2_out;
+
+    // integrated in place, batch after batch
+    glm::vec2 g_particle_positions[BATCH], g_particle_velocities[BATCH];
+    glm::soa<glm::vec2> g_soa_particle_positions, g_soa_particle_velocities;
+
+    // Outputs are never read, so unless their addresses escape the compiler may drop the stores
+    // to them, and with the stores the work.
+    void escape_outputs()
+    {
+        escape(g_matrix_out); escape(g_vec2_out); escape(g_vec3_out); escape(g_other_vec3_out);
+        escape(g_exit_out); escape(g_exit_normal_out); escape(g_quat_out); escape(g_float_out);
+        escape(g_other_float_out); escape(g_half_out); escape(g_hit_out); escape(g_hit_mask_out);
+        escape(&g_soa_rotation_out); escape(&g_soa_points2_out);
+        escape(g_particle_positions); escape(g_particle_velocities);
+        escape(&g_soa_particle_positions); escape(&g_soa_particle_velocities);
+    }
+
+    glm::vec3 random_unit_vector(std::mt19937 &random)
+    {
+        std::normal_distribution<float> normal;
+        glm::vec3 v(normal(random), normal(random), normal(random));
+        return glm::normalize(v);
+    }
+
+    // Fixed seed, so every configuration and every run measures the same inputs.
+    void make_inputs()
+    {
+        std::mt19937 random(3113);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_real_distribution<float> coordinate(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> angle(-glm::pi<float>(), glm::pi<float>());
+        std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+        for (size_t i = 0; i < BATCH; i++)
+        {
+            glm::vec3 offset(coordinate(random), coordinate(random), coordinate(random));
+            glm::vec3 axis = random_unit_vector(random);
+            glm::vec3 scales(scale(random), scale(random), scale(random));
+
+            // translate * rotate * scale, as the games build model matrices, so inverses are well conditioned
+            g_matrices[i] = glm::scale(glm::rotate(glm::translate(glm::mat4(1.0f), offset), angle(random), axis), scales);
+            g_other_matrices[i] = glm::rotate(glm::translate(glm::mat4(1.0f), -offset), angle(random), random_unit_vector(random));
+
+            g_points2[i] = glm::vec2(coordinate(random), coordinate(random));
+            g_points[i] = glm::vec3(coordinate(random), coordinate(random), coordinate(random));
+            g_other_points[i] = glm::vec3(coordinate(random), coordinate(random), coordinate(random));
+            g_directions[i] = random_unit_vector(random);
+            g_axes[i] = random_unit_vector(random);
+
+            // triangles around the origin, so that rays from g_points aimed at them hit about half the time
+            for (int corner = 0; corner < 3; corner++)
+            {
+                g_triangles[i][corner] = glm::vec3(coordinate(random), coordinate(random), coordinate(random)) * 0.5f;
+            }
+
+            g_rotations[i] = glm::angleAxis(angle(random), random_unit_vector(random));
+            g_other_rotations[i] = glm::angleAxis(angle(random), random_unit_vector(random));
+            g_angles[i] = angle(random);
+            g_fractions[i] = unit(random);
+            g_radii[i] = scale(random) * 2.0f;
+            g_positive[i] = scale(random) * coordinate(random) * coordinate(random) + 1.0f;
+            g_halves[i] = glm::packHalf1x16(coordinate(random));
+
+            g_soa_rotations.push_back(g_rotations[i]);
+            g_other_soa_rotations.push_back(g_other_rotations[i]);
+            g_soa_points2.push_back(g_points2[i]);
+
+            // 2D shapes a few units across, scattered as sprites are over the play field
+            glm::vec2 half_extents(scale(random), scale(random));
+            float rotation = angle(random);
+            g_soa_directions2.push_back(glm::vec2(coordinate(random), coordinate(random)));
+            g_soa_box_min.push_back(g_points2[i] - half_extents);
+            g_soa_box_max.push_back(g_points2[i] + half_extents);
+            g_soa_axes.push_back(glm::vec2(std::cos(rotation), std::sin(rotation)));
+            g_soa_half_extents.push_back(half_extents);
+
+            g_particle_positions[i] = g_points2[i];
+            g_particle_velocities[i] = g_soa_directions2.get(i);
+            g_soa_particle_positions.push_back(g_particle_positions[i]);
+            g_soa_particle_velocities.push_back(g_particle_velocities[i]);
+        }
+
+        for (size_t i = 0; i < BATCH; i += 2)
+        {
+            // half of the rays point at their triangle's centroid or at the origin, where the spheres sit
+            glm::vec3 centroid = (g_triangles[i][0] + g_triangles[i][1] + g_triangles[i][2]) / 3.0f;
+            g_directions[i] = glm::normalize(centroid - g_points[i]);
+        }
+    }
+
+    /**----BENCHMARKS----**/
+
+    // Each benchmark applies its operation once to every input of the batch.
+
+    void bench_mat4_multiply()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_matrix_out[i] = g_matrices[i] * g_other_matrices[i];
+    }
+
+    void bench_mat4_inverse()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_matrix_out[i] = glm::inverse(g_matrices[i]);
+    }
+
+    void bench_mat4_affineInverse()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_matrix_out[i] = glm::affineInverse(g_matrices[i]);
+    }
+
+    void bench_mat4_translate()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_matrix_out[i] = glm::translate(g_matrices[i], g_points[i]);
+    }
+
+    void bench_mat4_rotate()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_matrix_out[i] = glm::rotate(g_matrices[i], g_angles[i], g_axes[i]);
+    }
+
+    void bench_mat4_scale()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_matrix_out[i] = glm::scale(g_matrices[i], g_points[i]);
+    }
+
+    void bench_mat4_transform_vec2()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_vec2_out[i] = glm::vec2(g_matrices[i & 15] * glm::vec4(g_points2[i], 0.0f, 1.0f));
+    }
+
+    void bench_soaTransform_vec2()
+    {
+        glm::soaTransform(g_matrices[0], g_soa_points2, g_soa_points2_out);
+    }
+
+    // one 60 Hz step of a particle falling under gravity
+    const glm::vec2 PARTICLE_GRAVITY(0.0f, -9.8f);
+    const float PARTICLE_STEP = 1.0f / 60.0f;
+
+    void bench_vec2_integrate()
+    {
+        for (size_t i = 0; i < BATCH; i++)
+        {
+            g_particle_velocities[i] += PARTICLE_GRAVITY * PARTICLE_STEP;
+            g_particle_positions[i] += g_particle_velocities[i] * PARTICLE_STEP;
+        }
+    }
+
+    void bench_soaIntegrate_vec2()
+    {
+        glm::soaIntegrate(g_soa_particle_positions, g_soa_particle_velocities, PARTICLE_GRAVITY, PARTICLE_STEP);
+    }
+
+    void bench_vec2_normalize()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_vec2_out[i] = glm::normalize(g_points2[i]);
+    }
+
+    void bench_vec3_normalize()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_vec3_out[i] = glm::normalize(g_points[i]);
+    }
+
+    void bench_vec3_length()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_float_out[i] = glm::length(g_points[i]);
+    }
+
+    void bench_vec3_fastNormalize_array()
+    {
+        glm::fastNormalize(g_points, g_vec3_out, BATCH);
+    }
+
+    void bench_inversesqrt()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_float_out[i] = glm::inversesqrt(g_positive[i]);
+    }
+
+    void bench_fastInverseSqrt_array()
+    {
+        glm::fastInverseSqrt(g_positive, g_float_out, BATCH);
+    }
+
+    void bench_sincos()
+    {
+        for (size_t i = 0; i < BATCH; i++)
+        {
+            g_float_out[i] = std::sin(g_angles[i]);
+            g_other_float_out[i] = std::cos(g_angles[i]);
+        }
+    }
+
+    void bench_fastSinCos_array()
+    {
+        glm::fastSinCos(g_angles, g_float_out, g_other_float_out, BATCH);
+    }
+
+    void bench_quat_multiply()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_quat_out[i] = g_rotations[i] * g_other_rotations[i];
+    }
+
+    void bench_quat_rotate_vec3()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_vec3_out[i] = g_rotations[i] * g_points[i];
+    }
+
+    void bench_quat_slerp()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_quat_out[i] = glm::slerp(g_rotations[i], g_other_rotations[i], g_fractions[i]);
+    }
+
+    void bench_quat_mat4_cast()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_matrix_out[i] = glm::mat4_cast(g_rotations[i]);
+    }
+
+    void bench_soaMix_slerp()
+    {
+        glm::soaMix(g_soa_rotations, g_other_soa_rotations, g_fractions, g_soa_rotation_out, glm::soa_slerp);
+    }
+
+    void bench_soaMix_nlerp()
+    {
+        glm::soaMix(g_soa_rotations, g_other_soa_rotations, g_fractions, g_soa_rotation_out, glm::soa_nlerp);
+    }
+
+    void bench_packHalf1x16()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_half_out[i] = glm::packHalf1x16(g_angles[i]);
+    }
+
+    void bench_packHalf1x16_array()
+    {
+        glm::packHalf1x16(g_angles, g_half_out, BATCH);
+    }
+
+    void bench_unpackHalf1x16()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_float_out[i] = glm::unpackHalf1x16(g_halves[i]);
+    }
+
+    void bench_unpackHalf1x16_array()
+    {
+        glm::unpackHalf1x16(g_halves, g_float_out, BATCH);
+    }
+
+    void bench_simplex_vec2()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_float_out[i] = glm::simplex(g_points2[i]);
+    }
+
+    void bench_simplex_vec2_array()
+    {
+        glm::simplex(g_points2, g_float_out, BATCH);
+    }
+
+    void bench_simplex_vec3()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_float_out[i] = glm::simplex(g_points[i]);
+    }
+
+    void bench_simplex_vec3_array()
+    {
+        glm::simplex(g_points, g_float_out, BATCH);
+    }
+
+    void bench_perlin_vec2()
+    {
+        for (size_t i = 0; i < BATCH; i++) g_float_out[i] = glm::perlin(g_points2[i]);
+    }
+
+    void bench_intersectRayPlane()
+    {
+        for (size_t i = 0; i < BATCH; i++)
+        {
+            g_hit_out[i] = glm::intersectRayPlane(g_points[i], g_directions[i], g_other_points[i], g_axes[i], g_float_out[i]);
+        }
+    }
+
+    void bench_intersectRayTriangle()
+    {
+        for (size_t i = 0; i < BATCH; i++)
+        {
+            g_hit_out[i] = glm::intersectRayTriangle(g_points[i], g_directions[i], g_triangles[i][0], g_triangles[i][1],
+                                                     g_triangles[i][2], g_vec2_out[i], g_float_out[i]);
+        }
+    }
+
+    void bench_intersectLineTriangle()
+    {
+        for (size_t i = 0; i < BATCH; i++)
+        {
+            g_hit_out[i] = glm::intersectLineTriangle(g_points[i], g_directions[i], g_triangles[i][0], g_triangles[i][1],
+                                                      g_triangles[i][2], g_vec3_out[i]);
+        }
+    }
+
+    void bench_intersectRaySphere_distance()
+    {
+        for (size_t i = 0; i < BATCH; i++)
+        {
+            g_hit_out[i] = glm::intersectRaySphere(g_points[i], g_directions[i], glm::vec3(0.0f), g_radii[i] * g_radii[i],
+                                                   g_float_out[i]);
+        }
+    }
+
+    void bench_intersectRaySphere_point()
+    {
+        for (size_t i = 0; i < BATCH; i++)
+        {
+            g_hit_out[i] = glm::intersectRaySphere(g_points[i], g_directions[i], glm::vec3(0.0f), g_radii[i],
+                                                   g_vec3_out[i], g_other_vec3_out[i]);
+        }
+    }
+
+    void bench_intersectLineSphere()
+    {
+        for (size_t i = 0; i < BATCH; i++)
+        {
+            g_hit_out[i] = glm::intersectLineSphere(g_points[i], g_other_points[i], glm::vec3(0.0f), g_radii[i],
+                                                    g_vec3_out[i], g_other_vec3_out[i], g_exit_out[i], g_exit_normal_out[i]);
+        }
+    }
+
+    // The 2D sweeps: one ray against every shape, as a ball sweep or a pick does, or every ray
+    // against one shape. The scalar reference is intersectRaySphere on vec2.
+    const glm::vec2 SWEEP_ORIGIN(-12.0f, -3.0f), SWEEP_DIRECTION(24.0f, 5.0f);
+
+    void bench_intersectRaySphere_vec2()
+    {
+        glm::vec2 direction = glm::normalize(SWEEP_DIRECTION);
+
+        for (size_t i = 0; i < BATCH; i++)
+        {
+            g_hit_out[i] = glm::intersectRaySphere(SWEEP_ORIGIN, direction, g_points2[i], g_radii[i] * g_radii[i], g_float_out[i]);
+        }
+    }
+
+    void bench_intersectRayCircle_one_ray()
+    {
+        glm::intersectRayCircle(SWEEP_ORIGIN, SWEEP_DIRECTION, 1.0f, g_soa_points2, g_radii, g_hit_mask_out, g_float_out);
+    }
+
+    void bench_intersectRayCircle_one_circle()
+    {
+        glm::intersectRayCircle(g_soa_points2, g_soa_directions2, 1.0f, glm::vec2(0.0f), 3.0f, g_hit_mask_out, g_float_out);
+    }
+
+    void bench_intersectRayAABB_one_ray()
+    {
+        glm::intersectRayAABB(SWEEP_ORIGIN, SWEEP_DIRECTION, 1.0f, g_soa_box_min, g_soa_box_max, g_hit_mask_out, g_float_out);
+    }
+
+    void bench_intersectRayAABB_one_box()
+    {
+        glm::intersectRayAABB(g_soa_points2, g_soa_directions2, 1.0f, glm::vec2(-3.0f), glm::vec2(3.0f), g_hit_mask_out, g_float_out);
+    }
+
+    void bench_intersectRayOBB_one_ray()
+    {
+        glm::intersectRayOBB(SWEEP_ORIGIN, SWEEP_DIRECTION, 1.0f, g_soa_points2, g_soa_axes, g_soa_half_extents,
+                             g_hit_mask_out, g_float_out);
+    }
+
+    void bench_intersectRayOBB_one_box()
+    {
+        glm::intersectRayOBB(g_soa_points2, g_soa_directions2, 1.0f, glm::vec2(0.0f), glm::vec2(0.8f, 0.6f), glm::vec2(3.0f, 1.0f),
+                             g_hit_mask_out, g_float_out);
+    }
+
+    struct Benchmark {
+        const char *name;
+        void (*run)();
+    };
+
+    // Scalar glm calls sit next to the batch kernel that replaces them, so one report shows both.
+    const Benchmark BENCHMARKS[] = {
+        { "mat4_multiply",                 bench_mat4_multiply },
+        { "mat4_inverse",                  bench_mat4_inverse },
+        { "mat4_affineInverse",            bench_mat4_affineInverse },
+        { "mat4_translate",                bench_mat4_translate },
+        { "mat4_rotate",                   bench_mat4_rotate },
+        { "mat4_scale",                    bench_mat4_scale },
+        { "mat4_transform_vec2",           bench_mat4_transform_vec2 },
+        { "soaTransform_vec2",             bench_soaTransform_vec2 },
+        { "vec2_integrate",                bench_vec2_integrate },
+        { "soaIntegrate_vec2",             bench_soaIntegrate_vec2 },
+        { "vec2_normalize",                bench_vec2_normalize },
+        { "vec3_normalize",                bench_vec3_normalize },
+        { "vec3_length",                   bench_vec3_length },
+        { "vec3_fastNormalize_array",      bench_vec3_fastNormalize_array },
+        { "inversesqrt",                   bench_inversesqrt },
+        { "fastInverseSqrt_array",         bench_fastInverseSqrt_array },
+        { "sincos",                        bench_sincos },
+        { "fastSinCos_array",              bench_fastSinCos_array },
+        { "quat_multiply",                 bench_quat_multiply },
+        { "quat_rotate_vec3",              bench_quat_rotate_vec3 },
+        { "quat_slerp",                    bench_quat_slerp },
+        { "quat_mat4_cast",                bench_quat_mat4_cast },
+        { "soaMix_slerp",                  bench_soaMix_slerp },
+        { "soaMix_nlerp",                  bench_soaMix_nlerp },
+        { "packHalf1x16",                  bench_packHalf1x16 },
+        { "packHalf1x16_array",            bench_packHalf1x16_array },
+        { "unpackHalf1x16",                bench_unpackHalf1x16 },
+        { "unpackHalf1x16_array",          bench_unpackHalf1x16_array },
+        { "simplex_vec2",                  bench_simplex_vec2 },
+        { "simplex_vec2_array",            bench_simplex_vec2_array },
+        { "simplex_vec3",                  bench_simplex_vec3 },
+        { "simplex_vec3_array",            bench_simplex_vec3_array },
+        { "perlin_vec2",                   bench_perlin_vec2 },
+        { "intersectRayPlane",             bench_intersectRayPlane },
+        { "intersectRayTriangle",          bench_intersectRayTriangle },
+        { "intersectLineTriangle",         bench_intersectLineTriangle },
+        { "intersectRaySphere_distance",   bench_intersectRaySphere_distance },
+        { "intersectRaySphere_point",      bench_intersectRaySphere_point },
+        { "intersectLineSphere",           bench_intersectLineSphere },
+        { "intersectRaySphere_vec2",       bench_intersectRaySphere_vec2 },
+        { "intersectRayCircle_one_ray",    bench_intersectRayCircle_one_ray },
+        { "intersectRayCircle_one_circle", bench_intersectRayCircle_one_circle },
+        { "intersectRayAABB_one_ray",      bench_intersectRayAABB_one_ray },
+        { "intersectRayAABB_one_box",      bench_intersectRayAABB_one_box },
+        { "intersectRayOBB_one_ray",       bench_intersectRayOBB_one_ray },
+        { "intersectRayOBB_one_box",       bench_intersectRayOBB_one_box },
+    };
+
+    /**----HARNESS----**/
+
+    struct Options {
+        std::string filter = ".";
+        double min_time = 0.5;
+        int repetitions = 1;
+        bool json_to_stdout = false;
+        std::string out_path;
+    };
+
+    struct Run {
+        std::string name;
+        std::string run_name;
+        std::string aggregate;    // empty for a single measurement
+        int repetition_index;
+        size_t iterations;
+        double real_ns;           // per operation
+        double cpu_ns;
+    };
+
+    // Times batches of the benchmark until min_time has passed; iterations counts operations.
+    Run measure(const Benchmark &benchmark, double min_time)
+    {
+        typedef std::chrono::steady_clock clock;
+
+        // warm caches and branch predictors before anything is timed
+        benchmark.run();
+        escape_outputs();
+
+        size_t batches = 1;
+
+        for (;;)
+        {
+            clock::time_point start = clock::now();
+            std::clock_t cpu_start = std::clock();
+
+            for (size_t b = 0; b < batches; b++)
+            {
+                benchmark.run();
+                escape_outputs();
+            }
+
+            double real = std::chrono::duration<double>(clock::now() - start).count();
+            double cpu = double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+            if (real >= min_time || batches >= (size_t(1) << 40))
+            {
+                Run run;
+                run.name = benchmark.name;
+                run.run_name = benchmark.name;
+                run.repetition_index = 0;
+                run.iterations = batches * BATCH;
+                run.real_ns = real * 1e9 / double(run.iterations);
+                run.cpu_ns = cpu * 1e9 / double(run.iterations);
+                return run;
+            }
+
+            // aim 40% past min_time from the rate so far, growing at most tenfold per attempt
+            double target = real > 0.0 ? min_time * 1.4 / real * double(batches) : double(batches) * 10.0;
+            batches = size_t(std::min(std::max(target, double(batches) + 1.0), double(batches) * 10.0));
+        }
+    }
+
+    Run aggregate(const std::vector<Run> &runs, const char *name)
+    {
+        std::vector<double> real, cpu;
+
+        for (const Run &run : runs)
+        {
+            real.push_back(run.real_ns);
+            cpu.push_back(run.cpu_ns);
+        }
+
+        Run result = runs.front();
+        result.name = result.run_name + "_" + name;
+        result.aggregate = name;
+
+        for (std::vector<double> *values : { &real, &cpu })
+        {
+            std::vector<double> &v = *values;
+            double mean = 0.0;
+            for (double x : v) mean += x / double(v.size());
+
+            double value = mean;
+
+            if (std::strcmp(name, "median") == 0)
+            {
+                std::sort(v.begin(), v.end());
+                size_t half = v.size() / 2;
+                value = v.size() % 2 ? v[half] : (v[half - 1] + v[half]) * 0.5;
+            }
+            else if (std::strcmp(name, "stddev") == 0)
+            {
+                double sum = 0.0;
+                for (double x : v) sum += (x - mean) * (x - mean);
+                value = v.size() > 1 ? std::sqrt(sum / double(v.size() - 1)) : 0.0;
+            }
+
+            (values == &real ? result.real_ns : result.cpu_ns) = value;
+        }
+
+        return result;
+    }
+
+    /**----REPORTS----**/
+
+    const char *glm_arch_name()
+    {
+#if GLM_CONFIG_SIMD == GLM_DISABLE
+        return "pure";
+#elif GLM_ARCH & GLM_ARCH_AVX2_BIT
+        return "avx2";
+#elif GLM_ARCH & GLM_ARCH_AVX_BIT
+        return "avx";
+#elif GLM_ARCH & GLM_ARCH_SSE42_BIT
+        return "sse4.2";
+#elif GLM_ARCH & GLM_ARCH_SSE41_BIT
+        return "sse4.1";
+#elif GLM_ARCH & GLM_ARCH_SSSE3_BIT
+        return "ssse3";
+#elif GLM_ARCH & GLM_ARCH_SSE3_BIT
+        return "sse3";
+#elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+        return "sse2";
+#elif GLM_ARCH & GLM_ARCH_NEON_BIT
+        return "neon";
+#else
+        return "unknown";
+#endif
+    }
+
+    std::string json_string(const std::string &text)
+    {
+        std::string result = "\"";
+
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\') result += '\\';
+            result += c;
+        }
+
+        return result + "\"";
+    }
+
+    void write_json(std::ostream &out, const std::vector<Run> &runs, const char *executable)
+    {
+        char date[64];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+#ifdef NDEBUG
+        const char *build_type = "release";
+#else
+        const char *build_type = "debug";
+#endif
+#ifdef __FMA__
+        const char *fma = "true";
+#else
+        const char *fma = "false";
+#endif
+#ifdef __F16C__
+        const char *f16c = "true";
+#else
+        const char *f16c = "false";
+#endif
+#ifdef __VERSION__
+        const char *compiler = __VERSION__;
+#else
+        const char *compiler = "unknown";
+#endif
+
+        // glm_* keys are ours; Google Benchmark's tools ignore keys they do not know
+        out << "{\n  \"context\": {\n";
+        out << "    \"date\": " << json_string(date) << ",\n";
+        out << "    \"executable\": " << json_string(executable) << ",\n";
+        out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+        out << "    \"library_build_type\": \"" << build_type << "\",\n";
+        out << "    \"compiler\": " << json_string(compiler) << ",\n";
+        out << "    \"glm_version\": " << GLM_VERSION << ",\n";
+        out << "    \"glm_arch\": \"" << glm_arch_name() << "\",\n";
+        out << "    \"glm_fma\": " << fma << ",\n";
+        out << "    \"glm_f16c\": " << f16c << ",\n";
+        out << "    \"batch_size\": " << BATCH << "\n";
+        out << "  },\n  \"benchmarks\": [";
+
+        for (size_t i = 0; i < runs.size(); i++)
+        {
+            const Run &run = runs[i];
+            char numbers[256];
+            std::snprintf(numbers, sizeof(numbers),
+                          "      \"iterations\": %zu,\n      \"real_time\": %.6g,\n      \"cpu_time\": %.6g,\n"
+                          "      \"time_unit\": \"ns\",\n      \"items_per_second\": %.6g\n",
+                          run.iterations, run.real_ns, run.cpu_ns, run.real_ns > 0.0 ? 1e9 / run.real_ns : 0.0);
+
+            out << (i ? ",\n" : "\n") << "    {\n";
+            out << "      \"name\": " << json_string(run.name) << ",\n";
+            out << "      \"run_name\": " << json_string(run.run_name) << ",\n";
+
+            if (run.aggregate.empty())
+            {
+                out << "      \"run_type\": \"iteration\",\n";
+                out << "      \"repetition_index\": " << run.repetition_index << ",\n";
+            }
+            else
+            {
+                out << "      \"run_type\": \"aggregate\",\n";
+                out << "      \"aggregate_name\": " << json_string(run.aggregate) << ",\n";
+            }
+
+            out << "      \"threads\": 1,\n" << numbers << "    }";
+        }
+
+        out << "\n  ]\n}\n";
+    }
+
+    void print_console_header()
+    {
+        std::printf("glm %d, %s%s%s, batches of %zu\n", GLM_VERSION, glm_arch_name(),
+#ifdef __FMA__
+                    " +fma",
+#else
+                    "",
+#endif
+#ifdef __F16C__
+                    " +f16c",
+#else
+                    "",
+#endif
+                    BATCH);
+        std::printf("%-40s %12s %12s %14s\n", "Benchmark", "Time/op", "CPU/op", "Iterations");
+    }
+
+    void print_console(const Run &run)
+    {
+        std::printf("%-40s %9.2f ns %9.2f ns %14zu\n", run.name.c_str(), run.real_ns, run.cpu_ns, run.iterations);
+        std::fflush(stdout);
+    }
+
+    bool parse_flag(const char *arg, const char *flag, std::string &value)
+    {
+        size_t length = std::strlen(flag);
+
+        if (std::strncmp(arg, flag, length) != 0 || arg[length] != '=') return false;
+
+        value = arg + length + 1;
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string value;
+
+        if (parse_flag(argv[i], "--benchmark_filter", value))
+        {
+            options.filter = value;
+        }
+        else if (parse_flag(argv[i], "--benchmark_min_time", value))
+        {
+            options.min_time = std::atof(value.c_str());
+        }
+        else if (parse_flag(argv[i], "--benchmark_repetitions", value))
+        {
+            options.repetitions = std::max(1, std::atoi(value.c_str()));
+        }
+        else if (parse_flag(argv[i], "--benchmark_format", value) && (value == "json" || value == "console"))
+        {
+            options.json_to_stdout = value == "json";
+        }
+        else if (parse_flag(argv[i], "--benchmark_out", value))
+        {
+            options.out_path = value;
+        }
+        else
+        {
+            std::cerr << "unknown argument " << argv[i] << "; see the comment at the top of glm_bench.cpp\n";
+            return 1;
+        }
+    }
+
+    std::regex filter;
+
+    try
+    {
+        filter = std::regex(options.filter);
+    }
+    catch (const std::regex_error &)
+    {
+        std::cerr << "invalid --benchmark_filter " << options.filter << '\n';
+        return 1;
+    }
+
+    make_inputs();
+
+    if (!options.json_to_stdout) print_console_header();
+
+    std::vector<Run> runs;
+
+    for (const Benchmark &benchmark : BENCHMARKS)
+    {
+        if (!std::regex_search(benchmark.name, filter)) continue;
+
+        std::vector<Run> repetitions;
+
+        for (int r = 0; r < options.repetitions; r++)
+        {
+            Run run = measure(benchmark, options.min_time);
+            run.repetition_index = r;
+            repetitions.push_back(run);
+
+            if (!options.json_to_stdout) print_console(run);
+        }
+
+        runs.insert(runs.end(), repetitions.begin(), repetitions.end());
+
+        if (options.repetitions > 1)
+        {
+            for (const char *name : { "mean", "median", "stddev" })
+            {
+                runs.push_back(aggregate(repetitions, name));
+
+                if (!options.json_to_stdout) print_console(runs.back());
+            }
+        }
+    }
+
+    if (options.json_to_stdout) write_json(std::cout, runs, argv[0]);
+
+    if (!options.out_path.empty())
+    {
+        std::ofstream out(options.out_path);
+        write_json(out, runs, argv[0]);
+
+        if (!out)
+        {
+            std::cerr << "could not write " << options.out_path << '\n';
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,28 @@
+#!/bin/sh
+# Builds tools/glm_bench.cpp at every glm architecture level and writes <level>.json for each.
+# Run from the repository root:
+#   tools/glm_bench.sh [output directory] [benchmark flags...]
+# "avx" is how the games build glm for x86_64, and "pure" matches their arm64 builds, where glm's
+# lanes have no NEON path.
+set -e
+
+out=${1:-glm_bench_results}
+if [ $# -gt 0 ]; then shift; fi
+
+CXX=${CXX:-c++}
+mkdir -p "$out"
+
+for level in \
+    "pure:-DGLM_FORCE_PURE" \
+    "sse2:-DGLM_FORCE_SSE2 -msse2" \
+    "sse41:-DGLM_FORCE_SSE41 -msse4.1" \
+    "avx:-DGLM_FORCE_AVX -mavx -mf16c" \
+    "avx2:-DGLM_FORCE_AVX2 -mavx2 -mfma -mf16c"
+do
+    name=${level%%:*}
+    flags=${level#*:}
+
+    echo "== $name"
+    $CXX -std=c++14 -O2 -DNDEBUG $flags -Ipong/SDLProject tools/glm_bench.cpp -o "$out/glm_bench_$name"
+    "$out/glm_bench_$name" --benchmark_out="$out/$name.json" "$@"
+done
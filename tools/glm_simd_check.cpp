@@ -0,0 +1,828 @@
+/**
+* Checks glm's SIMD paths against its scalar code: the mat4 operators (operator*, inverse and
+* affineInverse) and the batch kernels in gtx/soa, gtx/fast_trigonometry, gtc/noise, gtc/packing
+* and gtx/intersect.
+*
+* This file is built with the architecture flags under test; tools/glm_simd_check_scalar.cpp is the
+* same glm with GLM_FORCE_PURE. The SIMD paths sum in a different order, and use FMA when it is
+* enabled, so they are not bit-exact; each result must instead lie within these bounds of scalar:
+*   multiply        |simd - scalar| <= 8 * FLT_EPSILON * sum over k of |a(i,k) * b(k,j)|, the
+*                   rounding both sides can make in a four-term dot product
+*   inverse         |simd - scalar| <= 1e-5 * (largest |element| of the scalar inverse), and
+*                   max |M * inverse(M) - I| <= 1e-4, on matrices with a condition number below 10
+*   affineInverse   the same bounds, on rotation * scale (0.5 to 2) + translation (up to 100)
+*   soaTransform    the multiply bound on each row, for vec4, vec3 and vec2 and per-element matrices
+*   soaMix,         slerp within 1e-5 radians of rotation of scalar slerp; nlerp within 8e-4
+*   soaRotorMix
+*   fastSinCos      2 ULP of sin and cos for |angle| <= pi, 6 ULP to 100, 1e-7 absolute to 8192
+*   fastAtan        3 ULP of atan2, with the sign of zero results kept
+*   noise           batch perlin and simplex, and simplexGrid with 1 and 4 octaves, within 1e-5
+*   packing         unpackHalf1x16 exact for all halves, packHalf1x16 exact (F16C may round a tie
+*                   the other way, by 1), and packUnorm1x16, packSnorm1x16 and packUnorm1x8 exact
+*   intersectRay*   the same hits, with times within 1e-5 * max(1, time); a circle's time may also
+*                   differ by the rounding a grazing ray's discriminant amplifies
+* -ffp-contract=off keeps the compiler from fusing the scalar half into FMAs of its own; the SIMD
+* half's FMA intrinsics are unaffected. From the repository root:
+*   c++ -std=c++14 -O2 -ffp-contract=off -DGLM_FORCE_AVX2 -mavx2 -mfma -mf16c -Ipong/SDLProject \
+*       tools/glm_simd_check.cpp tools/glm_simd_check_scalar.cpp -o glm_simd_check
+*   ./glm_simd_check [matrices]
+* Without SIMD flags the mat4 operators are scalar on both sides and must match exactly. Exits
+* with 1 when a check fails.
+**/
+#define GLM_ENABLE_EXPERIMENTAL
+#include "glm/mat4x4.hpp"
+#include "glm/gtc/matrix_inverse.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/noise.hpp"
+#include "glm/gtc/packing.hpp"
+#include "glm/gtc/type_ptr.hpp"
+#include "glm/gtx/fast_trigonometry.hpp"
+#include "glm/gtx/intersect.hpp"
+#include "glm/gtx/soa.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+void scalar_multiply(const float a[16], const float b[16], float out[16]);
+void scalar_inverse(const float m[16], float out[16]);
+void scalar_affine_inverse(const float m[16], float out[16]);
+void scalar_transform(const float m[16], const float v[4], float out[4]);
+void scalar_slerp(const float x[4], const float y[4], float a, float out[4]);
+float scalar_perlin(float x, float y);
+float scalar_simplex(float x, float y);
+float scalar_simplex(float x, float y, float z);
+unsigned short scalar_pack_half(float v);
+float scalar_unpack_half(unsigned short p);
+unsigned short scalar_pack_unorm16(float v);
+unsigned short scalar_pack_snorm16(float v);
+unsigned char scalar_pack_unorm8(float v);
+std::size_t scalar_ray_aabbs(const float origin[2], const float direction[2], float max_time, const float *box_min, const float *box_max,
+                             std::size_t count, unsigned int *hit_mask, float *times);
+std::size_t scalar_rays_aabb(const float *origins, const float *directions, std::size_t count, float max_time, const float box_min[2],
+                             const float box_max[2], unsigned int *hit_mask, float *times);
+std::size_t scalar_ray_circles(const float origin[2], const float direction[2], float max_time, const float *centers, const float *radii,
+                               std::size_t count, unsigned int *hit_mask, float *times);
+std::size_t scalar_rays_circle(const float *origins, const float *directions, std::size_t count, float max_time, const float center[2],
+                               float radius, unsigned int *hit_mask, float *times);
+std::size_t scalar_ray_obbs(const float origin[2], const float direction[2], float max_time, const float *centers, const float *axes,
+                            const float *half_extents, std::size_t count, unsigned int *hit_mask, float *times);
+std::size_t scalar_rays_obb(const float *origins, const float *directions, std::size_t count, float max_time, const float center[2],
+                            const float axis[2], const float half_extents[2], unsigned int *hit_mask, float *times);
+
+namespace {
+    const float MULTIPLY_ULPS         = 8.0f;
+    const float INVERSE_TOLERANCE     = 1e-5f;
+    const float RESIDUAL_TOLERANCE    = 1e-4f;
+    const float SIN_ULPS              = 2.0f;     // |angle| <= pi
+    const float SIN_ULPS_WIDE         = 6.0f;     // |angle| <= 100
+    const float SIN_ABSOLUTE          = 1e-7f;    // |angle| <= 8192
+    const float ATAN_ULPS             = 3.0f;
+    const float SLERP_TOLERANCE       = 1e-5f;    // radians
+    const float NLERP_TOLERANCE       = 8e-4f;    // radians of rotation, 4e-4 between the quaternions
+    const float NOISE_TOLERANCE       = 1e-5f;
+    const float INTERSECT_TOLERANCE   = 1e-5f;    // relative to max(1, time)
+    const float PI                    = 3.14159265f;
+
+    int g_failures = 0;
+
+    void check(bool passed, const char *what)
+    {
+        std::printf("%-58s %s\n", what, passed ? "ok" : "FAILED");
+        if (!passed) g_failures++;
+    }
+
+    // how the two sides compared over every element of every matrix
+    struct Comparison {
+        int exact;             // matrices bit-identical to scalar
+        float largestError;    // largest |simd - scalar|, in units of the element's bound
+        float largestAbsolute; // largest |simd - scalar|
+        float largestResidual; // largest |M * inverse - I|, for the inverses
+    };
+
+    float largest_residual(const glm::mat4 &m, const float inverse[16])
+    {
+        glm::mat4 product = m * glm::make_mat4(inverse);
+        float residual = 0.0f;
+        for (int c = 0; c < 4; c++)
+        {
+            for (int r = 0; r < 4; r++) residual = std::max(residual, std::fabs(product[c][r] - (c == r ? 1.0f : 0.0f)));
+        }
+        return residual;
+    }
+
+    // one element's difference from scalar against the bound it must stay within
+    void compare(Comparison &comparison, float simd, float scalar, float bound)
+    {
+        float difference = std::fabs(simd - scalar);
+        comparison.largestAbsolute = std::max(comparison.largestAbsolute, difference);
+        comparison.largestError = std::max(comparison.largestError, difference > 0.0f ? difference / bound : 0.0f);
+    }
+
+    // distance of a from the float nearest to exact, in units of that float's spacing
+    float ulps_from(float a, double exact)
+    {
+        float nearest = (float) exact;
+        float spacing = std::nextafter(std::fabs(nearest), INFINITY) - std::fabs(nearest);
+        return (float) (std::fabs((double) a - (double) nearest) / spacing);
+    }
+
+    void report(const char *name, const Comparison &comparison, int count)
+    {
+        std::printf("%-15s %6d of %d bit-identical, largest difference %.3g (%.2f of its bound)", name, comparison.exact, count,
+                    comparison.largestAbsolute, comparison.largestError);
+        if (comparison.largestResidual >= 0.0f) std::printf(", largest residual %.3g", comparison.largestResidual);
+        std::printf("\n");
+    }
+
+    void check_multiply(std::mt19937 &random, int count)
+    {
+        std::uniform_real_distribution<float> element(-10.0f, 10.0f);
+        Comparison comparison = { 0, 0.0f, 0.0f, -1.0f };
+
+        for (int n = 0; n < count; n++)
+        {
+            glm::mat4 a, b;
+            for (int c = 0; c < 4; c++) for (int r = 0; r < 4; r++) { a[c][r] = element(random); b[c][r] = element(random); }
+
+            glm::mat4 simd = a * b;
+            float scalar[16];
+            scalar_multiply(glm::value_ptr(a), glm::value_ptr(b), scalar);
+
+            comparison.exact += std::memcmp(glm::value_ptr(simd), scalar, sizeof(scalar)) == 0;
+            for (int c = 0; c < 4; c++)
+            {
+                for (int r = 0; r < 4; r++)
+                {
+                    float magnitude = 0.0f;
+                    for (int k = 0; k < 4; k++) magnitude += std::fabs(a[k][r] * b[c][k]);
+
+                    float difference = std::fabs(simd[c][r] - scalar[c * 4 + r]);
+                    comparison.largestAbsolute = std::max(comparison.largestAbsolute, difference);
+                    comparison.largestError = std::max(comparison.largestError, difference / (MULTIPLY_ULPS * FLT_EPSILON * magnitude));
+                }
+            }
+        }
+
+        report("multiply", comparison, count);
+        check(comparison.largestError <= 1.0f, "mat4 * mat4 is within 8 epsilon of each dot product");
+    }
+
+    template <typename Invert, typename ScalarInvert>
+    Comparison compare_inverses(const std::vector<glm::mat4> &matrices, Invert invert, ScalarInvert scalar_invert)
+    {
+        Comparison comparison = { 0, 0.0f, 0.0f, 0.0f };
+
+        for (const glm::mat4 &m : matrices)
+        {
+            glm::mat4 simd = invert(m);
+            float scalar[16];
+            scalar_invert(glm::value_ptr(m), scalar);
+
+            float largest = 0.0f;
+            for (float element : scalar) largest = std::max(largest, std::fabs(element));
+
+            comparison.exact += std::memcmp(glm::value_ptr(simd), scalar, sizeof(scalar)) == 0;
+            for (int i = 0; i < 16; i++)
+            {
+                float difference = std::fabs(glm::value_ptr(simd)[i] - scalar[i]);
+                comparison.largestAbsolute = std::max(comparison.largestAbsolute, difference);
+                comparison.largestError = std::max(comparison.largestError, difference / (INVERSE_TOLERANCE * largest));
+            }
+            comparison.largestResidual = std::max(comparison.largestResidual, largest_residual(m, glm::value_ptr(simd)));
+            comparison.largestResidual = std::max(comparison.largestResidual, largest_residual(m, scalar));
+        }
+
+        return comparison;
+    }
+
+    void check_inverse(std::mt19937 &random, int count)
+    {
+        // a random part no larger than a quarter of the diagonal keeps the condition number under 10
+        std::uniform_real_distribution<float> element(-0.25f, 0.25f), sign(-1.0f, 1.0f);
+        std::vector<glm::mat4> matrices(count);
+        for (glm::mat4 &m : matrices)
+        {
+            for (int c = 0; c < 4; c++) for (int r = 0; r < 4; r++) m[c][r] = element(random) + (c == r ? (sign(random) < 0.0f ? -1.0f : 1.0f) : 0.0f);
+        }
+
+        Comparison comparison = compare_inverses(matrices, [](const glm::mat4 &m) { return glm::inverse(m); }, scalar_inverse);
+        report("inverse", comparison, count);
+        check(comparison.largestError <= 1.0f, "inverse is within 1e-5 of scalar, relative to its largest element");
+        check(comparison.largestResidual <= RESIDUAL_TOLERANCE, "M * inverse(M) is within 1e-4 of identity");
+    }
+
+    void check_affine_inverse(std::mt19937 &random, int count)
+    {
+        std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f), axis(-1.0f, 1.0f), scale(0.5f, 2.0f), offset(-100.0f, 100.0f);
+        std::vector<glm::mat4> matrices(count);
+        for (glm::mat4 &m : matrices)
+        {
+            glm::vec3 direction(axis(random), axis(random), axis(random));
+            if (glm::length(direction) < 1e-3f) direction = glm::vec3(0.0f, 0.0f, 1.0f);
+
+            m = glm::translate(glm::mat4(1.0f), glm::vec3(offset(random), offset(random), offset(random))) *
+                glm::rotate(glm::mat4(1.0f), angle(random), glm::normalize(direction)) *
+                glm::scale(glm::mat4(1.0f), glm::vec3(scale(random), scale(random), scale(random)));
+        }
+
+        Comparison comparison = compare_inverses(matrices, [](const glm::mat4 &m) { return glm::affineInverse(m); }, scalar_affine_inverse);
+        report("affineInverse", comparison, count);
+        check(comparison.largestError <= 1.0f, "affineInverse is within 1e-5 of scalar, relative to its largest element");
+        check(comparison.largestResidual <= RESIDUAL_TOLERANCE, "M * affineInverse(M) is within 1e-4 of identity");
+    }
+
+    // soaTransform against m * v in the scalar build; vec3 and vec2 points take w = 1, vec2 points z = 0
+    template <glm::length_t L>
+    Comparison compare_transforms(std::mt19937 &random, int count, bool per_element)
+    {
+        std::uniform_real_distribution<float> element(-10.0f, 10.0f);
+        std::vector<glm::mat4> matrices(per_element ? count : 1);
+        for (glm::mat4 &m : matrices)
+        {
+            for (int c = 0; c < 4; c++) for (int r = 0; r < 4; r++) m[c][r] = element(random);
+        }
+
+        glm::soa<glm::vec<L, float> > in, out;
+        for (int i = 0; i < count; i++)
+        {
+            glm::vec<L, float> v;
+            for (glm::length_t c = 0; c < L; c++) v[c] = element(random);
+            in.push_back(v);
+        }
+
+        if (per_element) glm::soaTransform(matrices.data(), in, out);
+        else             glm::soaTransform(matrices[0], in, out);
+
+        Comparison comparison = { 0, 0.0f, 0.0f, -1.0f };
+        for (int i = 0; i < count; i++)
+        {
+            const glm::mat4 &m = matrices[per_element ? i : 0];
+            glm::vec<L, float> v = in.get(i), simd = out.get(i);
+
+            float point[4] = { 0.0f, 0.0f, 0.0f, 1.0f }, scalar[4];
+            for (glm::length_t c = 0; c < L; c++) point[c] = v[c];
+            scalar_transform(glm::value_ptr(m), point, scalar);
+
+            comparison.exact += std::memcmp(&simd[0], scalar, sizeof(float) * L) == 0;
+            for (glm::length_t r = 0; r < L; r++)
+            {
+                float magnitude = 0.0f;
+                for (int k = 0; k < 4; k++) magnitude += std::fabs(m[k][r] * point[k]);
+                compare(comparison, simd[r], scalar[r], MULTIPLY_ULPS * FLT_EPSILON * magnitude);
+            }
+        }
+        return comparison;
+    }
+
+    void check_transform(std::mt19937 &random, int count)
+    {
+        // a count that is not a multiple of 8 also runs the kernels' scalar tails
+        count += 5;
+
+        Comparison comparison = compare_transforms<4>(random, count, false);
+        report("soaTransform4", comparison, count);
+        check(comparison.largestError <= 1.0f, "soaTransform vec4 is within 8 epsilon of each dot product");
+
+        comparison = compare_transforms<3>(random, count, false);
+        report("soaTransform3", comparison, count);
+        check(comparison.largestError <= 1.0f, "soaTransform vec3 is within 8 epsilon of each dot product");
+
+        comparison = compare_transforms<2>(random, count, false);
+        report("soaTransform2", comparison, count);
+        check(comparison.largestError <= 1.0f, "soaTransform vec2 is within 8 epsilon of each dot product");
+
+        comparison = compare_transforms<4>(random, count, true);
+        report("soaTransform[]", comparison, count);
+        check(comparison.largestError <= 1.0f, "soaTransform per element is within 8 epsilon");
+    }
+
+    // the angle between the rotations of two unit quaternions held as x, y, z, w, whichever sign
+    // either has; twice the angle between the quaternions themselves
+    double rotation_angle(const float a[4], const float b[4])
+    {
+        double dot = 0.0, minus = 0.0, plus = 0.0;
+        for (int i = 0; i < 4; i++)
+        {
+            dot   += (double) a[i] * b[i];
+            minus += ((double) a[i] - b[i]) * ((double) a[i] - b[i]);
+            plus  += ((double) a[i] + b[i]) * ((double) a[i] + b[i]);
+        }
+        return 4.0 * std::asin(std::min(1.0, std::sqrt(dot < 0.0 ? plus : minus) / 2.0));
+    }
+
+    // Random pairs of unit quaternions: a third unrelated, a third within about 1e-3 of each other,
+    // which takes slerp's nearly-parallel branch, and a third near the negated first, which must take the short way.
+    void random_rotation_pairs(std::mt19937 &random, int count, glm::soa<glm::quat> &x, glm::soa<glm::quat> &y)
+    {
+        std::normal_distribution<float> normal;
+        std::uniform_real_distribution<float> nudge(-1e-3f, 1e-3f);
+        for (int i = 0; i < count; i++)
+        {
+            glm::quat p = glm::normalize(glm::quat(normal(random), normal(random), normal(random), normal(random)));
+            glm::quat q = glm::normalize(glm::quat(normal(random), normal(random), normal(random), normal(random)));
+            if (i % 3 == 1) q = glm::normalize(glm::quat(p.w + nudge(random), p.x + nudge(random), p.y + nudge(random), p.z + nudge(random)));
+            if (i % 3 == 2) q = glm::normalize(glm::quat(-p.w + nudge(random), -p.x + nudge(random), -p.y + nudge(random), -p.z + nudge(random)));
+            x.push_back(p);
+            y.push_back(q);
+        }
+    }
+
+    // largest angle between soaMix's result and slerp in the scalar build
+    double compare_mixes(const glm::soa<glm::quat> &x, const glm::soa<glm::quat> &y, const std::vector<float> &a, const glm::soa<glm::quat> &out)
+    {
+        double largest = 0.0;
+        for (std::size_t i = 0; i < x.size(); i++)
+        {
+            glm::quat p = x.get(i), q = y.get(i), r = out.get(i);
+            float from[4] = { p.x, p.y, p.z, p.w }, to[4] = { q.x, q.y, q.z, q.w }, simd[4] = { r.x, r.y, r.z, r.w }, scalar[4];
+            scalar_slerp(from, to, a[a.size() == 1 ? 0 : i], scalar);
+            largest = std::max(largest, rotation_angle(simd, scalar));
+        }
+        return largest;
+    }
+
+    void check_rotation_mix(std::mt19937 &random, int count)
+    {
+        count += 5;
+        std::uniform_real_distribution<float> parameter(0.0f, 1.0f);
+
+        glm::soa<glm::quat> x, y, out;
+        random_rotation_pairs(random, count, x, y);
+        std::vector<float> a(count), one(1, 0.3f);
+        for (float &t : a) t = parameter(random);
+
+        glm::soaMix(x, y, one[0], out, glm::soa_slerp);
+        double slerp = compare_mixes(x, y, one, out);
+        glm::soaMix(x, y, a.data(), out, glm::soa_slerp);
+        slerp = std::max(slerp, compare_mixes(x, y, a, out));
+        glm::soaMix(x, y, a.data(), out, glm::soa_nlerp);
+        double nlerp = compare_mixes(x, y, a, out);
+        std::printf("soaMix          largest angle from scalar slerp %.3g rad (slerp), %.3g rad (nlerp)\n", slerp, nlerp);
+        check(slerp <= SLERP_TOLERANCE, "soaMix slerp is within 1e-5 rad of scalar slerp");
+        check(nlerp <= NLERP_TOLERANCE, "soaMix nlerp is within 8e-4 rad of scalar slerp");
+
+        // 2D rotors are quaternions about z with only w and z stored
+        glm::soa<glm::vec2> rx, ry, rout;
+        for (int i = 0; i < count; i++)
+        {
+            glm::quat p = x.get(i), q = y.get(i);
+            glm::vec2 from = glm::normalize(glm::vec2(p.w, p.z)), to = glm::normalize(glm::vec2(q.w, q.z));
+            rx.push_back(from);
+            ry.push_back(to);
+        }
+
+        double rotor_slerp = 0.0, rotor_nlerp = 0.0;
+        for (int mode = 0; mode < 2; mode++)
+        {
+            glm::soaRotorMix(rx, ry, a.data(), rout, mode == 0 ? glm::soa_slerp : glm::soa_nlerp);
+            for (int i = 0; i < count; i++)
+            {
+                glm::vec2 p = rx.get(i), q = ry.get(i), r = rout.get(i);
+                float from[4] = { 0.0f, 0.0f, p.y, p.x }, to[4] = { 0.0f, 0.0f, q.y, q.x }, simd[4] = { 0.0f, 0.0f, r.y, r.x }, scalar[4];
+                scalar_slerp(from, to, a[i], scalar);
+                double &largest = mode == 0 ? rotor_slerp : rotor_nlerp;
+                largest = std::max(largest, rotation_angle(simd, scalar));
+            }
+        }
+        std::printf("soaRotorMix     largest angle from scalar slerp %.3g rad (slerp), %.3g rad (nlerp)\n", rotor_slerp, rotor_nlerp);
+        check(rotor_slerp <= SLERP_TOLERANCE, "soaRotorMix slerp is within 1e-5 rad of scalar slerp");
+        check(rotor_nlerp <= NLERP_TOLERANCE, "soaRotorMix nlerp is within 8e-4 rad of scalar slerp");
+    }
+
+    // the array fastSin, fastCos and fastSinCos over one range, in ULPs of std::sin / std::cos in
+    // double, or in absolute error when ulps is 0
+    void check_sin_cos_range(std::mt19937 &random, int count, float limit, float ulps, float absolute, const char *what)
+    {
+        std::uniform_real_distribution<float> angle(-limit, limit);
+        std::vector<float> angles(count + 5), sines(angles.size()), cosines(angles.size()), sin_only(angles.size()), cos_only(angles.size());
+        for (float &a : angles) a = angle(random);
+
+        glm::fastSinCos(angles.data(), sines.data(), cosines.data(), angles.size());
+        glm::fastSin(angles.data(), sin_only.data(), angles.size());
+        glm::fastCos(angles.data(), cos_only.data(), angles.size());
+
+        float largest = 0.0f;
+        bool same = true;
+        for (std::size_t i = 0; i < angles.size(); i++)
+        {
+            double s = std::sin((double) angles[i]), c = std::cos((double) angles[i]);
+            if (ulps > 0.0f) largest = std::max(largest, std::max(ulps_from(sines[i], s), ulps_from(cosines[i], c)));
+            else             largest = std::max(largest, (float) std::max(std::fabs(sines[i] - s), std::fabs(cosines[i] - c)));
+            same = same && sines[i] == sin_only[i] && cosines[i] == cos_only[i];
+        }
+
+        char line[64];
+        std::snprintf(line, sizeof(line), "fastSinCos, |angle| <= %s", what);
+        if (ulps > 0.0f)
+        {
+            std::printf("%-40s largest error %.2f ULP\n", line, largest);
+            std::snprintf(line, sizeof(line), "fastSinCos is within %.0f ULP for |angle| <= %s", ulps, what);
+            check(largest <= ulps, line);
+        }
+        else
+        {
+            std::printf("%-40s largest error %.3g\n", line, largest);
+            std::snprintf(line, sizeof(line), "fastSinCos is within 1e-7 for |angle| <= %s", what);
+            check(largest <= absolute, line);
+        }
+        std::snprintf(line, sizeof(line), "fastSin and fastCos match fastSinCos, |angle| <= %s", what);
+        check(same, line);
+    }
+
+    void check_trigonometry(std::mt19937 &random, int count)
+    {
+        check_sin_cos_range(random, count, PI, SIN_ULPS, 0.0f, "pi");
+        check_sin_cos_range(random, count, 100.0f, SIN_ULPS_WIDE, 0.0f, "100");
+        check_sin_cos_range(random, count, 8192.0f, 0.0f, SIN_ABSOLUTE, "8192");
+
+        // magnitudes from 1e-3 to 1e3 on either side, then the signed zeros and axes
+        std::uniform_real_distribution<float> exponent(-3.0f, 3.0f), sign(-1.0f, 1.0f);
+        std::vector<float> y, x;
+        for (int i = 0; i < count; i++)
+        {
+            y.push_back(std::copysign(std::pow(10.0f, exponent(random)), sign(random)));
+            x.push_back(std::copysign(std::pow(10.0f, exponent(random)), sign(random)));
+        }
+        const float special[][2] = { { 0.0f, 0.0f }, { -0.0f, 0.0f }, { 0.0f, -0.0f }, { -0.0f, -0.0f }, { 0.0f, 2.0f }, { -0.0f, 2.0f },
+                                     { 0.0f, -2.0f }, { -0.0f, -2.0f }, { 3.0f, 0.0f }, { -3.0f, 0.0f }, { 3.0f, -0.0f }, { -3.0f, -0.0f } };
+        for (const float (&pair)[2] : special)
+        {
+            y.push_back(pair[0]);
+            x.push_back(pair[1]);
+        }
+
+        std::vector<float> out(y.size());
+        glm::fastAtan(y.data(), x.data(), out.data(), y.size());
+
+        float largest = 0.0f;
+        bool zeros = true;
+        for (std::size_t i = 0; i < y.size(); i++)
+        {
+            double exact = std::atan2((double) y[i], (double) x[i]);
+            if (exact == 0.0) zeros = zeros && out[i] == 0.0f && std::signbit(out[i]) == std::signbit(exact);
+            else              largest = std::max(largest, ulps_from(out[i], exact));
+        }
+        std::printf("%-40s largest error %.2f ULP\n", "fastAtan", largest);
+        check(largest <= ATAN_ULPS, "fastAtan is within 3 ULP of atan2");
+        check(zeros, "fastAtan keeps the sign of zero results");
+    }
+
+    // fractal Brownian motion over the scalar build's simplex, as simplexGrid documents it
+    float scalar_fbm(glm::vec3 p, bool planar, int octaves, float lacunarity, float gain)
+    {
+        float sum = 0.0f, total = 0.0f, weight = 1.0f, frequency = 1.0f;
+        for (int k = 0; k < octaves; k++)
+        {
+            glm::vec3 q = p * frequency;
+            sum += weight * (planar ? scalar_simplex(q.x, q.y) : scalar_simplex(q.x, q.y, q.z));
+            total += weight;
+            weight *= gain;
+            frequency *= lacunarity;
+        }
+        return sum / total;
+    }
+
+    void check_noise(std::mt19937 &random, int count)
+    {
+        count += 5;
+        std::uniform_real_distribution<float> coordinate(-50.0f, 50.0f);
+        std::vector<glm::vec2> planar(count);
+        std::vector<glm::vec3> points(count);
+        for (int i = 0; i < count; i++)
+        {
+            planar[i] = glm::vec2(coordinate(random), coordinate(random));
+            points[i] = glm::vec3(coordinate(random), coordinate(random), coordinate(random));
+        }
+
+        std::vector<float> out(count);
+        Comparison perlin = { 0, 0.0f, 0.0f, -1.0f }, simplex2 = perlin, simplex3 = perlin;
+        glm::perlin(planar.data(), out.data(), count);
+        for (int i = 0; i < count; i++)
+        {
+            float scalar = scalar_perlin(planar[i].x, planar[i].y);
+            perlin.exact += out[i] == scalar;
+            compare(perlin, out[i], scalar, NOISE_TOLERANCE);
+        }
+        glm::simplex(planar.data(), out.data(), count);
+        for (int i = 0; i < count; i++)
+        {
+            float scalar = scalar_simplex(planar[i].x, planar[i].y);
+            simplex2.exact += out[i] == scalar;
+            compare(simplex2, out[i], scalar, NOISE_TOLERANCE);
+        }
+        glm::simplex(points.data(), out.data(), count);
+        for (int i = 0; i < count; i++)
+        {
+            float scalar = scalar_simplex(points[i].x, points[i].y, points[i].z);
+            simplex3.exact += out[i] == scalar;
+            compare(simplex3, out[i], scalar, NOISE_TOLERANCE);
+        }
+        report("perlin", perlin, count);
+        report("simplex2", simplex2, count);
+        report("simplex3", simplex3, count);
+        check(perlin.largestError <= 1.0f, "batch perlin is within 1e-5 of scalar perlin");
+        check(simplex2.largestError <= 1.0f, "batch simplex vec2 is within 1e-5 of scalar simplex");
+        check(simplex3.largestError <= 1.0f, "batch simplex vec3 is within 1e-5 of scalar simplex");
+
+        // grids of one and of four octaves over the plane and a slice of 3D noise
+        const int WIDTH = 67, HEIGHT = 41, SPLIT = 17;
+        const glm::vec3 origin(-12.5f, 30.25f, 4.75f);
+        const glm::vec2 step(0.37f, 0.29f);
+        for (int octaves = 1; octaves <= 4; octaves += 3)
+        {
+            for (int dimensions = 2; dimensions <= 3; dimensions++)
+            {
+                std::vector<float> grid(WIDTH * HEIGHT), split(WIDTH * HEIGHT);
+                if (dimensions == 2)
+                {
+                    glm::simplexGrid(glm::vec2(origin), step, WIDTH, 0, HEIGHT, grid.data(), octaves);
+                    glm::simplexGrid(glm::vec2(origin), step, WIDTH, 0, SPLIT, split.data(), octaves);
+                    glm::simplexGrid(glm::vec2(origin), step, WIDTH, SPLIT, HEIGHT, split.data(), octaves);
+                }
+                else
+                {
+                    glm::simplexGrid(origin, step, WIDTH, 0, HEIGHT, grid.data(), octaves);
+                    glm::simplexGrid(origin, step, WIDTH, 0, SPLIT, split.data(), octaves);
+                    glm::simplexGrid(origin, step, WIDTH, SPLIT, HEIGHT, split.data(), octaves);
+                }
+
+                Comparison comparison = { 0, 0.0f, 0.0f, -1.0f };
+                for (int y = 0; y < HEIGHT; y++)
+                {
+                    for (int x = 0; x < WIDTH; x++)
+                    {
+                        glm::vec3 p(origin.x + x * step.x, origin.y + y * step.y, origin.z);
+                        float scalar = scalar_fbm(p, dimensions == 2, octaves, 2.0f, 0.5f);
+                        comparison.exact += grid[y * WIDTH + x] == scalar;
+                        compare(comparison, grid[y * WIDTH + x], scalar, NOISE_TOLERANCE);
+                    }
+                }
+
+                char name[32], line[64];
+                std::snprintf(name, sizeof(name), "simplexGrid%dD x%d", dimensions, octaves);
+                report(name, comparison, WIDTH * HEIGHT);
+                std::snprintf(line, sizeof(line), "%dD simplexGrid, %d octave(s), is within 1e-5 of scalar", dimensions, octaves);
+                check(comparison.largestError <= 1.0f, line);
+                std::snprintf(line, sizeof(line), "%dD simplexGrid, %d octave(s), fills split rows the same", dimensions, octaves);
+                check(std::memcmp(grid.data(), split.data(), grid.size() * sizeof(float)) == 0, line);
+            }
+        }
+    }
+
+    bool is_half_nan(unsigned short h)
+    {
+        return (h & 0x7c00) == 0x7c00 && (h & 0x03ff) != 0;
+    }
+
+    void check_packing(std::mt19937 &random, int count)
+    {
+        // F16C rounds ties to even where the scalar conversion rounds them away from zero
+#if (GLM_ARCH & GLM_ARCH_AVX_BIT) && defined(__F16C__)
+        const unsigned int HALF_TIE_DIFFERENCE = 1;
+#else
+        const unsigned int HALF_TIE_DIFFERENCE = 0;
+#endif
+
+        // every half, and then floats of every bit pattern, so infinities, NaNs and denormals are all covered
+        std::vector<glm::uint16> halves(65536);
+        for (int i = 0; i < 65536; i++) halves[i] = (glm::uint16) i;
+        std::vector<float> unpacked(halves.size());
+        glm::unpackHalf1x16(halves.data(), unpacked.data(), halves.size());
+
+        bool same = true;
+        for (int i = 0; i < 65536; i++)
+        {
+            float scalar = scalar_unpack_half((unsigned short) i);
+            same = same && (std::memcmp(&unpacked[i], &scalar, sizeof(float)) == 0 || (std::isnan(unpacked[i]) && std::isnan(scalar)));
+        }
+        check(same, "unpackHalf1x16 array is exact for all 65536 halves");
+
+        std::uniform_int_distribution<unsigned int> bits;
+        std::vector<float> floats(count + 5);
+        for (float &f : floats)
+        {
+            unsigned int b = bits(random);
+            std::memcpy(&f, &b, sizeof(f));
+        }
+        // and halfway between neighbouring halves, where the two roundings part
+        for (int i = 1; i < 1024; i++) floats.push_back((i + 0.5f) / 1024.0f);
+
+        std::vector<glm::uint16> packed(floats.size());
+        glm::packHalf1x16(floats.data(), packed.data(), floats.size());
+        int differ = 0;
+        bool close = true;
+        for (std::size_t i = 0; i < floats.size(); i++)
+        {
+            unsigned short scalar = scalar_pack_half(floats[i]);
+            if (packed[i] == scalar) continue;
+
+            differ++;
+            bool nan = is_half_nan(packed[i]) && is_half_nan(scalar);
+            unsigned int distance = (unsigned int) std::abs((int) packed[i] - (int) scalar);
+            close = close && (nan || ((packed[i] & 0x8000) == (scalar & 0x8000) && distance <= HALF_TIE_DIFFERENCE));
+        }
+        std::printf("%-40s %d of %d differ from scalar\n", "packHalf1x16", differ, (int) floats.size());
+        check(close, HALF_TIE_DIFFERENCE ? "packHalf1x16 array is within 1 of scalar (F16C ties)" : "packHalf1x16 array matches scalar");
+
+        // normalized values past both ends, plus values at the rounding ties of each format
+        std::uniform_real_distribution<float> normalized(-1.5f, 1.5f);
+        std::vector<float> values(count + 5);
+        for (float &v : values) v = normalized(random);
+        for (int i = 0; i < 255; i++) values.push_back((i + 0.5f) / 255.0f);
+        for (int i = 0; i < 4096; i++) values.push_back((i * 16 + 0.5f) / 65535.0f);
+        for (int i = -2048; i < 2048; i++) values.push_back((i * 16 + 0.5f) / 32767.0f);
+
+        std::vector<glm::uint16> unorm16(values.size()), snorm16(values.size());
+        std::vector<glm::uint8> unorm8(values.size());
+        glm::packUnorm1x16(values.data(), unorm16.data(), values.size());
+        glm::packSnorm1x16(values.data(), snorm16.data(), values.size());
+        glm::packUnorm1x8(values.data(), unorm8.data(), values.size());
+
+        bool same16 = true, same_signed = true, same8 = true;
+        for (std::size_t i = 0; i < values.size(); i++)
+        {
+            same16      = same16 && unorm16[i] == scalar_pack_unorm16(values[i]);
+            same_signed = same_signed && snorm16[i] == scalar_pack_snorm16(values[i]);
+            same8       = same8 && unorm8[i] == scalar_pack_unorm8(values[i]);
+        }
+        check(same16, "packUnorm1x16 array matches scalar");
+        check(same_signed, "packSnorm1x16 array matches scalar");
+        check(same8, "packUnorm1x8 array matches scalar");
+    }
+
+    // Compares one sweep's hit masks and times with the scalar build's. The random scenes are fixed
+    // by the seed and hold no ray within rounding of grazing a shape, so the masks must match. slack,
+    // when given, widens each time's bound by the rounding its computation amplifies.
+    struct Sweeps {
+        Comparison times;  // over the hits both sides found
+        int hits;
+        int mismatches;    // pairs only one side hit, and sweeps whose hit counts differ
+    };
+
+    void compare_sweep(const std::vector<unsigned int> &mask, const std::vector<float> &times, std::size_t hits,
+                       const std::vector<unsigned int> &scalar_mask, const std::vector<float> &scalar_times, std::size_t scalar_hits,
+                       std::size_t count, const std::vector<float> &slack, Sweeps &sweeps)
+    {
+        Comparison &comparison = sweeps.times;
+        if (hits != scalar_hits) sweeps.mismatches++;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            bool hit = (mask[i / 32] >> (i % 32)) & 1u, scalar_hit = (scalar_mask[i / 32] >> (i % 32)) & 1u;
+            if (hit != scalar_hit)
+            {
+                sweeps.mismatches++;
+                continue;
+            }
+            if (!hit) continue;
+
+            sweeps.hits++;
+            comparison.exact += times[i] == scalar_times[i];
+            float bound = INTERSECT_TOLERANCE * std::max(1.0f, std::fabs(scalar_times[i]));
+            compare(comparison, times[i], scalar_times[i], slack.empty() ? bound : bound + slack[i]);
+        }
+    }
+
+    // A circle's entry time takes the square root of b^2 - |d|^2 * c, whose terms cancel as a ray
+    // nears grazing the circle: the rounding in them, up to 8 epsilon of their magnitudes, is divided
+    // by 2 |d|^2 sqrt(discriminant) on its way into the time.
+    float grazing_slack(const float origin[2], const float direction[2], const float center[2], float radius)
+    {
+        double x = (double) origin[0] - center[0], y = (double) origin[1] - center[1];
+        double b = x * direction[0] + y * direction[1], length_squared = (double) direction[0] * direction[0] + (double) direction[1] * direction[1];
+        double discriminant = b * b - length_squared * (x * x + y * y - (double) radius * radius);
+        double rounding = MULTIPLY_ULPS * FLT_EPSILON * (b * b + length_squared * (x * x + y * y + (double) radius * radius));
+        return (float) (rounding / (2.0 * length_squared * std::sqrt(std::max(discriminant, rounding))));
+    }
+
+    void check_intersect(std::mt19937 &random, int count)
+    {
+        const int RAYS = 16;
+        const float MAX_TIME = 100.0f;
+        std::uniform_real_distribution<float> place(-50.0f, 50.0f), size(0.5f, 10.0f), turn(-PI, PI), speed(0.5f, 2.0f);
+
+        // shapes: boxes as min and max, circles, and oriented boxes as centre, (cos, sin) axis and half extents
+        std::size_t shapes = count / RAYS + 5;
+        std::vector<float> box_min, box_max, centers, radii, axes, half_extents;
+        glm::soa<glm::vec2> soa_min, soa_max, soa_centers, soa_axes, soa_half;
+        for (std::size_t i = 0; i < shapes; i++)
+        {
+            glm::vec2 low(place(random), place(random)), high = low + glm::vec2(size(random), size(random));
+            glm::vec2 center(place(random), place(random)), half(size(random) / 2.0f, size(random) / 2.0f);
+            float angle = turn(random);
+            glm::vec2 axis(std::cos(angle), std::sin(angle));
+
+            box_min.insert(box_min.end(), { low.x, low.y });
+            box_max.insert(box_max.end(), { high.x, high.y });
+            centers.insert(centers.end(), { center.x, center.y });
+            axes.insert(axes.end(), { axis.x, axis.y });
+            half_extents.insert(half_extents.end(), { half.x, half.y });
+            radii.push_back(size(random) / 2.0f);
+
+            soa_min.push_back(low);
+            soa_max.push_back(high);
+            soa_centers.push_back(center);
+            soa_axes.push_back(axis);
+            soa_half.push_back(half);
+        }
+
+        std::vector<float> origins, directions;
+        glm::soa<glm::vec2> soa_origins, soa_directions;
+        for (std::size_t i = 0; i < shapes; i++)
+        {
+            float angle = turn(random), length = speed(random);
+            glm::vec2 origin(place(random), place(random)), direction(std::cos(angle) * length, std::sin(angle) * length);
+            origins.insert(origins.end(), { origin.x, origin.y });
+            directions.insert(directions.end(), { direction.x, direction.y });
+            soa_origins.push_back(origin);
+            soa_directions.push_back(direction);
+        }
+
+        std::vector<unsigned int> mask((shapes + 31) / 32), scalar_mask(mask.size());
+        std::vector<float> times(shapes), scalar_times(shapes), none, slack(shapes);
+        Sweeps aabb = { { 0, 0.0f, 0.0f, -1.0f }, 0, 0 }, circle = aabb, obb = aabb;
+
+        for (int r = 0; r < RAYS; r++)
+        {
+            // ray r of the ray set against every shape, then every ray against shape r
+            glm::vec2 origin = soa_origins.get(r), direction = soa_directions.get(r);
+            const float *o = &origins[r * 2], *d = &directions[r * 2];
+
+            std::size_t hits = glm::intersectRayAABB(origin, direction, MAX_TIME, soa_min, soa_max, mask.data(), times.data());
+            std::size_t scalar_hits = scalar_ray_aabbs(o, d, MAX_TIME, box_min.data(), box_max.data(), shapes, scalar_mask.data(), scalar_times.data());
+            compare_sweep(mask, times, hits, scalar_mask, scalar_times, scalar_hits, shapes, none, aabb);
+
+            hits = glm::intersectRayAABB(soa_origins, soa_directions, MAX_TIME, soa_min.get(r), soa_max.get(r), mask.data(), times.data());
+            scalar_hits = scalar_rays_aabb(origins.data(), directions.data(), shapes, MAX_TIME, &box_min[r * 2], &box_max[r * 2],
+                                           scalar_mask.data(), scalar_times.data());
+            compare_sweep(mask, times, hits, scalar_mask, scalar_times, scalar_hits, shapes, none, aabb);
+
+            for (std::size_t i = 0; i < shapes; i++) slack[i] = grazing_slack(o, d, &centers[i * 2], radii[i]);
+            hits = glm::intersectRayCircle(origin, direction, MAX_TIME, soa_centers, radii.data(), mask.data(), times.data());
+            scalar_hits = scalar_ray_circles(o, d, MAX_TIME, centers.data(), radii.data(), shapes, scalar_mask.data(), scalar_times.data());
+            compare_sweep(mask, times, hits, scalar_mask, scalar_times, scalar_hits, shapes, slack, circle);
+
+            for (std::size_t i = 0; i < shapes; i++) slack[i] = grazing_slack(&origins[i * 2], &directions[i * 2], &centers[r * 2], radii[r]);
+            hits = glm::intersectRayCircle(soa_origins, soa_directions, MAX_TIME, soa_centers.get(r), radii[r], mask.data(), times.data());
+            scalar_hits = scalar_rays_circle(origins.data(), directions.data(), shapes, MAX_TIME, &centers[r * 2], radii[r],
+                                             scalar_mask.data(), scalar_times.data());
+            compare_sweep(mask, times, hits, scalar_mask, scalar_times, scalar_hits, shapes, slack, circle);
+
+            hits = glm::intersectRayOBB(origin, direction, MAX_TIME, soa_centers, soa_axes, soa_half, mask.data(), times.data());
+            scalar_hits = scalar_ray_obbs(o, d, MAX_TIME, centers.data(), axes.data(), half_extents.data(), shapes, scalar_mask.data(), scalar_times.data());
+            compare_sweep(mask, times, hits, scalar_mask, scalar_times, scalar_hits, shapes, none, obb);
+
+            hits = glm::intersectRayOBB(soa_origins, soa_directions, MAX_TIME, soa_centers.get(r), soa_axes.get(r), soa_half.get(r), mask.data(), times.data());
+            scalar_hits = scalar_rays_obb(origins.data(), directions.data(), shapes, MAX_TIME, &centers[r * 2], &axes[r * 2], &half_extents[r * 2],
+                                          scalar_mask.data(), scalar_times.data());
+            compare_sweep(mask, times, hits, scalar_mask, scalar_times, scalar_hits, shapes, none, obb);
+        }
+
+        std::printf("intersectRay*   %d ray and shape pairs of each kind; the times of their hits:\n", (int) shapes * RAYS * 2);
+        report("  AABB", aabb.times, aabb.hits);
+        report("  circle", circle.times, circle.hits);
+        report("  OBB", obb.times, obb.hits);
+        check(aabb.mismatches == 0, "intersectRayAABB hits the same boxes as scalar");
+        check(aabb.times.largestError <= 1.0f, "intersectRayAABB times are within 1e-5 of scalar");
+        check(circle.mismatches == 0, "intersectRayCircle hits the same circles as scalar");
+        check(circle.times.largestError <= 1.0f, "intersectRayCircle times are within 1e-5 plus grazing");
+        check(obb.mismatches == 0, "intersectRayOBB hits the same boxes as scalar");
+        check(obb.times.largestError <= 1.0f, "intersectRayOBB times are within 1e-5 of scalar");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+    std::mt19937 random(3113);
+
+#if GLM_ARCH & GLM_ARCH_SIMD_BIT
+    std::printf("glm SIMD paths against scalar, %d matrices each\n\n", count);
+#else
+    std::printf("glm built without intrinsics: both sides are scalar, %d matrices each\n\n", count);
+#endif
+
+    check_multiply(random, count);
+    check_inverse(random, count);
+    check_affine_inverse(random, count);
+    std::printf("\n");
+    check_transform(random, count);
+    check_rotation_mix(random, count);
+    std::printf("\n");
+    check_trigonometry(random, count);
+    std::printf("\n");
+    check_noise(random, count);
+    std::printf("\n");
+    check_packing(random, count);
+    std::printf("\n");
+    check_intersect(random, count);
+
+    if (g_failures > 0) std::printf("\n%d check(s) FAILED\n", g_failures);
+    return g_failures > 0 ? 1 : 0;
+}
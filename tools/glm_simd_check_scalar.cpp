@@ -0,0 +1,150 @@
+// The scalar half of tools/glm_simd_check.cpp: glm built once more with GLM_FORCE_PURE, whatever the
+// compiler flags, and renamed to glm_scalar so none of its inline functions shares a symbol with the
+// SIMD build it is linked beside.
+#define GLM_FORCE_PURE
+#define GLM_ENABLE_EXPERIMENTAL
+#define glm glm_scalar
+
+#include "glm/mat4x4.hpp"
+#include "glm/gtc/matrix_inverse.hpp"
+#include "glm/gtc/noise.hpp"
+#include "glm/gtc/packing.hpp"
+#include "glm/gtc/quaternion.hpp"
+#include "glm/gtc/type_ptr.hpp"
+#include "glm/gtx/intersect.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+namespace {
+    glm::mat4 load(const float m[16])
+    {
+        return glm::make_mat4(m);
+    }
+
+    void store(const glm::mat4 &m, float out[16])
+    {
+        std::memcpy(out, glm::value_ptr(m), sizeof(float) * 16);
+    }
+
+    // count (x, y) pairs into a soa<vec2>
+    glm::soa<glm::vec2> load_soa(const float *xy, std::size_t count)
+    {
+        glm::soa<glm::vec2> out;
+        for (std::size_t i = 0; i < count; i++) out.push_back(glm::vec2(xy[i * 2], xy[i * 2 + 1]));
+        return out;
+    }
+}
+
+void scalar_multiply(const float a[16], const float b[16], float out[16])
+{
+    store(load(a) * load(b), out);
+}
+
+void scalar_inverse(const float m[16], float out[16])
+{
+    store(glm::inverse(load(m)), out);
+}
+
+void scalar_affine_inverse(const float m[16], float out[16])
+{
+    store(glm::affineInverse(load(m)), out);
+}
+
+void scalar_transform(const float m[16], const float v[4], float out[4])
+{
+    glm::vec4 result = load(m) * glm::make_vec4(v);
+    std::memcpy(out, glm::value_ptr(result), sizeof(float) * 4);
+}
+
+// quaternions as x, y, z, w
+void scalar_slerp(const float x[4], const float y[4], float a, float out[4])
+{
+    glm::quat result = glm::slerp(glm::quat(x[3], x[0], x[1], x[2]), glm::quat(y[3], y[0], y[1], y[2]), a);
+    out[0] = result.x;
+    out[1] = result.y;
+    out[2] = result.z;
+    out[3] = result.w;
+}
+
+float scalar_perlin(float x, float y)
+{
+    return glm::perlin(glm::vec2(x, y));
+}
+
+float scalar_simplex(float x, float y)
+{
+    return glm::simplex(glm::vec2(x, y));
+}
+
+float scalar_simplex(float x, float y, float z)
+{
+    return glm::simplex(glm::vec3(x, y, z));
+}
+
+unsigned short scalar_pack_half(float v)
+{
+    return glm::packHalf1x16(v);
+}
+
+float scalar_unpack_half(unsigned short p)
+{
+    return glm::unpackHalf1x16(p);
+}
+
+unsigned short scalar_pack_unorm16(float v)
+{
+    return glm::packUnorm1x16(v);
+}
+
+unsigned short scalar_pack_snorm16(float v)
+{
+    return glm::packSnorm1x16(v);
+}
+
+unsigned char scalar_pack_unorm8(float v)
+{
+    return glm::packUnorm1x8(v);
+}
+
+// The 2D sweeps, one ray against count shapes or count rays against one shape. Points, directions
+// and extents are count (x, y) pairs.
+std::size_t scalar_ray_aabbs(const float origin[2], const float direction[2], float max_time, const float *box_min, const float *box_max,
+                             std::size_t count, unsigned int *hit_mask, float *times)
+{
+    return glm::intersectRayAABB(glm::make_vec2(origin), glm::make_vec2(direction), max_time, load_soa(box_min, count), load_soa(box_max, count),
+                                 hit_mask, times);
+}
+
+std::size_t scalar_rays_aabb(const float *origins, const float *directions, std::size_t count, float max_time, const float box_min[2],
+                             const float box_max[2], unsigned int *hit_mask, float *times)
+{
+    return glm::intersectRayAABB(load_soa(origins, count), load_soa(directions, count), max_time, glm::make_vec2(box_min), glm::make_vec2(box_max),
+                                 hit_mask, times);
+}
+
+std::size_t scalar_ray_circles(const float origin[2], const float direction[2], float max_time, const float *centers, const float *radii,
+                               std::size_t count, unsigned int *hit_mask, float *times)
+{
+    return glm::intersectRayCircle(glm::make_vec2(origin), glm::make_vec2(direction), max_time, load_soa(centers, count), radii, hit_mask, times);
+}
+
+std::size_t scalar_rays_circle(const float *origins, const float *directions, std::size_t count, float max_time, const float center[2],
+                               float radius, unsigned int *hit_mask, float *times)
+{
+    return glm::intersectRayCircle(load_soa(origins, count), load_soa(directions, count), max_time, glm::make_vec2(center), radius, hit_mask, times);
+}
+
+std::size_t scalar_ray_obbs(const float origin[2], const float direction[2], float max_time, const float *centers, const float *axes,
+                            const float *half_extents, std::size_t count, unsigned int *hit_mask, float *times)
+{
+    return glm::intersectRayOBB(glm::make_vec2(origin), glm::make_vec2(direction), max_time, load_soa(centers, count), load_soa(axes, count),
+                                load_soa(half_extents, count), hit_mask, times);
+}
+
+std::size_t scalar_rays_obb(const float *origins, const float *directions, std::size_t count, float max_time, const float center[2],
+                            const float axis[2], const float half_extents[2], unsigned int *hit_mask, float *times)
+{
+    return glm::intersectRayOBB(load_soa(origins, count), load_soa(directions, count), max_time, glm::make_vec2(center), glm::make_vec2(axis),
+                                glm::make_vec2(half_extents), hit_mask, times);
+}
@@ -0,0 +1,146 @@
+/**
+* Headless check and timing report for ParticlePool, the particle simulation under both games'
+* effects. No window or GL context is needed: the instance stream is written to plain memory.
+*
+* It first checks emission, integration, expiry and the capacity limit against closed-form results,
+* then keeps a pool of one million particles alive for a number of 60 Hz frames and reports the
+* time per frame of each stage. From the repository root:
+*   c++ -std=c++14 -O2 -DNDEBUG -Ipong/SDLProject -I/Library/Frameworks/SDL2.framework/Headers \
+*       tools/particle_bench.cpp pong/SDLProject/ParticlePool.cpp -o particle_bench
+*   ./particle_bench [particles] [frames]
+* Add -DGLM_FORCE_AVX -mavx -mf16c to time glm's SIMD integration as the games' x86_64 builds use
+* it; their arm64 builds have no intrinsics. Exits with 1 when a check fails.
+**/
+#include "ParticlePool.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+    const float FRAME_TIME = 1.0f / 60.0f;
+    const glm::vec2 GRAVITY(0.0f, -9.8f);
+
+    int g_failures = 0;
+
+    void check(bool passed, const char *what)
+    {
+        std::printf("%-58s %s\n", what, passed ? "ok" : "FAILED");
+        if (!passed) g_failures++;
+    }
+
+    ParticleEmitter still_emitter(float lifetime)
+    {
+        return ParticleEmitter { glm::vec2(1.0f, 2.0f), glm::vec2(0.0f), glm::vec2(3.0f, 4.0f), 0.0f,
+                                 lifetime, 0.0f, 0.5f, glm::vec4(1.0f, 0.5f, 0.25f, 1.0f) };
+    }
+
+    void run_checks()
+    {
+        {
+            ParticlePool pool(1000);
+            check(pool.Emit(still_emitter(10.0f), 600) == 600 && pool.Emit(still_emitter(10.0f), 600) == 400 &&
+                  pool.Count() == 1000, "emitting past the capacity drops the excess");
+        }
+        {
+            // semi-implicit Euler from rest at (1, 2) with velocity (3, 4): after n steps of dt,
+            // v = v0 + n g dt and p = p0 + n v0 dt + n (n + 1) / 2 g dt^2
+            ParticlePool pool(64);
+            pool.Emit(still_emitter(10.0f), 37);
+
+            const int steps = 30;
+            for (int i = 0; i < steps; i++) pool.Update(FRAME_TIME, GRAVITY);
+
+            std::vector<ParticleInstance> instances(pool.Count());
+            pool.WriteInstances(instances.data(), instances.size());
+
+            float expected_x = 1.0f + steps * 3.0f * FRAME_TIME;
+            float expected_y = 2.0f + steps * 4.0f * FRAME_TIME + 0.5f * steps * (steps + 1) * GRAVITY.y * FRAME_TIME * FRAME_TIME;
+            bool all_there = instances.size() == 37;
+            for (size_t i = 0; i < instances.size(); i++)
+            {
+                all_there = all_there && std::fabs(instances[i].position[0] - expected_x) < 1e-4f &&
+                                         std::fabs(instances[i].position[1] - expected_y) < 1e-4f;
+            }
+            check(all_there, "positions follow semi-implicit Euler under gravity");
+
+            float remaining = 1.0f - steps * FRAME_TIME / 10.0f;
+            check(std::fabs(instances[0].size - 0.5f * remaining) < 1e-4f &&
+                  std::abs(int(instances[0].tint[3]) - int(255.0f * remaining)) <= 1 &&
+                  instances[0].tint[0] == 255 && instances[0].tint[1] == 128 && instances[0].tint[2] == 64,
+                  "size and alpha fade with age, colour is kept");
+        }
+        {
+            // interleaved short and long lives: the short ones go, and every long one survives compaction
+            ParticlePool pool(4096);
+            for (int i = 0; i < 2048; i++)
+            {
+                pool.Emit(still_emitter(0.1f), 1);
+                pool.Emit(still_emitter(1.0f), 1);
+            }
+
+            for (int i = 0; i < 12; i++) pool.Update(FRAME_TIME, GRAVITY);
+            check(pool.Count() == 2048, "expired particles are removed, the rest kept");
+
+            for (int i = 0; i < 60; i++) pool.Update(FRAME_TIME, GRAVITY);
+            check(pool.Count() == 0, "every particle expires after its lifetime");
+        }
+    }
+
+    double milliseconds(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+    {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    void run_timing(size_t particles, int frames)
+    {
+        ParticlePool pool(particles);
+        std::vector<ParticleInstance> instances(particles);
+
+        // lifetimes spread over 1 to 3 seconds, so deaths and refills reach a steady state
+        ParticleEmitter emitter = { glm::vec2(0.0f), glm::vec2(5.0f, 3.0f), glm::vec2(0.0f, 2.0f), 2.0f,
+                                    2.0f, 1.0f, 0.1f, glm::vec4(1.0f) };
+        pool.Emit(emitter, particles);
+
+        double emit_time = 0.0, update_time = 0.0, write_time = 0.0;
+        size_t emitted = 0;
+
+        for (int frame = 0; frame < frames; frame++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            pool.Update(FRAME_TIME, GRAVITY);
+            auto updated = std::chrono::steady_clock::now();
+            emitted += pool.Emit(emitter, particles - pool.Count());
+            auto refilled = std::chrono::steady_clock::now();
+            size_t written = pool.WriteInstances(instances.data(), instances.size());
+            auto end = std::chrono::steady_clock::now();
+
+            update_time += milliseconds(start, updated);
+            emit_time += milliseconds(updated, refilled);
+            write_time += milliseconds(refilled, end);
+
+            if (written != particles) g_failures++;
+        }
+
+        std::printf("\n%zu particles, %d frames, %.0f particles emitted per frame\n", particles, frames, double(emitted) / frames);
+        std::printf("%-24s %10s %14s\n", "stage", "ms/frame", "ns/particle");
+        std::printf("%-24s %10.3f %14.2f\n", "update (integrate+expire)", update_time / frames, update_time * 1e6 / frames / particles);
+        std::printf("%-24s %10.3f %14.2f\n", "emit (refill)", emit_time / frames, emit_time * 1e6 / double(emitted > 0 ? emitted : 1));
+        std::printf("%-24s %10.3f %14.2f\n", "write instances", write_time / frames, write_time * 1e6 / frames / particles);
+        std::printf("%-24s %10.3f\n", "total", (update_time + emit_time + write_time) / frames);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t particles = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 1000000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 120;
+
+    run_checks();
+    run_timing(particles, frames);
+
+    if (g_failures > 0) std::printf("\n%d check(s) FAILED\n", g_failures);
+    return g_failures > 0 ? 1 : 0;
+}